@@ -36,4 +36,16 @@ AddSubResult sbc_6502(const bool decimal_flag, const bool initial_carry_flag, co
 AddSubResult adc_65c02(const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand);
 AddSubResult sbc_65c02(const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand);
 
+// A result packed in a 16-bit value, as used by the batch implementations and the lookup tables:
+//
+//   bits 0..7   : the accumulator.
+//   bits 8..15  : the status register, with only the N (0x80), V (0x40), Z (0x02), and C (0x01)
+//                 flags set (as appropriate); all other bits are zero.
+
+static inline uint16_t packed_adc_sbc_result(const AddSubResult result)
+{
+    const uint8_t flags = (result.FlagN << 7) | (result.FlagV << 6) | (result.FlagZ << 1) | (result.FlagC << 0);
+    return (flags << 8) | result.Accumulator;
+}
+
 #endif
@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                      6502_adc_sbc_batch.c                                     //
+//                                                                                               //
+//       Batch implementations of the 6502 and 65C02 "ADC" and "SBC" instructions, computing     //
+//                  a full row (256 operands) or plane (256 x 256) of results at once.           //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <stdatomic.h>
+
+#include "6502_adc_sbc.h"
+#include "6502_adc_sbc_batch.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ADC_SBC_BATCH_VECTORIZED
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                     Scalar implementation.                                    //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void adc_sbc_row_scalar(const AddSubOperation operation, const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, uint16_t results[256])
+{
+    static AddSubResult (* const functions[4])(const bool, const bool, const uint8_t, const uint8_t) = {
+        adc_6502, sbc_6502, adc_65c02, sbc_65c02
+    };
+
+    for (unsigned operand = 0; operand <= 255; ++operand)
+    {
+        results[operand] = packed_adc_sbc_result(functions[operation](decimal_flag, initial_carry_flag, initial_accumulator, operand));
+    }
+}
+
+#if defined(ADC_SBC_BATCH_VECTORIZED)
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                     Vector implementation.                                    //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The row kernel in '6502_adc_sbc_batch_kernel.h' is compiled once with 128-bit vectors for SSE2,
+// and once with 256-bit vectors for AVX2. Using 256-bit vectors for SSE2 as well would make the
+// compiler split every operation into two halves, which turns out to be much slower.
+
+#define VECTOR_LANES 8
+#define VECTOR_FUNCTION(name) name ## _sse2
+#define VECTOR_TARGET
+#include "6502_adc_sbc_batch_kernel.h"
+#undef VECTOR_LANES
+#undef VECTOR_FUNCTION
+#undef VECTOR_TARGET
+
+#define VECTOR_LANES 16
+#define VECTOR_FUNCTION(name) name ## _avx2
+#define VECTOR_TARGET __attribute__((target("avx2")))
+#include "6502_adc_sbc_batch_kernel.h"
+#undef VECTOR_LANES
+#undef VECTOR_FUNCTION
+#undef VECTOR_TARGET
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                  Implementation selection.                                    //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef void rowfunc(const AddSubOperation operation, const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, uint16_t results[256]);
+
+typedef struct {
+    AddSubBatchImplementation implementation;
+    rowfunc * row_function;
+} BatchKernel;
+
+static const BatchKernel scalar_kernel = { AddSubBatchScalar, adc_sbc_row_scalar };
+#if defined(ADC_SBC_BATCH_VECTORIZED)
+static const BatchKernel sse2_kernel   = { AddSubBatchSSE2  , adc_sbc_row_sse2   };
+static const BatchKernel avx2_kernel   = { AddSubBatchAVX2  , adc_sbc_row_avx2   };
+#endif
+
+// The kernel in use, or NULL if none was selected yet. The batch functions may be called from
+// several threads at once, so the kernel is published through a single atomic pointer; the
+// implementation and its row function are never seen out of step.
+
+static _Atomic(const BatchKernel *) selected_kernel = NULL;
+
+static const BatchKernel * supported_kernel(const AddSubBatchImplementation implementation)
+{
+    switch (implementation)
+    {
+        case AddSubBatchScalar:
+            return &scalar_kernel;
+#if defined(ADC_SBC_BATCH_VECTORIZED)
+        case AddSubBatchSSE2:
+            return __builtin_cpu_supports("sse2") ? &sse2_kernel : NULL;
+        case AddSubBatchAVX2:
+            return __builtin_cpu_supports("avx2") ? &avx2_kernel : NULL;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+static const BatchKernel * get_kernel(void)
+{
+    const BatchKernel * kernel = atomic_load(&selected_kernel);
+
+    if (kernel == NULL)
+    {
+        // Select the best implementation that the processor supports.
+        const BatchKernel * best = supported_kernel(AddSubBatchAVX2);
+        if (best == NULL)
+            best = supported_kernel(AddSubBatchSSE2);
+        if (best == NULL)
+            best = supported_kernel(AddSubBatchScalar);
+
+        // If another thread selected a kernel in the meantime, 'kernel' is set to that one.
+        if (atomic_compare_exchange_strong(&selected_kernel, &kernel, best))
+            kernel = best;
+    }
+    return kernel;
+}
+
+bool adc_sbc_batch_select(const AddSubBatchImplementation implementation)
+{
+    const BatchKernel * kernel = supported_kernel(implementation);
+
+    if (kernel == NULL)
+        return false;
+
+    atomic_store(&selected_kernel, kernel);
+    return true;
+}
+
+AddSubBatchImplementation adc_sbc_batch_implementation(void)
+{
+    return get_kernel()->implementation;
+}
+
+const char * adc_sbc_batch_implementation_name(const AddSubBatchImplementation implementation)
+{
+    switch (implementation)
+    {
+        case AddSubBatchScalar : return "scalar";
+        case AddSubBatchSSE2   : return "sse2";
+        case AddSubBatchAVX2   : return "avx2";
+    }
+    return "unknown";
+}
+
+void adc_sbc_row(const AddSubOperation operation, const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, uint16_t results[256])
+{
+    get_kernel()->row_function(operation, decimal_flag, initial_carry_flag, initial_accumulator, results);
+}
+
+void adc_sbc_plane(const AddSubOperation operation, const bool decimal_flag, const bool initial_carry_flag, uint16_t results[256 * 256])
+{
+    rowfunc * const row_function = get_kernel()->row_function;
+
+    for (unsigned initial_accumulator = 0; initial_accumulator <= 255; ++initial_accumulator)
+    {
+        row_function(operation, decimal_flag, initial_carry_flag, initial_accumulator, &results[256 * initial_accumulator]);
+    }
+}
@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                      6502_adc_sbc_batch.h                                     //
+//                                                                                               //
+//       Batch implementations of the 6502 and 65C02 "ADC" and "SBC" instructions, computing     //
+//                  a full row (256 operands) or plane (256 x 256) of results at once.           //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The results are identical to those of the functions in '6502_adc_sbc.h'. Each result is packed
+// in a 16-bit value, in the same format as the lookup tables in '6502_adc_sbc_tables.h':
+//
+//   bits 0..7   : the accumulator.
+//   bits 8..15  : the status register, with only the N (0x80), V (0x40), Z (0x02), and C (0x01)
+//                 flags set (as appropriate); all other bits are zero.
+//
+// On x86 processors, the computation is done with SSE2 or AVX2 instructions, using a vectorized
+// form of the nibble arithmetic in '6502_adc_sbc.c'. The best implementation supported by the
+// processor is selected at runtime. A scalar implementation is used on other processors.
+
+#ifndef DEFINED_6502_ADC_SBC_BATCH_H
+#define DEFINED_6502_ADC_SBC_BATCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum {
+    ADC_6502,
+    SBC_6502,
+    ADC_65C02,
+    SBC_65C02
+} AddSubOperation;
+
+typedef enum {
+    AddSubBatchScalar,
+    AddSubBatchSSE2,
+    AddSubBatchAVX2
+} AddSubBatchImplementation;
+
+// Compute the results for operands 0..255, given the decimal flag, carry flag, and accumulator.
+void adc_sbc_row(const AddSubOperation operation, const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, uint16_t results[256]);
+
+// Compute the results for all accumulator values and operands; results[256 * accumulator + operand].
+void adc_sbc_plane(const AddSubOperation operation, const bool decimal_flag, const bool initial_carry_flag, uint16_t results[256 * 256]);
+
+// Select an implementation. Returns false if it's not supported by the processor.
+bool adc_sbc_batch_select(const AddSubBatchImplementation implementation);
+
+// The implementation in use; the name is "scalar", "sse2", or "avx2".
+AddSubBatchImplementation adc_sbc_batch_implementation(void);
+const char * adc_sbc_batch_implementation_name(const AddSubBatchImplementation implementation);
+
+#endif
@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                   6502_adc_sbc_batch_kernel.h                                 //
+//                                                                                               //
+//        Vectorized "ADC" and "SBC" row kernel; included by '6502_adc_sbc_batch.c' once for     //
+//                                  each supported vector width.                                 //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Before including this file, define:
+//
+//   VECTOR_LANES          : the number of 16-bit lanes in a vector.
+//   VECTOR_FUNCTION(name) : the name, with a suffix for the instruction set (e.g. 'name ## _avx2').
+//   VECTOR_TARGET         : the attributes of the row function (e.g. a target attribute), or empty.
+//
+// The nibble arithmetic of '6502_adc_sbc.c' is done on VECTOR_LANES operands at once, in 16-bit
+// lanes, using the vector extensions of GCC. Comparisons produce lanes that are all-ones (true)
+// or zero (false); these are used as masks to replace the conditional statements of the scalar
+// code.
+
+typedef int16_t VECTOR_FUNCTION(Vector) __attribute__((vector_size(2 * VECTOR_LANES)));
+
+#define Vector VECTOR_FUNCTION(Vector)
+
+static inline __attribute__((always_inline)) Vector VECTOR_FUNCTION(select)(const Vector mask, const Vector if_true, const Vector if_false)
+{
+    return (mask & if_true) | (~mask & if_false);
+}
+
+static inline __attribute__((always_inline)) Vector VECTOR_FUNCTION(pack)(const Vector accumulator, const Vector n, const Vector v, const Vector z, const Vector c)
+{
+    // Inputs n and v have the flag in bit 7, z and c are masks.
+    return accumulator | (n << 8) | ((v & 0x80) << 7) | ((z & 0x02) << 8) | ((c & 0x01) << 8);
+}
+
+static inline __attribute__((always_inline)) Vector VECTOR_FUNCTION(adc_binary_mode)(const Vector carry, const Vector accumulator, const Vector operand)
+{
+    const Vector sum = accumulator + operand + carry;
+    const Vector result = sum & 0xff;
+
+    return VECTOR_FUNCTION(pack)(result, result & 0x80, (accumulator ^ result) & (operand ^ result), result == 0, sum > 0xff);
+}
+
+static inline __attribute__((always_inline)) Vector VECTOR_FUNCTION(adc_decimal_mode)(const bool is_65c02, const Vector carry, const Vector accumulator, const Vector operand)
+{
+    Vector low_nibble = (accumulator & 15) + (operand & 15) + carry;
+    const Vector low_carry = low_nibble > 9;
+    low_nibble = VECTOR_FUNCTION(select)(low_carry, (low_nibble - 10) & 15, low_nibble);
+
+    Vector high_nibble = (accumulator >> 4) + (operand >> 4) + (low_carry & 1);
+
+    const Vector premature_n = (high_nibble & 8) << 4;
+    const Vector v = (accumulator ^ premature_n) & (operand ^ premature_n);
+
+    const Vector high_carry = high_nibble > 9;
+    high_nibble = VECTOR_FUNCTION(select)(high_carry, (high_nibble - 10) & 15, high_nibble);
+
+    const Vector result = (high_nibble << 4) | low_nibble;
+
+    if (is_65c02)
+    {
+        return VECTOR_FUNCTION(pack)(result, result & 0x80, v, result == 0, high_carry);
+    }
+    else
+    {
+        // The 6502 Z flag behaves as in binary mode; the N flag is the premature one.
+        return VECTOR_FUNCTION(pack)(result, premature_n, v, ((accumulator + operand + carry) & 0xff) == 0, high_carry);
+    }
+}
+
+static inline __attribute__((always_inline)) Vector VECTOR_FUNCTION(sbc_decimal_mode)(const bool is_65c02, const Vector carry, const Vector accumulator, const Vector operand)
+{
+    const Vector borrow = 1 - carry;
+
+    Vector low_nibble = (accumulator & 15) - (operand & 15) - borrow;
+    const Vector low_borrow = low_nibble < 0;
+    low_nibble = VECTOR_FUNCTION(select)(low_borrow, low_nibble + 10, low_nibble);
+    const Vector low_nibble_still_negative = low_nibble < 0; // Only used by the 65C02.
+    low_nibble &= 15;
+
+    Vector high_nibble = (accumulator >> 4) - (operand >> 4) - (low_borrow & 1);
+
+    const Vector premature_n = (high_nibble & 8) << 4;
+
+    const Vector high_borrow = high_nibble < 0;
+    high_nibble = VECTOR_FUNCTION(select)(high_borrow, high_nibble + 10, high_nibble);
+
+    if (is_65c02)
+    {
+        high_nibble += low_nibble_still_negative; // Subtracts one if still negative.
+    }
+
+    high_nibble &= 15;
+
+    const Vector result = (high_nibble << 4) | low_nibble;
+
+    if (is_65c02)
+    {
+        const Vector inverted_operand = operand ^ 0xff;
+        const Vector v = (accumulator ^ premature_n) & (inverted_operand ^ premature_n);
+        return VECTOR_FUNCTION(pack)(result, result & 0x80, v, result == 0, ~high_borrow);
+    }
+    else
+    {
+        // The 6502 N, V, and Z flags behave as in binary mode.
+        const Vector binary = VECTOR_FUNCTION(adc_binary_mode)(carry, accumulator, operand ^ 0xff);
+        return (binary & (int16_t)0xc200) | result | ((~high_borrow & 0x01) << 8);
+    }
+}
+
+VECTOR_TARGET static void VECTOR_FUNCTION(adc_sbc_row)(const AddSubOperation operation, const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, uint16_t results[256])
+{
+    const Vector carry = (Vector){} + (int16_t)initial_carry_flag;
+    const Vector accumulator = (Vector){} + (int16_t)initial_accumulator;
+    const bool is_sbc = (operation == SBC_6502 || operation == SBC_65C02);
+    const bool is_65c02 = (operation == ADC_65C02 || operation == SBC_65C02);
+
+    Vector operand;
+
+    for (unsigned lane = 0; lane < VECTOR_LANES; ++lane)
+    {
+        operand[lane] = lane;
+    }
+
+    for (unsigned k = 0; k < 256; k += VECTOR_LANES)
+    {
+        Vector result;
+
+        if (!decimal_flag)
+        {
+            // In binary mode, SBC behaves like ADC with the operand's bits inverted.
+            result = VECTOR_FUNCTION(adc_binary_mode)(carry, accumulator, is_sbc ? operand ^ 0xff : operand);
+        }
+        else if (is_sbc)
+        {
+            result = VECTOR_FUNCTION(sbc_decimal_mode)(is_65c02, carry, accumulator, operand);
+        }
+        else
+        {
+            result = VECTOR_FUNCTION(adc_decimal_mode)(is_65c02, carry, accumulator, operand);
+        }
+
+        memcpy(&results[k], &result, sizeof(result));
+
+        operand += VECTOR_LANES;
+    }
+}
+
+#undef Vector
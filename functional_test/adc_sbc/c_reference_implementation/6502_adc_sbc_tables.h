@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                      6502_adc_sbc_tables.h                                    //
+//                                                                                               //
+//       Table-driven implementations of the 6502 and 65C02 "ADC" and "SBC" instructions.        //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The complete input space of ADC and SBC is small: 2 (D) x 2 (C) x 256 (A) x 256 (operand).
+// The tables declared here hold the results of the hardware-verified implementations in
+// '6502_adc_sbc.c' for all inputs. They are generated by the 'make_adc_sbc_tables' program.
+//
+// A lookup returns the accumulator and the N, V, Z, and C flags in a single 16-bit value, without
+// any data-dependent branches:
+//
+//   bits 0..7   : the accumulator.
+//   bits 8..15  : the status register, with only the N (0x80), V (0x40), Z (0x02), and C (0x01)
+//                 flags set (as appropriate); all other bits are zero.
+//
+// Binary mode behaves identically on the 6502 and the 65C02, and SBC behaves like ADC with the
+// operand's bits inverted. Therefore, a single binary-mode table (256 KB) is shared by all
+// lookups; each CPU adds two decimal-mode tables of 256 KB each.
+
+#ifndef DEFINED_6502_ADC_SBC_TABLES_H
+#define DEFINED_6502_ADC_SBC_TABLES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ADC_SBC_TABLE_ACCUMULATOR(r) ((uint8_t)(r))
+#define ADC_SBC_TABLE_FLAGS(r)       ((uint8_t)((r) >> 8))
+
+typedef const uint16_t AddSubTable[2][256][256]; // Indexed by [initial_carry_flag][initial_accumulator][operand].
+
+extern AddSubTable adc_binary_table;
+extern AddSubTable adc_6502_decimal_table;
+extern AddSubTable sbc_6502_decimal_table;
+extern AddSubTable adc_65c02_decimal_table;
+extern AddSubTable sbc_65c02_decimal_table;
+
+// The table to use, indexed by the decimal flag. For SBC in binary mode, the operand is inverted.
+
+#define ADC_SBC_TABLE_LOOKUP(binary_table, decimal_table, operand_inversion, decimal_flag, initial_carry_flag, initial_accumulator, operand) \
+    ((decimal_flag) ? (decimal_table) : (binary_table))[initial_carry_flag][initial_accumulator][(operand) ^ ((decimal_flag) ? 0 : (operand_inversion))]
+
+static inline uint16_t adc_6502_lookup(const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand)
+{
+    return ADC_SBC_TABLE_LOOKUP(adc_binary_table, adc_6502_decimal_table, 0x00, decimal_flag, initial_carry_flag, initial_accumulator, operand);
+}
+
+static inline uint16_t sbc_6502_lookup(const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand)
+{
+    return ADC_SBC_TABLE_LOOKUP(adc_binary_table, sbc_6502_decimal_table, 0xff, decimal_flag, initial_carry_flag, initial_accumulator, operand);
+}
+
+static inline uint16_t adc_65c02_lookup(const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand)
+{
+    return ADC_SBC_TABLE_LOOKUP(adc_binary_table, adc_65c02_decimal_table, 0x00, decimal_flag, initial_carry_flag, initial_accumulator, operand);
+}
+
+static inline uint16_t sbc_65c02_lookup(const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand)
+{
+    return ADC_SBC_TABLE_LOOKUP(adc_binary_table, sbc_65c02_decimal_table, 0xff, decimal_flag, initial_carry_flag, initial_accumulator, operand);
+}
+
+#endif
@@ -0,0 +1,473 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                        adc_sbc_check.c                                        //
+//                                                                                               //
+//        Exhaustive validation of an emulator's "ADC" and "SBC" implementation against the      //
+//                    hardware-verified reference files of the 6502 and 65C02.                   //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "adc_sbc_check.h"
+#include "adc_sbc_packed.h"
+#include "md5.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                       Reference files.                                        //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The reference file is memory-mapped, and test case results are decoded from the file data when they are needed.
+// This keeps the memory footprint small.
+//
+// The file contains 2 x 2 x 256 x 256 entries (for the decimal flag, initial carry flag, initial accumulator, and
+// operand), in that order. Each entry contains the ADC result followed by the SBC result. In a '.dat' file, a result
+// is stored as two bytes: the content of the Accumulator register (A), followed by the content of the Status register
+// (P) after the ADC/SBC operation. Files in the packed format (see adc_sbc_packed.h) are also accepted. The hash
+// of their data is computed while the data is used by the verification (see below), so the file is only read once;
+// it is checked against the header when the verification is done.
+
+#define REFERENCE_FILE_SIZE (2 * 2 * 256 * 256 * 4)
+
+#define PACKED_REFERENCE_FILE_SIZE (ADC_SBC_PACKED_HEADER_SIZE + ADC_SBC_PACKED_DATA_SIZE)
+
+// The bits of a result that are compared: the accumulator, and the N, V, Z, and C flags.
+#define RESULT_MASK 0xc3ff
+
+// The verification is split into work units (see below); for a packed file, the data of each work unit is
+// hashed when the work unit is done. The hash is computed in file order: a work unit that is done before
+// the ones that precede it leaves its data to be hashed by the work unit that completes the sequence.
+
+#define ACCUMULATOR_RANGES 16
+
+#define WORK_UNITS_PER_CHECK (2 * 2 * ACCUMULATOR_RANGES)
+
+typedef struct {
+    const uint8_t *    Data;
+    size_t             Size;
+    bool               Packed;
+    AddSubPackedHeader Header;
+    pthread_mutex_t    HashMutex;
+    Md5Context         Md5;
+    unsigned           NextHashedWorkUnit;
+    bool               WorkUnitDone[WORK_UNITS_PER_CHECK];
+} ReferenceFile;
+
+static void hash_packed_reference_data(ReferenceFile * reference_file, unsigned work_unit_index)
+{
+    // The work units of a check cover the data in file order, in equal parts.
+    const size_t work_unit_data_size = ADC_SBC_PACKED_DATA_SIZE / WORK_UNITS_PER_CHECK;
+
+    pthread_mutex_lock(&reference_file->HashMutex);
+
+    reference_file->WorkUnitDone[work_unit_index] = true;
+
+    while (reference_file->NextHashedWorkUnit < WORK_UNITS_PER_CHECK && reference_file->WorkUnitDone[reference_file->NextHashedWorkUnit])
+    {
+        md5_update(&reference_file->Md5, reference_file->Data + ADC_SBC_PACKED_HEADER_SIZE + reference_file->NextHashedWorkUnit * work_unit_data_size, work_unit_data_size);
+        ++reference_file->NextHashedWorkUnit;
+    }
+
+    pthread_mutex_unlock(&reference_file->HashMutex);
+}
+
+static bool check_packed_reference_hash(const char * filename, ReferenceFile * reference_file)
+{
+    uint8_t digest[MD5_DIGEST_SIZE];
+
+    md5_final(&reference_file->Md5, digest);
+
+    if (memcmp(digest, reference_file->Header.Md5, MD5_DIGEST_SIZE) != 0)
+    {
+        fprintf(stderr, "%s: the data doesn't match the MD5 hash in the header.\n", filename);
+        return false;
+    }
+
+    return true;
+}
+
+static bool open_reference_file(const char * filename, ReferenceFile * reference_file)
+{
+    struct stat st;
+    void * data;
+    int fd;
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        perror(filename);
+        return false;
+    }
+
+    if (fstat(fd, &st) != 0 || (st.st_size != REFERENCE_FILE_SIZE && st.st_size != PACKED_REFERENCE_FILE_SIZE))
+    {
+        fprintf(stderr, "%s: not an ADC/SBC reference file.\n", filename);
+        close(fd);
+        return false;
+    }
+
+    data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        perror(filename);
+        return false;
+    }
+
+    reference_file->Data   = data;
+    reference_file->Size   = st.st_size;
+    reference_file->Packed = (st.st_size == PACKED_REFERENCE_FILE_SIZE);
+
+    if (reference_file->Packed)
+    {
+        if (!adc_sbc_packed_decode_header(reference_file->Data, &reference_file->Header))
+        {
+            fprintf(stderr, "%s: unsupported packed ADC/SBC reference file.\n", filename);
+            munmap(data, st.st_size);
+            return false;
+        }
+
+        pthread_mutex_init(&reference_file->HashMutex, NULL);
+        md5_init(&reference_file->Md5);
+        reference_file->NextHashedWorkUnit = 0;
+        memset(reference_file->WorkUnitDone, 0, sizeof(reference_file->WorkUnitDone));
+    }
+
+    return true;
+}
+
+static void close_reference_file(ReferenceFile * reference_file)
+{
+    if (reference_file->Packed)
+    {
+        pthread_mutex_destroy(&reference_file->HashMutex);
+    }
+
+    munmap((void *)reference_file->Data, reference_file->Size);
+}
+
+static uint16_t reference_result(const ReferenceFile * reference_file, unsigned decimal_flag, unsigned initial_carry_flag, unsigned initial_accumulator, unsigned operand, bool sbc)
+{
+    const size_t index = ((decimal_flag * 2 + initial_carry_flag) * 256 + initial_accumulator) * 256 + operand;
+
+    if (reference_file->Packed)
+        return adc_sbc_packed_decode_entry(&reference_file->Data[ADC_SBC_PACKED_HEADER_SIZE + 3 * index], sbc);
+
+    return reference_file->Data[4 * index + 2 * sbc] | (reference_file->Data[4 * index + 2 * sbc + 1] << 8);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                         Counting.                                             //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool is_bcd(unsigned value)
+{
+    return (value & 0x0f) <= 9 && (value >> 4) <= 9;
+}
+
+static AddSubCheckClass input_class(unsigned decimal_flag, unsigned initial_accumulator, unsigned operand)
+{
+    if (!decimal_flag)
+        return AddSubCheckBinary;
+
+    return (is_bcd(initial_accumulator) && is_bcd(operand)) ? AddSubCheckDecimalValid : AddSubCheckDecimalInvalid;
+}
+
+static void count_result(const uint16_t emulator, const uint16_t reference, AddSubCheckCounts * counts)
+{
+    const uint16_t difference = (emulator ^ reference) & RESULT_MASK;
+
+    counts->Tests += 1;
+    counts->Errors += (difference != 0);
+    counts->AccumulatorErrors += (difference & 0x00ff) != 0;
+    counts->FlagNErrors += (difference & 0x8000) != 0;
+    counts->FlagVErrors += (difference & 0x4000) != 0;
+    counts->FlagZErrors += (difference & 0x0200) != 0;
+    counts->FlagCErrors += (difference & 0x0100) != 0;
+}
+
+static void add_counts(AddSubCheckCounts * total, const AddSubCheckCounts * counts)
+{
+    total->Tests += counts->Tests;
+    total->Errors += counts->Errors;
+    total->AccumulatorErrors += counts->AccumulatorErrors;
+    total->FlagNErrors += counts->FlagNErrors;
+    total->FlagVErrors += counts->FlagVErrors;
+    total->FlagZErrors += counts->FlagZErrors;
+    total->FlagCErrors += counts->FlagCErrors;
+}
+
+static void add_report(AddSubCheckReport * total, const AddSubCheckReport * report)
+{
+    for (unsigned k = 0; k < ADD_SUB_CHECK_CLASSES; ++k)
+    {
+        add_counts(&total->Adc[k], &report->Adc[k]);
+        add_counts(&total->Sbc[k], &report->Sbc[k]);
+    }
+    add_counts(&total->Total, &report->Total);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                        Verification.                                          //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The verification is split into work units. Each work unit covers one check, one combination of the decimal and
+// initial carry flags, and a range of initial accumulator values. The work units are distributed over a number of
+// threads; the reports of all work units are merged at the end.
+
+typedef struct {
+    AddSubCheck * Check;
+    ReferenceFile * Reference;
+    unsigned Index;              // The index of the work unit within its check, in file order.
+    unsigned DecimalFlag;
+    unsigned InitialCarryFlag;
+    unsigned FirstAccumulator;
+    unsigned LastAccumulator;
+    AddSubCheckReport Report;
+} WorkUnit;
+
+typedef struct {
+    WorkUnit * WorkUnits;
+    unsigned NumWorkUnits;
+    atomic_uint NextWorkUnit;
+} WorkQueue;
+
+static void check_result(WorkUnit * work_unit, bool sbc, unsigned initial_accumulator, unsigned operand, uint16_t emulator)
+{
+    const uint16_t reference = reference_result(work_unit->Reference, work_unit->DecimalFlag, work_unit->InitialCarryFlag, initial_accumulator, operand, sbc);
+    const AddSubCheckClass category = input_class(work_unit->DecimalFlag, initial_accumulator, operand);
+
+    count_result(emulator, reference, sbc ? &work_unit->Report.Sbc[category] : &work_unit->Report.Adc[category]);
+    count_result(emulator, reference, &work_unit->Report.Total);
+}
+
+static void run_work_unit(WorkUnit * work_unit)
+{
+    const AddSubCheck * check = work_unit->Check;
+    const bool decimal_flag = work_unit->DecimalFlag;
+    const bool initial_carry_flag = work_unit->InitialCarryFlag;
+
+    for (unsigned initial_accumulator = work_unit->FirstAccumulator; initial_accumulator <= work_unit->LastAccumulator; ++initial_accumulator)
+    {
+        for (unsigned sbc = 0; sbc <= 1; ++sbc)
+        {
+            if (check->RowFunction != NULL)
+            {
+                uint16_t results[256];
+
+                check->RowFunction(check->Context, sbc, decimal_flag, initial_carry_flag, initial_accumulator, results);
+
+                for (unsigned operand = 0; operand <= 255; ++operand)
+                {
+                    check_result(work_unit, sbc, initial_accumulator, operand, results[operand]);
+                }
+            }
+            else
+            {
+                for (unsigned operand = 0; operand <= 255; ++operand)
+                {
+                    check_result(work_unit, sbc, initial_accumulator, operand, check->Function(check->Context, sbc, decimal_flag, initial_carry_flag, initial_accumulator, operand));
+                }
+            }
+        }
+    }
+}
+
+static void * worker_thread(void * arg)
+{
+    WorkQueue * queue = arg;
+
+    for (;;)
+    {
+        const unsigned index = atomic_fetch_add(&queue->NextWorkUnit, 1);
+        if (index >= queue->NumWorkUnits)
+        {
+            break;
+        }
+        run_work_unit(&queue->WorkUnits[index]);
+
+        if (queue->WorkUnits[index].Reference->Packed)
+        {
+            hash_packed_reference_data(queue->WorkUnits[index].Reference, queue->WorkUnits[index].Index);
+        }
+    }
+
+    return NULL;
+}
+
+bool adc_sbc_check_run(AddSubCheck * checks, const unsigned num_checks, const unsigned num_threads)
+{
+    ReferenceFile * reference_files;
+    pthread_t * threads;
+    unsigned num_threads_started;
+    unsigned num_files_opened;
+    WorkQueue queue;
+    bool ok = true;
+
+    reference_files = calloc(num_checks, sizeof(ReferenceFile));
+    queue.WorkUnits = calloc((size_t)num_checks * WORK_UNITS_PER_CHECK, sizeof(WorkUnit));
+    queue.NumWorkUnits = 0;
+    atomic_init(&queue.NextWorkUnit, 0);
+
+    if (reference_files == NULL || queue.WorkUnits == NULL)
+    {
+        free(reference_files);
+        free(queue.WorkUnits);
+        fprintf(stderr, "adc_sbc_check_run: out of memory.\n");
+        return false;
+    }
+
+    for (num_files_opened = 0; num_files_opened < num_checks; ++num_files_opened)
+    {
+        AddSubCheck * check = &checks[num_files_opened];
+
+        if ((check->Function == NULL) == (check->RowFunction == NULL))
+        {
+            fprintf(stderr, "%s: specify either a function or a row function.\n", check->ReferenceFilename);
+            ok = false;
+            break;
+        }
+
+        if (!open_reference_file(check->ReferenceFilename, &reference_files[num_files_opened]))
+        {
+            ok = false;
+            break;
+        }
+
+        for (unsigned decimal_flag = 0; decimal_flag <= 1; ++decimal_flag)
+        {
+            for (unsigned initial_carry_flag = 0; initial_carry_flag <= 1; ++initial_carry_flag)
+            {
+                for (unsigned range = 0; range < ACCUMULATOR_RANGES; ++range)
+                {
+                    WorkUnit * work_unit = &queue.WorkUnits[queue.NumWorkUnits++];
+
+                    work_unit->Check = check;
+                    work_unit->Reference = &reference_files[num_files_opened];
+                    work_unit->Index = (decimal_flag * 2 + initial_carry_flag) * ACCUMULATOR_RANGES + range;
+                    work_unit->DecimalFlag = decimal_flag;
+                    work_unit->InitialCarryFlag = initial_carry_flag;
+                    work_unit->FirstAccumulator = range * (256 / ACCUMULATOR_RANGES);
+                    work_unit->LastAccumulator = (range + 1) * (256 / ACCUMULATOR_RANGES) - 1;
+                }
+            }
+        }
+    }
+
+    if (ok)
+    {
+        unsigned max_threads = num_threads;
+
+        if (max_threads == 0)
+        {
+            const long num_processors = sysconf(_SC_NPROCESSORS_ONLN);
+            max_threads = (num_processors > 0) ? num_processors : 1;
+        }
+
+        if (max_threads > queue.NumWorkUnits)
+            max_threads = queue.NumWorkUnits;
+
+        // The calling thread is one of the worker threads.
+
+        threads = calloc(max_threads, sizeof(pthread_t));
+
+        for (num_threads_started = 1; threads != NULL && num_threads_started < max_threads; ++num_threads_started)
+        {
+            if (pthread_create(&threads[num_threads_started], NULL, worker_thread, &queue) != 0)
+                break;
+        }
+
+        worker_thread(&queue);
+
+        for (unsigned k = 1; threads != NULL && k < num_threads_started; ++k)
+        {
+            pthread_join(threads[k], NULL);
+        }
+
+        free(threads);
+
+        for (unsigned k = 0; k < num_checks; ++k)
+        {
+            checks[k].Report = (AddSubCheckReport){0};
+        }
+
+        for (unsigned k = 0; k < queue.NumWorkUnits; ++k)
+        {
+            add_report(&queue.WorkUnits[k].Check->Report, &queue.WorkUnits[k].Report);
+        }
+
+        for (unsigned k = 0; k < num_checks; ++k)
+        {
+            if (reference_files[k].Packed && !check_packed_reference_hash(checks[k].ReferenceFilename, &reference_files[k]))
+            {
+                ok = false;
+            }
+        }
+    }
+
+    for (unsigned k = 0; k < num_files_opened; ++k)
+    {
+        close_reference_file(&reference_files[k]);
+    }
+
+    free(reference_files);
+    free(queue.WorkUnits);
+
+    return ok;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                         Reporting.                                            //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void print_counts(FILE * f, const char * name, const AddSubCheckCounts * counts)
+{
+    fprintf(f, "  %-22s %8u %8u %8u %8u %8u %8u %8u\n", name, counts->Tests, counts->Errors,
+            counts->AccumulatorErrors, counts->FlagNErrors, counts->FlagVErrors, counts->FlagZErrors, counts->FlagCErrors);
+}
+
+void adc_sbc_check_print_report(FILE * f, const char * title, const AddSubCheckReport * report)
+{
+    static const char * class_names[ADD_SUB_CHECK_CLASSES] = {"binary", "decimal valid", "decimal invalid"};
+
+    fprintf(f, "\n%s:\n\n", title);
+    fprintf(f, "tests ....... : %u\n", report->Total.Tests);
+    fprintf(f, "errors ...... : %u\n", report->Total.Errors);
+
+    if (report->Total.Errors != 0)
+    {
+        char name[40];
+
+        fprintf(f, "\n  %-22s %8s %8s %8s %8s %8s %8s %8s\n", "mismatches", "tests", "errors", "A", "N", "V", "Z", "C");
+
+        for (unsigned k = 0; k < ADD_SUB_CHECK_CLASSES; ++k)
+        {
+            snprintf(name, sizeof(name), "ADC, %s", class_names[k]);
+            print_counts(f, name, &report->Adc[k]);
+        }
+
+        for (unsigned k = 0; k < ADD_SUB_CHECK_CLASSES; ++k)
+        {
+            snprintf(name, sizeof(name), "SBC, %s", class_names[k]);
+            print_counts(f, name, &report->Sbc[k]);
+        }
+
+        print_counts(f, "total", &report->Total);
+    }
+}
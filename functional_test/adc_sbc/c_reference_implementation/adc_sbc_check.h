@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                        adc_sbc_check.h                                        //
+//                                                                                               //
+//        Exhaustive validation of an emulator's "ADC" and "SBC" implementation against the      //
+//                    hardware-verified reference files of the 6502 and 65C02.                   //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// This is the interface of the 'libadc_sbc_check.so' library. An emulator registers its ADC/SBC
+// implementation as a callback; the library calls it for all 2 x 2 x 256 x 256 combinations of
+// decimal flag, initial carry flag, initial accumulator, and operand, and compares the results
+// to a reference file: 'adc_sbc_6502.dat' or 'adc_sbc_65c02.dat', or the corresponding '.packed'
+// file (see adc_sbc_packed.h).
+//
+// Results are passed as a 16-bit value: the accumulator in bits 0..7, and the status register
+// in bits 8..15. Only the N (0x80), V (0x40), Z (0x02), and C (0x01) flags of the status register
+// are compared; the other bits are ignored.
+//
+// The callbacks are called from multiple threads at the same time, unless a single thread is
+// requested.
+
+#ifndef DEFINED_ADC_SBC_CHECK_H
+#define DEFINED_ADC_SBC_CHECK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Execute a single ADC (sbc == false) or SBC (sbc == true) instruction.
+typedef uint16_t AddSubCheckFunction(void * context, const bool sbc, const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand);
+
+// Execute ADC or SBC for operands 0..255, given the decimal flag, carry flag, and accumulator.
+typedef void AddSubCheckRowFunction(void * context, const bool sbc, const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, uint16_t results[256]);
+
+// Mismatches are counted separately for three classes of inputs:
+//
+//   binary         : the decimal flag is zero.
+//   decimal valid  : the decimal flag is one; the accumulator and operand are valid BCD numbers.
+//   decimal invalid: the decimal flag is one; the accumulator or operand is not a valid BCD number.
+
+typedef enum {
+    AddSubCheckBinary,
+    AddSubCheckDecimalValid,
+    AddSubCheckDecimalInvalid
+} AddSubCheckClass;
+
+#define ADD_SUB_CHECK_CLASSES 3
+
+typedef struct {
+    unsigned Tests;
+    unsigned Errors;             // Tests where any of the values below differ.
+    unsigned AccumulatorErrors;
+    unsigned FlagNErrors;
+    unsigned FlagVErrors;
+    unsigned FlagZErrors;
+    unsigned FlagCErrors;
+} AddSubCheckCounts;
+
+typedef struct {
+    AddSubCheckCounts Adc[ADD_SUB_CHECK_CLASSES];
+    AddSubCheckCounts Sbc[ADD_SUB_CHECK_CLASSES];
+    AddSubCheckCounts Total;
+} AddSubCheckReport;
+
+// One emulator implementation to check against one reference file.
+// Exactly one of Function and RowFunction should be given.
+
+typedef struct {
+    const char *             ReferenceFilename;
+    AddSubCheckFunction *    Function;
+    AddSubCheckRowFunction * RowFunction;
+    void *                   Context;      // Passed to the callback.
+    AddSubCheckReport        Report;       // Filled in by adc_sbc_check_run().
+} AddSubCheck;
+
+// Run a number of checks at the same time, using 'num_threads' threads (0: one per processor).
+// Returns false (after printing a message) if a reference file can't be used; the data of a packed
+// file is checked against its hash while the checks run. Otherwise, returns true; the outcome of
+// each check is in its Report.
+bool adc_sbc_check_run(AddSubCheck * checks, const unsigned num_checks, const unsigned num_threads);
+
+// Print a report. Mismatch counts are only shown if there are errors.
+void adc_sbc_check_print_report(FILE * f, const char * title, const AddSubCheckReport * report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
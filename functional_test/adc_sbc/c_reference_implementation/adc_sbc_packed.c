@@ -0,0 +1,39 @@
+//////////////////////
+// adc_sbc_packed.c //
+//////////////////////
+
+#include <string.h>
+
+#include "adc_sbc_packed.h"
+
+void adc_sbc_packed_encode_header(const AddSubPackedHeader * header, uint8_t data[ADC_SBC_PACKED_HEADER_SIZE])
+{
+    memcpy(&data[0], ADC_SBC_PACKED_MAGIC, 8);
+
+    data[ 8] = ADC_SBC_PACKED_VERSION & 0xff;
+    data[ 9] = ADC_SBC_PACKED_VERSION >> 8;
+    data[10] = header->Processor;
+    data[11] = header->Ordering;
+    data[12] = header->DataSize;
+    data[13] = header->DataSize >> 8;
+    data[14] = header->DataSize >> 16;
+    data[15] = header->DataSize >> 24;
+
+    memcpy(&data[16], header->Md5, MD5_DIGEST_SIZE);
+}
+
+bool adc_sbc_packed_decode_header(const uint8_t data[ADC_SBC_PACKED_HEADER_SIZE], AddSubPackedHeader * header)
+{
+    if (memcmp(&data[0], ADC_SBC_PACKED_MAGIC, 8) != 0 || (data[8] | (data[9] << 8)) != ADC_SBC_PACKED_VERSION)
+        return false;
+
+    header->Processor = data[10];
+    header->Ordering  = data[11];
+    header->DataSize  = data[12] | (data[13] << 8) | (data[14] << 16) | ((uint32_t)data[15] << 24);
+
+    memcpy(header->Md5, &data[16], MD5_DIGEST_SIZE);
+
+    return (header->Processor == AddSubPacked6502 || header->Processor == AddSubPacked65C02) &&
+           header->Ordering == ADC_SBC_PACKED_ORDERING_DCAO &&
+           header->DataSize == ADC_SBC_PACKED_DATA_SIZE;
+}
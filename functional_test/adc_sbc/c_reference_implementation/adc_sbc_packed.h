@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                        adc_sbc_packed.h                                       //
+//                                                                                               //
+//         Bit-packed, checksummed format of the 6502 and 65C02 ADC/SBC reference data.          //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The '.dat' reference files store each result as two bytes: the accumulator and the status register. Of the status
+// register, only the N, V, Z, and C flags carry information; bits 5 and 4 are always one, bit 2 (I) is always zero,
+// and bit 3 (D) is equal to the decimal flag of the test case.
+//
+// The packed format stores each result in 12 bits: the accumulator in bits 0..7, followed by C, Z, V, and N in
+// bits 8..11. The ADC and SBC results of a test case are stored together in 3 bytes:
+//
+//   byte 0 : bits 0..7 of the ADC result
+//   byte 1 : bits 8..11 of the ADC result (low nibble); bits 0..3 of the SBC result (high nibble)
+//   byte 2 : bits 4..11 of the SBC result
+//
+// A packed file consists of a 32-byte header followed by the data. All values are little-endian.
+//
+//   offset  0 : magic "ADCSBC12" (8 bytes)
+//   offset  8 : version (uint16)
+//   offset 10 : processor (uint8): 0 = 6502, 1 = 65C02
+//   offset 11 : ordering of the test cases (uint8); 0 = decimal flag, initial carry flag, accumulator, operand
+//               (the same as the '.dat' files)
+//   offset 12 : size of the data in bytes (uint32)
+//   offset 16 : MD5 hash of the data (16 bytes)
+//
+// A packed file is 768 KB plus the header, instead of the 1 MB of a '.dat' file.
+
+#ifndef DEFINED_ADC_SBC_PACKED_H
+#define DEFINED_ADC_SBC_PACKED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "md5.h"
+
+#define ADC_SBC_PACKED_MAGIC       "ADCSBC12"
+#define ADC_SBC_PACKED_VERSION     1
+#define ADC_SBC_PACKED_HEADER_SIZE 32
+#define ADC_SBC_PACKED_DATA_SIZE   (2 * 2 * 256 * 256 * 3)
+
+#define ADC_SBC_PACKED_ORDERING_DCAO 0
+
+typedef enum {
+    AddSubPacked6502  = 0,
+    AddSubPacked65C02 = 1
+} AddSubPackedProcessor;
+
+typedef struct {
+    AddSubPackedProcessor Processor;
+    unsigned              Ordering;
+    uint32_t              DataSize;
+    uint8_t               Md5[MD5_DIGEST_SIZE];
+} AddSubPackedHeader;
+
+void adc_sbc_packed_encode_header(const AddSubPackedHeader * header, uint8_t data[ADC_SBC_PACKED_HEADER_SIZE]);
+
+// Returns false if the data is not a header of a packed file that this code can read.
+bool adc_sbc_packed_decode_header(const uint8_t data[ADC_SBC_PACKED_HEADER_SIZE], AddSubPackedHeader * header);
+
+// The ADC and SBC results are passed in the format of '6502_adc_sbc_batch.h': the accumulator in bits 0..7, and
+// the N, V, Z, and C flags in bits 8..15, at their positions in the status register.
+
+static inline void adc_sbc_packed_encode_entry(const uint16_t adc_result, const uint16_t sbc_result, uint8_t entry[3])
+{
+    const unsigned adc = (adc_result & 0xff) | ((adc_result & 0xc000) >> 4) | (adc_result & 0x0300);
+    const unsigned sbc = (sbc_result & 0xff) | ((sbc_result & 0xc000) >> 4) | (sbc_result & 0x0300);
+
+    entry[0] = adc & 0xff;
+    entry[1] = (adc >> 8) | ((sbc & 0x0f) << 4);
+    entry[2] = sbc >> 4;
+}
+
+static inline uint16_t adc_sbc_packed_decode_entry(const uint8_t entry[3], const bool sbc)
+{
+    const unsigned value = sbc ? (entry[1] >> 4) | (entry[2] << 4) : entry[0] | ((entry[1] & 0x0f) << 8);
+
+    return (value & 0x3ff) | ((value & 0xc00) << 4);
+}
+
+#endif
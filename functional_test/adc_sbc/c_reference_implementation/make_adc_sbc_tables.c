@@ -0,0 +1,65 @@
+///////////////////////////
+// make_adc_sbc_tables.c //
+///////////////////////////
+
+// This program generates the C source file '6502_adc_sbc_tables.c' that defines the lookup tables
+// declared in '6502_adc_sbc_tables.h', using the reference implementations in '6502_adc_sbc.c'.
+
+#include <stdio.h>
+#include <assert.h>
+
+#include "6502_adc_sbc.h"
+
+typedef AddSubResult testfunc(const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand);
+
+static void write_table(FILE * fo, const char * name, testfunc func, bool decimal_flag)
+{
+    fprintf(fo, "\nAddSubTable %s = {\n", name);
+
+    for (unsigned initial_carry_flag = 0; initial_carry_flag <= 1; ++initial_carry_flag)
+    {
+        fprintf(fo, "  {\n");
+        for (unsigned initial_accumulator = 0; initial_accumulator <= 255; ++initial_accumulator)
+        {
+            fprintf(fo, "    {");
+            for (unsigned operand = 0; operand <= 255; ++operand)
+            {
+                if (operand % 16 == 0)
+                {
+                    fprintf(fo, "\n      ");
+                }
+                fprintf(fo, "0x%04x,", packed_adc_sbc_result(func(decimal_flag, initial_carry_flag, initial_accumulator, operand)));
+            }
+            fprintf(fo, "\n    },\n");
+        }
+        fprintf(fo, "  },\n");
+    }
+
+    fprintf(fo, "};\n");
+}
+
+int main(void)
+{
+    const char * filename = "6502_adc_sbc_tables.c";
+
+    FILE * fo = fopen(filename, "w");
+    assert(fo != NULL);
+
+    printf("Writing ADC/SBC lookup tables: %s ...\n", filename);
+
+    fprintf(fo, "// Generated by make_adc_sbc_tables.c -- do not edit.\n");
+    fprintf(fo, "\n");
+    fprintf(fo, "#include \"6502_adc_sbc_tables.h\"\n");
+
+    // Binary mode is identical for the 6502 and 65C02; SBC uses this table with an inverted operand.
+    write_table(fo, "adc_binary_table", adc_6502, false);
+
+    write_table(fo, "adc_6502_decimal_table" , adc_6502 , true);
+    write_table(fo, "sbc_6502_decimal_table" , sbc_6502 , true);
+    write_table(fo, "adc_65c02_decimal_table", adc_65c02, true);
+    write_table(fo, "sbc_65c02_decimal_table", sbc_65c02, true);
+
+    fclose(fo);
+
+    return 0;
+}
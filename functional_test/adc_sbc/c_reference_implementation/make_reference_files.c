@@ -14,56 +14,171 @@
 //
 // These MD5 hashes are also stored in the MD5SUM file in this directory. This makes it possible to check
 // if the generated files are accurate by executing 'md5sum -c MD5SUM' on the command line, after running
-// this program.
+// this program. The program also checks the hashes itself, while the files are written.
+//
+// Next to each '.dat' file, a '.packed' file with the same data is written (see adc_sbc_packed.h). As the packed
+// file carries the hash of its own data, a bad one would look fine to its readers; so it is written under a
+// temporary name, and only renamed to its final name if the '.dat' file matches its known-good hash.
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
-#include "6502_adc_sbc.h"
+#include "6502_adc_sbc_batch.h"
+#include "adc_sbc_packed.h"
+#include "md5.h"
+
+// The results are computed a plane (all accumulator and operand values) at a time by the batch
+// implementation, which produces results identical to the functions in '6502_adc_sbc.c'.
+
+static uint16_t adc_plane[256 * 256];
+static uint16_t sbc_plane[256 * 256];
+static uint8_t  file_data[256 * 256 * 4];
+static uint8_t  packed_data[256 * 256 * 3];
 
-static void write_result(FILE * fo, AddSubResult * result, unsigned decimal_flag)
+static void put_result(uint8_t * data, uint16_t result, unsigned decimal_flag)
 {
     // For the status register, assume that the processor's I (Interrupt Disable) flag (bit 4) is zero.
-    const uint8_t status_register = (result->FlagN << 7) | (result->FlagV << 6) | (1 << 5) | (1 << 4) | (decimal_flag << 3) | (0 << 2) | (result->FlagZ << 1) | (result->FlagC << 0);
-    fputc(result->Accumulator, fo);
-    fputc(status_register, fo);
+    const uint8_t status_register = (result >> 8) | (1 << 5) | (1 << 4) | (decimal_flag << 3) | (0 << 2);
+    data[0] = result & 0xff;
+    data[1] = status_register;
 }
 
-typedef AddSubResult testfunc(const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand);
+// Find the MD5 hash of a file in the MD5SUM file. Returns false if it's not there.
+static bool expected_md5(const char * filename, char hex[2 * MD5_DIGEST_SIZE + 1])
+{
+    char line[256];
+    char name[200];
+    bool found = false;
+
+    FILE * fi = fopen("MD5SUM", "r");
+    if (fi == NULL)
+    {
+        perror("MD5SUM");
+        return false;
+    }
+
+    while (!found && fgets(line, sizeof(line), fi) != NULL)
+    {
+        found = sscanf(line, "%32s %199s", hex, name) == 2 && strcmp(name, filename) == 0;
+    }
+
+    fclose(fi);
+    return found;
+}
 
-static void make_reference_file(const char * filename, testfunc adc, testfunc sbc)
+static bool make_reference_file(const char * filename, const char * packed_filename, AddSubPackedProcessor processor, AddSubOperation adc, AddSubOperation sbc)
 {
+    AddSubPackedHeader header = {.Processor = processor, .Ordering = ADC_SBC_PACKED_ORDERING_DCAO, .DataSize = ADC_SBC_PACKED_DATA_SIZE};
+    uint8_t header_data[ADC_SBC_PACKED_HEADER_SIZE];
+    uint8_t digest[MD5_DIGEST_SIZE];
+    char actual_hex[2 * MD5_DIGEST_SIZE + 1];
+    char expected_hex[2 * MD5_DIGEST_SIZE + 1];
+    char temporary_packed_filename[200];
+    Md5Context md5;
+    Md5Context packed_md5;
+
     FILE * fo = fopen(filename, "wb");
     assert(fo != NULL);
 
+    snprintf(temporary_packed_filename, sizeof(temporary_packed_filename), "%s.tmp", packed_filename);
+
+    FILE * fo_packed = fopen(temporary_packed_filename, "wb");
+    assert(fo_packed != NULL);
+
     printf("Writing hardware behavior reference file: %s ...\n", filename);
 
+    md5_init(&md5);
+    md5_init(&packed_md5);
+
+    // The header of the packed file is written again at the end, when the hash of the data is known.
+
+    adc_sbc_packed_encode_header(&header, header_data);
+    size_t fwrite_result = fwrite(header_data, 1, sizeof(header_data), fo_packed);
+    assert(fwrite_result == sizeof(header_data));
+
     for (unsigned decimal_flag = 0; decimal_flag <= 1; ++decimal_flag)
     {
         for (unsigned initial_carry_flag = 0; initial_carry_flag <= 1; ++initial_carry_flag)
         {
-            for (unsigned initial_accumulator = 0; initial_accumulator <= 255; ++initial_accumulator)
+            adc_sbc_plane(adc, decimal_flag, initial_carry_flag, adc_plane);
+            adc_sbc_plane(sbc, decimal_flag, initial_carry_flag, sbc_plane);
+
+            for (unsigned k = 0; k < 256 * 256; ++k)
             {
-                for (unsigned operand = 0; operand <= 255; ++operand)
-                {
-                    AddSubResult adc_result = adc(decimal_flag, initial_carry_flag, initial_accumulator, operand);
-                    AddSubResult sbc_result = sbc(decimal_flag, initial_carry_flag, initial_accumulator, operand);
-
-                    write_result(fo, &adc_result, decimal_flag);
-                    write_result(fo, &sbc_result, decimal_flag);
-                }
+                put_result(&file_data[4 * k + 0], adc_plane[k], decimal_flag);
+                put_result(&file_data[4 * k + 2], sbc_plane[k], decimal_flag);
+                adc_sbc_packed_encode_entry(adc_plane[k], sbc_plane[k], &packed_data[3 * k]);
             }
+
+            md5_update(&md5, file_data, sizeof(file_data));
+            md5_update(&packed_md5, packed_data, sizeof(packed_data));
+
+            fwrite_result = fwrite(file_data, 1, sizeof(file_data), fo);
+            assert(fwrite_result == sizeof(file_data));
+
+            fwrite_result = fwrite(packed_data, 1, sizeof(packed_data), fo_packed);
+            assert(fwrite_result == sizeof(packed_data));
         }
-   }
-   fclose(fo);
+    }
+
+    md5_final(&packed_md5, header.Md5);
+    adc_sbc_packed_encode_header(&header, header_data);
+
+    int fseek_result = fseek(fo_packed, 0, SEEK_SET);
+    assert(fseek_result == 0);
+    fwrite_result = fwrite(header_data, 1, sizeof(header_data), fo_packed);
+    assert(fwrite_result == sizeof(header_data));
+
+    fclose(fo_packed);
+    fclose(fo);
+
+    // Check the hash of the reference file against the known-good MD5SUM file.
+
+    md5_final(&md5, digest);
+    md5_to_hex(digest, actual_hex);
+
+    bool ok;
+
+    if (!expected_md5(filename, expected_hex))
+    {
+        printf("%s: MD5 hash not found in MD5SUM\n", filename);
+        ok = false;
+    }
+    else
+    {
+        ok = strcmp(actual_hex, expected_hex) == 0;
+        printf("%s: %s\n", filename, ok ? "OK" : "FAILED");
+    }
+
+    // Only keep the packed file if the reference file is good.
+
+    if (ok)
+    {
+        int rename_result = rename(temporary_packed_filename, packed_filename);
+        assert(rename_result == 0);
+    }
+    else
+    {
+        remove(temporary_packed_filename);
+        printf("%s: not written\n", packed_filename);
+    }
+
+    return ok;
 }
 
 int main(void)
 {
-    make_reference_file("adc_sbc_6502.dat", adc_6502, sbc_6502);
-    make_reference_file("adc_sbc_65c02.dat", adc_65c02, sbc_65c02);
+    bool ok = true;
 
-    printf("*** IMPORTANT *** make sure to check the generated files against the known-good MD5SUM file !!!\n");
+    ok = make_reference_file("adc_sbc_6502.dat", "adc_sbc_6502.packed", AddSubPacked6502, ADC_6502, SBC_6502) && ok;
+    ok = make_reference_file("adc_sbc_65c02.dat", "adc_sbc_65c02.packed", AddSubPacked65C02, ADC_65C02, SBC_65C02) && ok;
+
+    if (!ok)
+    {
+        printf("*** IMPORTANT *** the generated files do not match the known-good MD5SUM file !!!\n");
+    }
 
-    return 0;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
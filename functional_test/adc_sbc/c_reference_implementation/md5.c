@@ -0,0 +1,138 @@
+///////////
+// md5.c //
+///////////
+
+#include <stdio.h>
+#include <string.h>
+
+#include "md5.h"
+
+static const uint32_t sines[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+
+static const uint8_t shifts[64] = {
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+    5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+};
+
+static uint32_t rotate_left(uint32_t x, unsigned n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+static void process_block(uint32_t state[4], const uint8_t block[64])
+{
+    uint32_t m[16];
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+
+    for (unsigned k = 0; k < 16; ++k)
+    {
+        m[k] = block[4 * k] | (block[4 * k + 1] << 8) | (block[4 * k + 2] << 16) | ((uint32_t)block[4 * k + 3] << 24);
+    }
+
+    for (unsigned k = 0; k < 64; ++k)
+    {
+        uint32_t f;
+        unsigned g;
+
+        switch (k / 16)
+        {
+            case 0  : f = (b & c) | (~b & d); g = k;                break;
+            case 1  : f = (d & b) | (~d & c); g = (5 * k + 1) % 16; break;
+            case 2  : f = b ^ c ^ d;          g = (3 * k + 5) % 16; break;
+            default : f = c ^ (b | ~d);       g = (7 * k) % 16;     break;
+        }
+
+        f += a + sines[k] + m[g];
+        a = d;
+        d = c;
+        c = b;
+        b += rotate_left(f, shifts[k]);
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+}
+
+void md5_init(Md5Context * context)
+{
+    context->State[0] = 0x67452301;
+    context->State[1] = 0xefcdab89;
+    context->State[2] = 0x98badcfe;
+    context->State[3] = 0x10325476;
+    context->Length = 0;
+}
+
+void md5_update(Md5Context * context, const void * data, size_t size)
+{
+    const uint8_t * bytes = data;
+    unsigned used = context->Length % 64;
+
+    context->Length += size;
+
+    if (used != 0)
+    {
+        const size_t n = (size < 64 - used) ? size : 64 - used;
+
+        memcpy(&context->Buffer[used], bytes, n);
+        bytes += n;
+        size -= n;
+
+        if (used + n < 64)
+            return;
+
+        process_block(context->State, context->Buffer);
+    }
+
+    while (size >= 64)
+    {
+        process_block(context->State, bytes);
+        bytes += 64;
+        size -= 64;
+    }
+
+    memcpy(context->Buffer, bytes, size);
+}
+
+void md5_final(Md5Context * context, uint8_t digest[MD5_DIGEST_SIZE])
+{
+    const uint64_t bit_length = 8 * context->Length;
+    uint8_t padding[72] = {0x80};
+    const unsigned used = context->Length % 64;
+    const unsigned padding_size = (used < 56) ? 56 - used : 120 - used;
+
+    for (unsigned k = 0; k < 8; ++k)
+    {
+        padding[padding_size + k] = bit_length >> (8 * k);
+    }
+
+    md5_update(context, padding, padding_size + 8);
+
+    for (unsigned k = 0; k < 16; ++k)
+    {
+        digest[k] = context->State[k / 4] >> (8 * (k % 4));
+    }
+}
+
+void md5_to_hex(const uint8_t digest[MD5_DIGEST_SIZE], char hex[2 * MD5_DIGEST_SIZE + 1])
+{
+    for (unsigned k = 0; k < MD5_DIGEST_SIZE; ++k)
+    {
+        sprintf(&hex[2 * k], "%02x", digest[k]);
+    }
+}
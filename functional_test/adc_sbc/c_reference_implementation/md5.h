@@ -0,0 +1,28 @@
+///////////
+// md5.h //
+///////////
+
+// MD5 message digest (RFC 1321), used to check the reference files without running an external 'md5sum'.
+
+#ifndef DEFINED_MD5_H
+#define DEFINED_MD5_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MD5_DIGEST_SIZE 16
+
+typedef struct {
+    uint32_t State[4];
+    uint64_t Length;       // Number of bytes processed.
+    uint8_t  Buffer[64];   // Partial block.
+} Md5Context;
+
+void md5_init(Md5Context * context);
+void md5_update(Md5Context * context, const void * data, size_t size);
+void md5_final(Md5Context * context, uint8_t digest[MD5_DIGEST_SIZE]);
+
+// Format a digest as 32 lowercase hexadecimal digits, as printed by 'md5sum'.
+void md5_to_hex(const uint8_t digest[MD5_DIGEST_SIZE], char hex[2 * MD5_DIGEST_SIZE + 1]);
+
+#endif
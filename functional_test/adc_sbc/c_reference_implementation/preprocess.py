@@ -4,27 +4,6 @@
 
 import numpy as np
 
-testcase_list = []
-
-for (processor, filename) in ((1, 'adc_sbc_6502.dat'), (2, 'adc_sbc_65c02.dat')):
-    with open(filename, "rb") as fi:
-        for D_FLAG in (0, 1):
-            for INITIAL_C in (0, 1):
-                for INITIAL_A in range(256):
-                    for OPERAND in range(256):
-                        for OPERATION in (+1, -1):
-                            FINAL_A = fi.read(1)[0]
-                            FINAL_P = fi.read(1)[0]
-                            FINAL_N = (FINAL_P >> 7) & 1
-                            FINAL_V = (FINAL_P >> 6) & 1
-                            FINAL_Z = (FINAL_P >> 1) & 1
-                            FINAL_C = (FINAL_P >> 0) & 1
-
-                            testcase = (processor, OPERATION, D_FLAG, INITIAL_C, INITIAL_A, OPERAND, FINAL_A, FINAL_N, FINAL_V, FINAL_Z, FINAL_C)
-                            testcase_list.append(testcase)
-
-                            #print(f"processor {processor:1d} operation {OPERATION:+2d} decimal_flag {D_FLAG:1d} initial_carry_flag {INITIAL_C:1d} initial_accumulator 0x{INITIAL_A:02x} operand 0x{OPERAND:02x} final_accumulator 0x{FINAL_A:02x} final_negative_flag {FINAL_N:1d} final_overflow_flag {FINAL_V:1d} final_zero_flag {FINAL_Z:1d} final_carry_flag {FINAL_C:1d}")
-
 testcase_dtype = np.dtype(
     [
         ('processor'           , np.uint8),  # 1 for 6502, 2 for 65C02
@@ -40,6 +19,40 @@ testcase_dtype = np.dtype(
         ('final_carry_flag'    , np.uint8)
     ])
 
-testcases = np.array(testcase_list, dtype=testcase_dtype)
+# The reference files contain the (final accumulator, final status register) byte pairs of all testcases,
+# in the order given by the axes below. Each file is mapped as an array with these axes, and the testcase
+# fields are derived from it with vectorized operations.
+
+axes = (
+    ('decimal_flag'        , np.arange(2)),
+    ('initial_carry_flag'  , np.arange(2)),
+    ('initial_accumulator' , np.arange(256)),
+    ('operand'             , np.arange(256)),
+    ('operation'           , np.array([+1, -1]))
+)
+
+shape = tuple(len(values) for (name, values) in axes)
+
+testcases = np.empty((2, *shape), dtype=testcase_dtype)
+
+for (index, (processor, filename)) in enumerate(((1, 'adc_sbc_6502.dat'), (2, 'adc_sbc_65c02.dat'))):
+
+    data = np.memmap(filename, dtype=np.uint8, mode='r', shape=(*shape, 2))
+
+    FINAL_A = data[..., 0]
+    FINAL_P = data[..., 1]
+
+    testcases_file = testcases[index]
+
+    testcases_file['processor'] = processor
+
+    for (axis, (name, values)) in enumerate(axes):
+        testcases_file[name] = values.reshape([-1 if k == axis else 1 for k in range(len(axes))])
+
+    testcases_file['final_accumulator'  ] = FINAL_A
+    testcases_file['final_negative_flag'] = (FINAL_P >> 7) & 1
+    testcases_file['final_overflow_flag'] = (FINAL_P >> 6) & 1
+    testcases_file['final_zero_flag'    ] = (FINAL_P >> 1) & 1
+    testcases_file['final_carry_flag'   ] = (FINAL_P >> 0) & 1
 
-np.save('testcases.npy', testcases)
+np.save('testcases.npy', testcases.reshape(-1))
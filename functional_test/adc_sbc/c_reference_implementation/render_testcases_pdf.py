@@ -1,71 +1,151 @@
 #! /usr/bin/env python3
 
+"""Render the testcases produced by 'preprocess.py' to 'testcases.pdf', one page per operation and initial carry flag.
+
+Requires numpy and matplotlib. If the 'pypdf' package is also installed, the pages are rendered in parallel
+worker processes and merged with pypdf; without it, the pages are rendered one by one, which is slower.
+"""
+
+import os
+import sys
 import itertools
+import tempfile
+import multiprocessing
 
 import numpy as np
+import matplotlib
+matplotlib.use("Agg")
 import matplotlib.pyplot as plt
 from matplotlib.backends.backend_pdf import PdfPages
 
-def render_testcases_to_multipage_pdf(testcases, pdf):
+try:
+    import pypdf
+except ImportError:
+    pypdf = None
 
-    operations = (
-        ("ADC/binary" , +1, 0),
-        ("SBC/binary" , -1, 0),
-        ("ADC/decimal", +1, 1),
-        ("SBC/decimal", -1, 1),
-    )
+operations = (
+    ("ADC/binary" , +1, 0),
+    ("SBC/binary" , -1, 0),
+    ("ADC/decimal", +1, 1),
+    ("SBC/decimal", -1, 1),
+)
 
-    initial_carry_flag_values = (0, 1)
+initial_carry_flag_values = (0, 1)
 
-    for initial_carry_flag, (operation_name, operation, decimal_flag)  in itertools.product(initial_carry_flag_values, operations):
+# One page for each combination of initial carry flag and operation.
+pages = tuple(itertools.product(initial_carry_flag_values, operations))
 
-        plt.figure(figsize = (16, 8))
+panels = (
+    ("final_accumulator"  , "accumulator (A) register"),
+    ("final_negative_flag", "negative (N) flag"),
+    ("final_overflow_flag", "overflow (V) flag"),
+    ("final_zero_flag"    , "zero (Z) flag"),
+    ("final_carry_flag"   , "carry (C) flag")
+)
 
-        plt.suptitle("{}, initial C={}\nhorizontal axis: initial accumulator, vertical axis: operand".format(operation_name, initial_carry_flag))
+def make_testcase_cube(testcases):
+    """Return a view of the testcases with axes (processor, operation, decimal_flag, initial_carry_flag, initial_accumulator, operand).
 
-        for processor in (1, 2):
+    The testcases produced by 'preprocess.py' are ordered by processor, decimal flag, initial carry flag,
+    initial accumulator, operand, and operation (ADC, then SBC). Each panel of the PDF is a slice of this view.
+    """
 
-            selection = (testcases["processor"] == processor) & (testcases["operation"] == operation) & (testcases["decimal_flag"] == decimal_flag)  & (testcases["initial_carry_flag"] == initial_carry_flag)
-            tc = testcases[selection]
+    return testcases.reshape(2, 2, 2, 256, 256, 2).transpose(0, 5, 1, 2, 3, 4)
 
-            plt.subplot(2, 5, 1 + (processor - 1) * 5)
-            plt.imshow(tc["final_accumulator"].reshape(256, 256).transpose(), origin='lower', extent=(-0.5, 255.5, -0.5, 255.5))
-            plt.ylabel({1: "6502", 2: "65C02"}[processor])
-            if processor == 1:
-                plt.title("accumulator (A) register")
+def check_testcase_cube(cube):
+    """Check that the testcases are in the order that 'make_testcase_cube' expects.
 
-            plt.subplot(2, 5, 2 + (processor - 1) * 5)
-            plt.imshow(tc["final_negative_flag"].reshape(256, 256).transpose(), origin='lower', extent=(-0.5, 255.5, -0.5, 255.5))
-            if processor == 1:
-                plt.title("negative (N) flag")
+    This reads all testcases, so it is done once, before any page is rendered.
+    """
 
-            plt.subplot(2, 5, 3 + (processor - 1) * 5)
-            plt.imshow(tc["final_overflow_flag"].reshape(256, 256).transpose(), origin='lower', extent=(-0.5, 255.5, -0.5, 255.5))
-            if processor == 1:
-                plt.title("overflow (V) flag")
+    assert np.all(cube["processor"] == np.array([1, 2]).reshape(2, 1, 1, 1, 1, 1))
+    assert np.all(cube["operation"] == np.array([+1, -1]).reshape(1, 2, 1, 1, 1, 1))
+    assert np.all(cube["decimal_flag"] == np.arange(2).reshape(1, 1, 2, 1, 1, 1))
+    assert np.all(cube["initial_carry_flag"] == np.arange(2).reshape(1, 1, 1, 2, 1, 1))
+    assert np.all(cube["initial_accumulator"] == np.arange(256).reshape(1, 1, 1, 1, 256, 1))
+    assert np.all(cube["operand"] == np.arange(256).reshape(1, 1, 1, 1, 1, 256))
 
-            plt.subplot(2, 5, 4 + (processor - 1) * 5)
-            plt.imshow(tc["final_zero_flag"].reshape(256, 256).transpose(), origin='lower', extent=(-0.5, 255.5, -0.5, 255.5))
-            if processor == 1:
-                plt.title("zero (Z) flag")
+def render_page(cube, page_index):
+    """Render a page as a matplotlib figure."""
+
+    (initial_carry_flag, (operation_name, operation, decimal_flag)) = pages[page_index]
+
+    operation_index = {+1: 0, -1: 1}[operation]
 
-            plt.subplot(2, 5, 5 + (processor - 1) * 5)
-            plt.imshow(tc["final_carry_flag"].reshape(256, 256).transpose(), origin='lower', extent=(-0.5, 255.5, -0.5, 255.5))
+    figure = plt.figure(figsize = (16, 8))
+
+    plt.suptitle("{}, initial C={}\nhorizontal axis: initial accumulator, vertical axis: operand".format(operation_name, initial_carry_flag))
+
+    for processor in (1, 2):
+
+        tc = cube[processor - 1, operation_index, decimal_flag, initial_carry_flag]
+
+        for (panel_index, (field, title)) in enumerate(panels):
+            plt.subplot(2, 5, 1 + panel_index + (processor - 1) * 5)
+            plt.imshow(tc[field].transpose(), origin='lower', extent=(-0.5, 255.5, -0.5, 255.5))
+            if panel_index == 0:
+                plt.ylabel({1: "6502", 2: "65C02"}[processor])
             if processor == 1:
-                plt.title("carry (C) flag")
+                plt.title(title)
 
-        pdf.savefig()
-        plt.close()
+    return figure
 
-def main():
+def render_testcases_to_multipage_pdf(cube, pdf):
+
+    for page_index in range(len(pages)):
+        figure = render_page(cube, page_index)
+        pdf.savefig(figure)
+        plt.close(figure)
+
+# Parallel rendering: each worker process renders pages to single-page PDF files, which are merged at the end.
+# The workers map the testcases file; its content was already checked by the parent process.
 
-    testcases = np.load("testcases.npy")
+worker_cube = None
 
+def worker_initialize(testcases_filename):
+    global worker_cube
+    worker_cube = make_testcase_cube(np.load(testcases_filename, mmap_mode='r'))
+
+def worker_render_page(arguments):
+    (page_index, page_filename) = arguments
+    figure = render_page(worker_cube, page_index)
+    figure.savefig(page_filename, format='pdf')
+    plt.close(figure)
+    return page_filename
+
+def render_testcases_to_pdf_in_parallel(testcases_filename, filename):
+
+    with tempfile.TemporaryDirectory() as temporary_directory:
+
+        page_filenames = [os.path.join(temporary_directory, "page_{:02d}.pdf".format(page_index)) for page_index in range(len(pages))]
+
+        with multiprocessing.Pool(initializer=worker_initialize, initargs=(testcases_filename, )) as pool:
+            pool.map(worker_render_page, enumerate(page_filenames))
+
+        writer = pypdf.PdfWriter()
+        for page_filename in page_filenames:
+            writer.append(page_filename)
+
+        with open(filename, "wb") as fo:
+            writer.write(fo)
+
+def main():
+
+    testcases_filename = "testcases.npy"
     filename = "testcases.pdf"
+
     print(f"Rendering {filename!r} ...")
-    with PdfPages(filename) as pdf:
-        render_testcases_to_multipage_pdf(testcases, pdf)
+
+    cube = make_testcase_cube(np.load(testcases_filename, mmap_mode='r'))
+    check_testcase_cube(cube)
+
+    if pypdf is not None:
+        render_testcases_to_pdf_in_parallel(testcases_filename, filename)
+    else:
+        # Without pypdf, the pages can't be merged; render them one by one.
+        print("Warning: the 'pypdf' package is not installed; rendering the pages sequentially, which is slower.", file=sys.stderr)
+        with PdfPages(filename) as pdf:
+            render_testcases_to_multipage_pdf(cube, pdf)
 
 if __name__ == "__main__":
     main()
-
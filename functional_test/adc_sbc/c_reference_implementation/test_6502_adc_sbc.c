@@ -14,130 +14,113 @@
 // board (with a WDC 65C02 processor). The file MD5SUM in this repository contains a hash of those "gold standard"
 // files.
 
+// The verification itself is done by the 'adc_sbc_check' library (see adc_sbc_check.h), which emulators can use
+// in the same way to validate their own ADC and SBC implementations.
+
 #include <stdio.h>
-#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "6502_adc_sbc.h"
+#include "6502_adc_sbc_batch.h"
+#include "adc_sbc_check.h"
 
 typedef AddSubResult testfunc(const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand);
 
-static void read_op_result(FILE * fi, AddSubResult * result)
-{
-    // The test case result are stored in the file as two bytes.
-    // The first one is the content of the Accumulator register (A) after the ADB/SBC operation.
-    // The second one is the content of the Status register (P) after the ADC/SBC operation.
-
-    struct {
-        uint8_t A;
-        uint8_t P;
-    } test_result;
-
-    size_t fread_result = fread(&test_result, 1, sizeof(test_result), fi);
-    assert(fread_result == sizeof(test_result));
-
-    result->Accumulator = test_result.A;
-    result->FlagN = (test_result.P & 0x80) != 0;
-    result->FlagV = (test_result.P & 0x40) != 0;
-    result->FlagZ = (test_result.P & 0x02) != 0;
-    result->FlagC = (test_result.P & 0x01) != 0;
-}
-
 typedef struct {
-    AddSubResult adc;
-    AddSubResult sbc;
-} ReferenceDataEntry;
+    testfunc * adc;
+    testfunc * sbc;
+    AddSubOperation batch_adc;
+    AddSubOperation batch_sbc;
+} TestFunctions;
 
-typedef ReferenceDataEntry ReferenceDataArray[2][2][256][256];
-
-static void read_reference_data(const char * filename, ReferenceDataArray reference_data)
+static uint16_t check_function(void * context, const bool sbc, const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand)
 {
-    FILE * fi = fopen(filename, "rb");
-    assert(fi != NULL);
-    for (unsigned decimal_flag = 0; decimal_flag <= 1; ++decimal_flag)
-    {
-        for (unsigned initial_carry_flag = 0; initial_carry_flag <= 1; ++initial_carry_flag)
-        {
-            for (unsigned initial_accumulator = 0; initial_accumulator <= 0xff; ++initial_accumulator)
-            {
-                for (unsigned operand = 0; operand <= 0xff; ++operand)
-                {
-                    read_op_result(fi, &reference_data[decimal_flag][initial_carry_flag][initial_accumulator][operand].adc);
-                    read_op_result(fi, &reference_data[decimal_flag][initial_carry_flag][initial_accumulator][operand].sbc);
-                }
-            }
-        }
-    }
-    fclose(fi);
+    const TestFunctions * functions = context;
+    testfunc * f = sbc ? functions->sbc : functions->adc;
+
+    return packed_adc_sbc_result(f(decimal_flag, initial_carry_flag, initial_accumulator, operand));
 }
 
-static bool identical(AddSubResult * r1, AddSubResult * r2)
+static void check_row_function(void * context, const bool sbc, const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, uint16_t results[256])
 {
-    return
-        (r1->Accumulator == r2->Accumulator) &&
-        (r1->FlagN == r2->FlagN) &&
-        (r1->FlagV == r2->FlagV) &&
-        (r1->FlagZ == r2->FlagZ) &&
-        (r1->FlagC == r2->FlagC);
+    const TestFunctions * functions = context;
+
+    adc_sbc_row(sbc ? functions->batch_sbc : functions->batch_adc, decimal_flag, initial_carry_flag, initial_accumulator, results);
 }
 
-static void run_tests_on_file(const char * filename, testfunc adc, testfunc sbc, unsigned * count_tests, unsigned * count_errors)
+int main(int argc, char ** argv)
 {
-    ReferenceDataArray reference_data;
-
-    printf("Running ADC/SBC behavior tests against hardware behavior reference file: %s ...\n", filename);
+    // Usage: test_6502_adc_sbc [-b] [-p] [number_of_threads]
+    //
+    // With option '-b', the batch implementation (see 6502_adc_sbc_batch.h) is checked instead of the functions
+    // in 6502_adc_sbc.c. With option '-p', the packed reference files (see adc_sbc_packed.h) are used instead of
+    // the '.dat' files. By default, one thread per processor is used.
+
+    bool batch = false;
+    bool packed = false;
+    unsigned num_threads = 0;
+    int k = 1;
+
+    for (; k < argc && argv[k][0] == '-'; ++k)
+    {
+        if (strcmp(argv[k], "-b") == 0)
+            batch = true;
+        else if (strcmp(argv[k], "-p") == 0)
+            packed = true;
+        else
+            break;
+    }
 
-    read_reference_data(filename, reference_data);
+    if (k < argc)
+    {
+        num_threads = strtoul(argv[k], NULL, 10);
+        ++k;
+    }
 
-    for (unsigned decimal_flag = 0; decimal_flag <= 1; ++decimal_flag)
+    if (k != argc)
     {
-        for (unsigned initial_carry_flag = 0; initial_carry_flag <= 1; ++initial_carry_flag)
-        {
-            for (unsigned initial_accumulator = 0; initial_accumulator <= 255; ++initial_accumulator)
-            {
-                for (unsigned operand = 0; operand <= 255; ++operand)
-                {
-                    AddSubResult adc_reference = reference_data[decimal_flag][initial_carry_flag][initial_accumulator][operand].adc;
-
-                    if (true) // Test ADC instruction.
-                    {
-                        AddSubResult adc_simulator = adc(decimal_flag, initial_carry_flag, initial_accumulator, operand);
-
-                        *count_tests += 1;
-                        if (!identical(&adc_simulator, &adc_reference))
-                        {
-                            *count_errors += 1;
-                        }
-                    }
-
-                    AddSubResult sbc_reference = reference_data[decimal_flag][initial_carry_flag][initial_accumulator][operand].sbc;
-
-                    if (true) // Test SBC instruction.
-                    {
-                        AddSubResult sbc_simulator = sbc(decimal_flag, initial_carry_flag, initial_accumulator, operand);
-
-                        *count_tests += 1;
-                        if (!identical(&sbc_simulator, &sbc_reference))
-                        {
-                            *count_errors += 1;
-                        }
-                    }
-
-                } // end of operand loop
-            } // end of initial_accumulator loop
-        } // end of initial_carry_flag loop
-    } // end of decimal_flag loop
-}
+        fprintf(stderr, "Usage: %s [-b] [-p] [number_of_threads]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    static TestFunctions functions_6502  = {adc_6502 , sbc_6502 , ADC_6502 , SBC_6502 };
+    static TestFunctions functions_65c02 = {adc_65c02, sbc_65c02, ADC_65C02, SBC_65C02};
+
+    AddSubCheck checks[2] = {
+        {.ReferenceFilename = packed ? "adc_sbc_6502.packed"  : "adc_sbc_6502.dat" , .Context = &functions_6502 },
+        {.ReferenceFilename = packed ? "adc_sbc_65c02.packed" : "adc_sbc_65c02.dat", .Context = &functions_65c02}
+    };
 
-int main(void)
-{
     unsigned count_tests = 0;
     unsigned count_errors = 0;
 
-    run_tests_on_file("adc_sbc_6502.dat", adc_6502, sbc_6502, &count_tests, &count_errors);
-    run_tests_on_file("adc_sbc_65c02.dat", adc_65c02, sbc_65c02, &count_tests, &count_errors);
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        if (batch)
+            checks[i].RowFunction = check_row_function;
+        else
+            checks[i].Function = check_function;
+
+        printf("Running ADC/SBC behavior tests against hardware behavior reference file: %s ...\n", checks[i].ReferenceFilename);
+    }
+
+    if (!adc_sbc_check_run(checks, 2, num_threads))
+    {
+        return EXIT_FAILURE;
+    }
+
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        adc_sbc_check_print_report(stdout, checks[i].ReferenceFilename, &checks[i].Report);
+
+        count_tests += checks[i].Report.Total.Tests;
+        count_errors += checks[i].Report.Total.Errors;
+    }
 
+    printf("\ntotal:\n\n");
     printf("tests ....... : %u\n", count_tests);
     printf("errors ...... : %u\n", count_errors);
 
-    return 0;
+    return (count_errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
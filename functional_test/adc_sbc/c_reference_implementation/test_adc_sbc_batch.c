@@ -0,0 +1,113 @@
+//////////////////////////
+// test_adc_sbc_batch.c //
+//////////////////////////
+
+// This program verifies that every batch ADC/SBC implementation in '6502_adc_sbc_batch.c' that is
+// supported by the processor gives results identical to the reference implementations in
+// '6502_adc_sbc.c', for all inputs. It also reports how long each implementation takes to
+// compute all results.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "6502_adc_sbc.h"
+#include "6502_adc_sbc_batch.h"
+
+typedef AddSubResult testfunc(const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand);
+
+static const struct {
+    const char *    name;
+    AddSubOperation operation;
+    testfunc *      reference;
+} operations[4] = {
+    {"ADC 6502" , ADC_6502 , adc_6502 },
+    {"SBC 6502" , SBC_6502 , sbc_6502 },
+    {"ADC 65C02", ADC_65C02, adc_65c02},
+    {"SBC 65C02", SBC_65C02, sbc_65c02}
+};
+
+static uint16_t plane[256 * 256];
+
+static unsigned check_implementation(void)
+{
+    unsigned count_errors = 0;
+
+    for (unsigned k = 0; k < 4; ++k)
+    {
+        for (unsigned decimal_flag = 0; decimal_flag <= 1; ++decimal_flag)
+        {
+            for (unsigned initial_carry_flag = 0; initial_carry_flag <= 1; ++initial_carry_flag)
+            {
+                adc_sbc_plane(operations[k].operation, decimal_flag, initial_carry_flag, plane);
+
+                for (unsigned initial_accumulator = 0; initial_accumulator <= 255; ++initial_accumulator)
+                {
+                    for (unsigned operand = 0; operand <= 255; ++operand)
+                    {
+                        const unsigned expected = packed_adc_sbc_result(operations[k].reference(decimal_flag, initial_carry_flag, initial_accumulator, operand));
+
+                        if (plane[256 * initial_accumulator + operand] != expected)
+                        {
+                            ++count_errors;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return count_errors;
+}
+
+static double time_implementation(void)
+{
+    struct timespec t1, t2;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    for (unsigned k = 0; k < 4; ++k)
+    {
+        for (unsigned decimal_flag = 0; decimal_flag <= 1; ++decimal_flag)
+        {
+            for (unsigned initial_carry_flag = 0; initial_carry_flag <= 1; ++initial_carry_flag)
+            {
+                adc_sbc_plane(operations[k].operation, decimal_flag, initial_carry_flag, plane);
+            }
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+
+    return 1e3 * (t2.tv_sec - t1.tv_sec) + 1e-6 * (t2.tv_nsec - t1.tv_nsec);
+}
+
+int main(void)
+{
+    const AddSubBatchImplementation implementations[3] = {AddSubBatchScalar, AddSubBatchSSE2, AddSubBatchAVX2};
+    unsigned count_errors = 0;
+
+    printf("Checking batch ADC/SBC implementations against the reference implementation ...\n\n");
+
+    for (unsigned k = 0; k < 3; ++k)
+    {
+        const char * name = adc_sbc_batch_implementation_name(implementations[k]);
+
+        if (!adc_sbc_batch_select(implementations[k]))
+        {
+            printf("%-6s : not supported\n", name);
+            continue;
+        }
+
+        const unsigned errors = check_implementation();
+        const double duration = time_implementation();
+
+        printf("%-6s : %u errors in %u inputs; %.3f ms for all inputs\n", name, errors, 4 * 2 * 2 * 256 * 256, duration);
+
+        count_errors += errors;
+    }
+
+    printf("\n");
+
+    return (count_errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,143 @@
+///////////////////////////
+// test_adc_sbc_tables.c //
+///////////////////////////
+
+// This program verifies that the table-driven ADC/SBC implementations in '6502_adc_sbc_tables.h'
+// give results identical to the reference implementations in '6502_adc_sbc.c', for all inputs.
+//
+// It then compares the speed of both implementations, in nanoseconds per operation, on a
+// pseudo-random sequence of inputs. This is done for random values of the decimal flag, and for
+// decimal mode only.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "6502_adc_sbc.h"
+#include "6502_adc_sbc_tables.h"
+
+typedef AddSubResult testfunc(const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand);
+typedef uint16_t lookupfunc(const bool decimal_flag, const bool initial_carry_flag, const uint8_t initial_accumulator, const uint8_t operand);
+
+#define NUM_BENCHMARK_INPUTS (1 << 20)
+#define NUM_BENCHMARK_ROUNDS 20
+
+static uint32_t benchmark_inputs[NUM_BENCHMARK_INPUTS]; // Bits 0..7: operand; 8..15: accumulator; 16: carry; 17: decimal.
+
+static unsigned check_exhaustively(const char * name, testfunc reference, lookupfunc lookup)
+{
+    unsigned count_errors = 0;
+
+    for (unsigned decimal_flag = 0; decimal_flag <= 1; ++decimal_flag)
+    {
+        for (unsigned initial_carry_flag = 0; initial_carry_flag <= 1; ++initial_carry_flag)
+        {
+            for (unsigned initial_accumulator = 0; initial_accumulator <= 255; ++initial_accumulator)
+            {
+                for (unsigned operand = 0; operand <= 255; ++operand)
+                {
+                    const unsigned expected = packed_adc_sbc_result(reference(decimal_flag, initial_carry_flag, initial_accumulator, operand));
+                    const unsigned actual = lookup(decimal_flag, initial_carry_flag, initial_accumulator, operand);
+
+                    if (actual != expected)
+                    {
+                        ++count_errors;
+                    }
+                }
+            }
+        }
+    }
+
+    printf("%-10s : %u errors in %u inputs\n", name, count_errors, 2 * 2 * 256 * 256);
+
+    return count_errors;
+}
+
+static double elapsed_ns(const struct timespec * t1, const struct timespec * t2)
+{
+    return 1e9 * (t2->tv_sec - t1->tv_sec) + (t2->tv_nsec - t1->tv_nsec);
+}
+
+static void make_benchmark_inputs(bool decimal_only)
+{
+    uint32_t state = 12345;
+
+    for (unsigned k = 0; k < NUM_BENCHMARK_INPUTS; ++k)
+    {
+        state = state * 1664525 + 1013904223;
+        benchmark_inputs[k] = (state >> 8) & (decimal_only ? 0x1ffff : 0x3ffff);
+        if (decimal_only)
+        {
+            benchmark_inputs[k] |= 0x20000;
+        }
+    }
+}
+
+static void benchmark(const char * name, testfunc reference, lookupfunc lookup)
+{
+    struct timespec t1, t2, t3;
+    unsigned checksum_reference = 0;
+    unsigned checksum_lookup = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    for (unsigned round = 0; round < NUM_BENCHMARK_ROUNDS; ++round)
+    {
+        for (unsigned k = 0; k < NUM_BENCHMARK_INPUTS; ++k)
+        {
+            const uint32_t input = benchmark_inputs[k];
+            AddSubResult result = reference((input >> 17) & 1, (input >> 16) & 1, (input >> 8) & 0xff, input & 0xff);
+            checksum_reference += result.Accumulator + result.FlagN + result.FlagV + result.FlagZ + result.FlagC;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+
+    for (unsigned round = 0; round < NUM_BENCHMARK_ROUNDS; ++round)
+    {
+        for (unsigned k = 0; k < NUM_BENCHMARK_INPUTS; ++k)
+        {
+            const uint32_t input = benchmark_inputs[k];
+            uint16_t result = lookup((input >> 17) & 1, (input >> 16) & 1, (input >> 8) & 0xff, input & 0xff);
+            checksum_lookup += ADC_SBC_TABLE_ACCUMULATOR(result) + __builtin_popcount(ADC_SBC_TABLE_FLAGS(result));
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t3);
+
+    printf("%-10s : computed %6.2f ns/op, lookup %6.2f ns/op%s\n", name,
+           elapsed_ns(&t1, &t2) / (NUM_BENCHMARK_ROUNDS * NUM_BENCHMARK_INPUTS),
+           elapsed_ns(&t2, &t3) / (NUM_BENCHMARK_ROUNDS * NUM_BENCHMARK_INPUTS),
+           checksum_reference == checksum_lookup ? "" : " (CHECKSUM MISMATCH)");
+}
+
+static void run_benchmarks(bool decimal_only)
+{
+    make_benchmark_inputs(decimal_only);
+
+    printf("\nBenchmark, %s:\n\n", decimal_only ? "decimal mode only" : "random decimal flag");
+
+    benchmark("ADC 6502" , adc_6502 , adc_6502_lookup );
+    benchmark("SBC 6502" , sbc_6502 , sbc_6502_lookup );
+    benchmark("ADC 65C02", adc_65c02, adc_65c02_lookup);
+    benchmark("SBC 65C02", sbc_65c02, sbc_65c02_lookup);
+}
+
+int main(void)
+{
+    unsigned count_errors = 0;
+
+    printf("Exhaustive check of the ADC/SBC lookup tables:\n\n");
+
+    count_errors += check_exhaustively("ADC 6502" , adc_6502 , adc_6502_lookup );
+    count_errors += check_exhaustively("SBC 6502" , sbc_6502 , sbc_6502_lookup );
+    count_errors += check_exhaustively("ADC 65C02", adc_65c02, adc_65c02_lookup);
+    count_errors += check_exhaustively("SBC 65C02", sbc_65c02, sbc_65c02_lookup);
+
+    run_benchmarks(false);
+    run_benchmarks(true);
+
+    printf("\n");
+
+    return (count_errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
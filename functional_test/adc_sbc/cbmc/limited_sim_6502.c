@@ -6,7 +6,12 @@
 #include "limited_sim_6502.h"
 #include "6502_adc_sbc.h"
 
-CpuState operation(CpuVariant variant, CpuState s, unsigned op)
+#if defined(LIMITED_SIM_6502_TABLES) && defined(__GNUC__) && defined(__x86_64__)
+#define STATE_VECTOR_AVX2
+#include <immintrin.h>
+#endif
+
+CpuState operation_direct(CpuVariant variant, CpuState s, unsigned op)
 {
     if (op < 0x100)
     {
@@ -109,3 +114,173 @@ CpuState operation(CpuVariant variant, CpuState s, unsigned op)
     }
     return s;
 }
+
+#if defined(LIMITED_SIM_6502_TABLES)
+
+TransitionTables transition_tables;
+
+void make_transition_tables(void)
+{
+    for (unsigned variant = 0; variant < NUM_CPU_VARIANTS; ++variant)
+    {
+        for (unsigned op = 0; op < NUM_OPERATIONS; ++op)
+        {
+            for (unsigned code = 0; code < NUM_CPU_STATES; ++code)
+            {
+                transition_tables.Table[variant][op][code] = encode_cpu_state(operation_direct(variant, decode_cpu_state(code), op));
+            }
+        }
+    }
+}
+
+void state_vector_init(StateVector * sv)
+{
+    for (unsigned code = 0; code < NUM_CPU_STATES; ++code)
+    {
+        sv->Codes[code] = code;
+    }
+}
+
+static void state_vector_apply_scalar(CpuVariant variant, StateVector * sv, unsigned op)
+{
+    const CpuStateCode * row = transition_tables.Table[variant][op];
+
+    for (unsigned k = 0; k < NUM_CPU_STATES; ++k)
+    {
+        sv->Codes[k] = row[sv->Codes[k]];
+    }
+}
+
+#if defined(STATE_VECTOR_AVX2)
+
+// AVX2 can only gather 32-bit values. Each 16-bit entry is gathered with the entry that follows it in
+// the table (the padding of the table covers the last one), and the upper half is discarded.
+
+__attribute__((target("avx2")))
+static void state_vector_apply_avx2(CpuVariant variant, StateVector * sv, unsigned op)
+{
+    const int * row = (const int *)transition_tables.Table[variant][op];
+    const __m256i mask = _mm256_set1_epi32(0xffff);
+
+    for (unsigned k = 0; k < NUM_CPU_STATES; k += 16)
+    {
+        const __m256i codes_lo = _mm256_cvtepu16_epi32(_mm_load_si128((const __m128i *)&sv->Codes[k + 0]));
+        const __m256i codes_hi = _mm256_cvtepu16_epi32(_mm_load_si128((const __m128i *)&sv->Codes[k + 8]));
+
+        const __m256i next_lo = _mm256_and_si256(_mm256_i32gather_epi32(row, codes_lo, 2), mask);
+        const __m256i next_hi = _mm256_and_si256(_mm256_i32gather_epi32(row, codes_hi, 2), mask);
+
+        // The pack works on the two 128-bit halves separately; the permute puts the results in order.
+        const __m256i next = _mm256_permute4x64_epi64(_mm256_packus_epi32(next_lo, next_hi), 0xd8);
+
+        _mm256_store_si256((__m256i *)&sv->Codes[k], next);
+    }
+}
+
+#endif
+
+typedef void StateVectorApplyFunction(CpuVariant variant, StateVector * sv, unsigned op);
+
+static StateVectorApplyFunction * selected_apply_function = NULL;
+
+bool state_vector_select_avx2(bool avx2)
+{
+    if (!avx2)
+    {
+        selected_apply_function = state_vector_apply_scalar;
+        return true;
+    }
+#if defined(STATE_VECTOR_AVX2)
+    if (__builtin_cpu_supports("avx2"))
+    {
+        selected_apply_function = state_vector_apply_avx2;
+        return true;
+    }
+#endif
+    return false;
+}
+
+// LDA, ORA, AND, EOR, and the flag operations change each bit of the state independently, in the same way for
+// all variants: the new state is ((state & and_mask) | or_mask) ^ xor_mask. For these, no table is needed.
+static bool bitwise_operation(unsigned op, CpuStateCode * and_mask, CpuStateCode * or_mask, CpuStateCode * xor_mask)
+{
+    const CpuStateCode operand = op & 0xff;
+
+    *and_mask = 0x3ff;
+    *or_mask = 0;
+    *xor_mask = 0;
+
+    switch (op >> 8)
+    {
+        case 0 : *and_mask = 0x300; *or_mask = operand; return true;    // LDA
+        case 4 : *or_mask = operand; return true;                       // ORA
+        case 5 : *and_mask = 0x300 | operand; return true;              // AND
+        case 6 : *xor_mask = operand; return true;                      // EOR
+    }
+
+    switch (op)
+    {
+        case 0x700 : *and_mask = 0x1ff; return true;                    // CLD
+        case 0x701 : *or_mask = 0x200; return true;                     // SED
+        case 0x702 : *and_mask = 0x2ff; return true;                    // CLC
+        case 0x703 : *or_mask = 0x100; return true;                     // SEC
+    }
+
+    return false;
+}
+
+void state_vector_apply(CpuVariant variant, StateVector * sv, unsigned op)
+{
+    CpuStateCode and_mask, or_mask, xor_mask;
+
+    if (bitwise_operation(op, &and_mask, &or_mask, &xor_mask))
+    {
+        for (unsigned k = 0; k < NUM_CPU_STATES; ++k)
+        {
+            sv->Codes[k] = ((sv->Codes[k] & and_mask) | or_mask) ^ xor_mask;
+        }
+        return;
+    }
+
+    if (selected_apply_function == NULL)
+    {
+        if (!state_vector_select_avx2(true))
+            state_vector_select_avx2(false);
+    }
+    selected_apply_function(variant, sv, op);
+}
+
+bool state_vector_all_reach(const StateVector * sv, uint8_t target)
+{
+    // The D flag must be zero; the C flag doesn't matter.
+    unsigned mismatches = 0;
+
+    for (unsigned k = 0; k < NUM_CPU_STATES; ++k)
+    {
+        mismatches |= (sv->Codes[k] & 0x2ff) ^ target;
+    }
+    return mismatches == 0;
+}
+
+bool sequence_always_reaches_target(CpuVariant variant, const unsigned * operations, unsigned num_operations, uint8_t target)
+{
+    StateVector sv;
+
+    state_vector_init(&sv);
+
+    for (unsigned k = 0; k < num_operations; ++k)
+    {
+        state_vector_apply(variant, &sv, operations[k]);
+    }
+
+    return state_vector_all_reach(&sv, target);
+}
+
+#else
+
+CpuState operation(CpuVariant variant, CpuState s, unsigned op)
+{
+    return operation_direct(variant, s, op);
+}
+
+#endif
@@ -59,6 +59,94 @@ typedef struct
     uint8_t Accumulator;
 } CpuState;
 
+#define NUM_CPU_VARIANTS 3
+#define NUM_OPERATIONS   0x708
+#define NUM_CPU_STATES   1024
+
+// The modeled state, encoded in 10 bits: D in bit 9, C in bit 8, and the accumulator in bits 7..0.
+typedef uint16_t CpuStateCode;
+
+static inline CpuStateCode encode_cpu_state(CpuState s)
+{
+    return (s.FlagD << 9) | (s.FlagC << 8) | s.Accumulator;
+}
+
+static inline CpuState decode_cpu_state(CpuStateCode code)
+{
+    CpuState s;
+    s.FlagD = (code >> 9) & 1;
+    s.FlagC = (code >> 8) & 1;
+    s.Accumulator = code & 0xff;
+    return s;
+}
+
+// Simulate an operation by decoding it and calling the ADC/SBC implementations.
+// This is the version that CBMC works with.
+CpuState operation_direct(CpuVariant variant, CpuState s, unsigned op);
+
+// Simulate an operation.
+//
+// When compiled with LIMITED_SIM_6502_TABLES defined, this is a single lookup in a transition table
+// (state x operation -> state) for each variant. The tables are 11 MB in total; they are generated
+// from operation_direct() by make_transition_tables(), which must be called first.
+//
+// Without LIMITED_SIM_6502_TABLES (e.g., when running CBMC), this is the same as operation_direct().
+//
+// Code that simulates many operations can use transition() on encoded states instead, which saves the
+// encoding and decoding of the state.
+
+#if defined(LIMITED_SIM_6502_TABLES)
+
+typedef struct {
+    CpuStateCode Table[NUM_CPU_VARIANTS][NUM_OPERATIONS][NUM_CPU_STATES];
+    CpuStateCode Padding[2];   // The AVX2 gather reads 32 bits for each 16-bit entry.
+} TransitionTables;
+
+extern TransitionTables transition_tables;
+
+void make_transition_tables(void);
+
+static inline CpuStateCode transition(CpuVariant variant, CpuStateCode code, unsigned op)
+{
+    return transition_tables.Table[variant][op][code];
+}
+
+static inline CpuState operation(CpuVariant variant, CpuState s, unsigned op)
+{
+    return decode_cpu_state(transition(variant, encode_cpu_state(s), op));
+}
+
+// A state vector holds, for each of the 1024 initial states (indexed by their code), the state that it
+// has reached. This allows a sequence of operations to be checked for all initial states at once: each
+// operation is applied to the entire vector. LDA, ORA, AND, EOR, and the flag operations are done with
+// bitwise operations on all states; the other operations are a gather from the row of the transition table.
+// With AVX2, 16 states are gathered at a time.
+
+typedef struct {
+    CpuStateCode Codes[NUM_CPU_STATES];
+} __attribute__((aligned(32))) StateVector;
+
+// Set each state to its initial state.
+void state_vector_init(StateVector * sv);
+
+// Apply an operation to all states.
+void state_vector_apply(CpuVariant variant, StateVector * sv, unsigned op);
+
+// Do all states have the given accumulator value, and D=0?
+bool state_vector_all_reach(const StateVector * sv, uint8_t target);
+
+// Do all initial states reach the given accumulator value, with D=0, after the sequence of operations?
+// This is the exhaustive version of always_reaches_target() in 'detect_processor_v1.c'.
+bool sequence_always_reaches_target(CpuVariant variant, const unsigned * operations, unsigned num_operations, uint8_t target);
+
+// Select the AVX2 (true) or scalar (false) implementation of state_vector_apply(). Returns false if AVX2
+// is not supported by the processor. By default, AVX2 is used when it's available.
+bool state_vector_select_avx2(bool avx2);
+
+#else
+
 CpuState operation(CpuVariant variant, CpuState s, unsigned op);
 
 #endif
+
+#endif
@@ -0,0 +1,905 @@
+////////////////////////////
+// search_discriminator.c //
+////////////////////////////
+
+// A native alternative to running 'detect_processor_v1.c' through CBMC.
+//
+// This program searches for the shortest branch-free sequences of operations (see limited_sim_6502.h)
+// that leave a given value in the accumulator, depending on the CPU variant, for all initial states:
+// both values of the D and C flags, and all 256 initial accumulator values. At the end, the D flag
+// must be zero.
+//
+// Usage: search_discriminator [-n max_length] [-s max_solutions] [-t suffix_length] [-m log2_table_size] [target_V0 target_V1 target_V2]
+//        search_discriminator -c sequence [target_V0 target_V1 target_V2]
+//
+// A target is an accumulator value from 0 to 255, or '-' if the variant is not considered. The default
+// targets are 0, 1, and 2.
+//
+// The default maximum length is 4, which takes about 10 seconds. Length 5 needs '-t 3' and takes about
+// 2.5 minutes (over a minute of which goes into making the suffix tables); there are no solutions of
+// length 5 or less for the default targets. Longer searches do not finish in a practical time.
+//
+// With '-c', the program only checks a given sequence, written as in the output of the search, e.g.:
+//
+//   search_discriminator -c 'SED; LDA #$99; ADC #$01; CLD'
+//
+// Each solution that the search finds, and a sequence given with '-c', is checked for all 1024 initial
+// states by running it on state vectors (see limited_sim_6502.h), independently of the search.
+//
+// How it works
+// ------------
+//
+// Rather than simulating a sequence of operations for each initial state separately, the search keeps
+// track of the set of states that each variant can be in after a prefix of the sequence; a set of
+// states is a bitset of 1024 bits. Initially, each set holds all states. Appending an operation to the
+// prefix replaces each set by its image under the operation, using the transition tables.
+//
+// Many prefixes lead to the same sets; e.g., 'LDA #0' and 'LDA #1; AND #0' do. The search is an
+// iterative-deepening depth-first search that records the sets it visited (as a 128-bit hash), with
+// the number of operations that were left at that point. A prefix that leads to sets that were already
+// visited with at least as many operations left is not extended.
+//
+// Prefixes are also pruned when a lower bound on the number of operations still needed exceeds the
+// operations that are left:
+//
+// - Only CLD clears the D flag, and it doesn't change the accumulator. If a set holds a state with D=1,
+//   the last operation must be a CLD, so the accumulator values must already be right before it.
+//
+// - The variants only behave differently for ADC and SBC with D=1. If two variants that need different
+//   accumulator values have the same set of states, they need at least an ADC or SBC (preceded by a SED
+//   if all states have D=0), followed by a CLD.
+//
+// Meet in the middle
+// ------------------
+//
+// The number of distinct prefixes grows quickly with their length (about 1500 of length 1, and 725,000
+// of length 2), but the number of distinct suffixes grows much more slowly. Before the search, suffix
+// tables are made for suffixes of up to 'suffix_length' operations (default 2; '-t'). For a suffix, it
+// is the preimage of the goal that matters: for each variant, the set of states from which the suffix
+// reaches the target value with D=0. These are found backwards from the goal, one operation at a time,
+// and duplicates are dropped using the same hash table as the search.
+//
+// The search then only extends prefixes until 'suffix_length' operations are left, and joins each of
+// those prefixes with the suffix table of that length: a suffix completes the prefix if its preimages
+// hold all states of the prefix. For each distinct preimage, one suffix is shown. The shortest solutions
+// are still found, since a suffix that was dropped as a duplicate has a shorter equivalent.
+//
+// For the default targets, there are 578 distinct suffixes of length 1, 26,587 of length 2, and 1.9 million
+// of length 3. The tables of length 3 ('-t 3', the maximum) take a little over a minute to make, and 1.5 GB
+// of memory.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include "limited_sim_6502.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SET_PREIMAGE_AVX2
+#include <immintrin.h>
+#endif
+
+#define SET_WORDS (NUM_CPU_STATES / 64)
+
+// The length of the sequence in '_get_cpu_signature', which '-c' can check. Searches that long do not finish.
+#define MAX_LENGTH 7
+
+// Suffix tables of length 4 would not fit in memory.
+#define MAX_SUFFIX_LENGTH 3
+
+#define NO_TARGET (-1)
+
+typedef struct {
+    uint64_t Bits[SET_WORDS];
+} StateSet;
+
+typedef struct {
+    StateSet Sets[NUM_CPU_VARIANTS];
+} SearchNode;
+
+// The suffix tables of one length. Each entry is a tuple of preimages: for each variant, the set of
+// states from which a suffix of that length reaches the goal.
+//
+// The index has a bitmap of the entries for each (variant, state): Index[(variant * NUM_CPU_STATES + code) * IndexWords + w]
+// has bit i set if entry 64 * w + i holds the state. The join goes through the states in the order of
+// JoinOrder: states that are held by the fewest entries come first, since they rule out the most entries.
+
+typedef struct {
+    unsigned     NumEntries;
+    unsigned     Capacity;
+    SearchNode * Preimages;        // Only kept until the next length is made.
+    uint32_t *   Next;             // The entry of the suffix table of one length less that the suffix continues with.
+    uint16_t *   FirstOperation;
+    size_t       IndexWords;
+    uint64_t *   Index;
+    unsigned     JoinOrderLength;
+    uint16_t     JoinOrder[NUM_CPU_VARIANTS * NUM_CPU_STATES];    // variant * NUM_CPU_STATES + code
+} SuffixTable;
+
+typedef struct {
+    uint64_t Hash1;
+    uint64_t Hash2;        // The low byte holds the number of operations that were left; the hash is in the other bits.
+} VisitedEntry;
+
+static int targets[NUM_CPU_VARIANTS] = {0, 1, 2};
+static bool active[NUM_CPU_VARIANTS];
+static bool use_avx2;
+static StateSet goal_sets[NUM_CPU_VARIANTS];   // The target accumulator value, with D=0.
+
+static VisitedEntry * visited_table;
+static uint64_t visited_table_mask;
+static uint64_t visited_count;
+
+static SuffixTable suffix_tables[MAX_SUFFIX_LENGTH + 1];
+static unsigned suffix_length = 2;
+static uint64_t * join_candidates;
+static size_t * join_words;
+
+static unsigned sequence[MAX_LENGTH];
+static unsigned max_solutions = 10;
+static unsigned num_solutions;
+static uint64_t nodes_expanded;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                      SETS OF STATES                                           //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void set_add(StateSet * set, CpuStateCode code)
+{
+    set->Bits[code / 64] |= (uint64_t)1 << (code % 64);
+}
+
+static bool set_equal(const StateSet * set1, const StateSet * set2)
+{
+    return memcmp(set1, set2, sizeof(StateSet)) == 0;
+}
+
+// The image of a set of states under an operation.
+static void set_image(CpuVariant variant, const StateSet * set, unsigned op, StateSet * image)
+{
+    memset(image, 0, sizeof(StateSet));
+
+    for (unsigned w = 0; w < SET_WORDS; ++w)
+    {
+        uint64_t bits = set->Bits[w];
+        while (bits != 0)
+        {
+            const CpuStateCode code = 64 * w + __builtin_ctzll(bits);
+            set_add(image, transition(variant, code, op));
+            bits &= bits - 1;
+        }
+    }
+}
+
+// The preimage of a set of states under an operation: the states that the operation maps into the set.
+static void set_preimage_scalar(CpuVariant variant, const StateSet * set, unsigned op, StateSet * preimage)
+{
+    const CpuStateCode * row = transition_tables.Table[variant][op];
+
+    for (unsigned w = 0; w < SET_WORDS; ++w)
+    {
+        uint64_t bits = 0;
+        for (unsigned i = 0; i < 64; ++i)
+        {
+            const CpuStateCode code = row[64 * w + i];
+            bits |= ((set->Bits[code / 64] >> (code % 64)) & 1) << i;
+        }
+        preimage->Bits[w] = bits;
+    }
+}
+
+#if defined(SET_PREIMAGE_AVX2)
+
+// The same, testing the bits of 8 states at a time: a gather fetches the 32-bit words of the set that hold
+// the states that they are mapped to, and the bits are shifted to the sign bits to collect them.
+
+__attribute__((target("avx2")))
+static void set_preimage_avx2(CpuVariant variant, const StateSet * set, unsigned op, StateSet * preimage)
+{
+    const CpuStateCode * row = transition_tables.Table[variant][op];
+    const int * set_words = (const int *)set->Bits;
+    uint32_t * preimage_words = (uint32_t *)preimage->Bits;
+    const __m256i mask = _mm256_set1_epi32(31);
+
+    for (unsigned k = 0; k < NUM_CPU_STATES; k += 32)
+    {
+        uint32_t bits = 0;
+        for (unsigned j = 0; j < 4; ++j)
+        {
+            const __m256i codes = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)&row[k + 8 * j]));
+            const __m256i words = _mm256_i32gather_epi32(set_words, _mm256_srli_epi32(codes, 5), 4);
+            const __m256i shifted = _mm256_sllv_epi32(words, _mm256_sub_epi32(mask, _mm256_and_si256(codes, mask)));
+            bits |= (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(shifted)) << (8 * j);
+        }
+        preimage_words[k / 32] = bits;
+    }
+}
+
+#endif
+
+static void set_preimage(CpuVariant variant, const StateSet * set, unsigned op, StateSet * preimage)
+{
+#if defined(SET_PREIMAGE_AVX2)
+    if (use_avx2)
+    {
+        set_preimage_avx2(variant, set, op, preimage);
+        return;
+    }
+#endif
+    set_preimage_scalar(variant, set, op, preimage);
+}
+
+static bool set_is_empty(const StateSet * set)
+{
+    for (unsigned w = 0; w < SET_WORDS; ++w)
+    {
+        if (set->Bits[w] != 0)
+            return false;
+    }
+    return true;
+}
+
+// Does the set hold a state with D=1? These are the upper 512 states.
+static bool set_has_decimal_states(const StateSet * set)
+{
+    for (unsigned w = SET_WORDS / 2; w < SET_WORDS; ++w)
+    {
+        if (set->Bits[w] != 0)
+            return true;
+    }
+    return false;
+}
+
+// Do all states in the set have the given accumulator value?
+static bool set_has_only_accumulator(const StateSet * set, uint8_t accumulator)
+{
+    StateSet allowed = {0};
+
+    for (unsigned code = accumulator; code < NUM_CPU_STATES; code += 256)
+    {
+        set_add(&allowed, code);
+    }
+
+    for (unsigned w = 0; w < SET_WORDS; ++w)
+    {
+        if ((set->Bits[w] & ~allowed.Bits[w]) != 0)
+            return false;
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                      VISITED NODES                                            //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static void node_hash(const SearchNode * node, uint64_t * hash1, uint64_t * hash2)
+{
+    uint64_t h1 = 0x243f6a8885a308d3ULL;
+    uint64_t h2 = 0x13198a2e03707344ULL;
+
+    for (unsigned v = 0; v < NUM_CPU_VARIANTS; ++v)
+    {
+        if (!active[v])
+            continue;
+
+        for (unsigned w = 0; w < SET_WORDS; ++w)
+        {
+            h1 = mix(h1 ^ node->Sets[v].Bits[w]);
+            h2 = mix(h2 + node->Sets[v].Bits[w] + w);
+        }
+    }
+
+    *hash1 = h1;
+    *hash2 = h2 & ~(uint64_t)0xff;
+}
+
+// Returns true if the node was visited before with at least 'remaining' operations left.
+// Otherwise, records the visit.
+static bool check_visited(const SearchNode * node, unsigned remaining)
+{
+    uint64_t hash1, hash2;
+
+    node_hash(node, &hash1, &hash2);
+
+    for (uint64_t index = hash1 & visited_table_mask; ; index = (index + 1) & visited_table_mask)
+    {
+        VisitedEntry * entry = &visited_table[index];
+
+        if (entry->Hash1 == 0 && entry->Hash2 == 0)
+        {
+            // An empty slot. Keep the table at most 3/4 full; when it's full, nodes are no longer recorded.
+            if (4 * visited_count < 3 * (visited_table_mask + 1))
+            {
+                entry->Hash1 = hash1;
+                entry->Hash2 = hash2 | remaining;
+                ++visited_count;
+            }
+            return false;
+        }
+
+        if (entry->Hash1 == hash1 && (entry->Hash2 & ~(uint64_t)0xff) == hash2)
+        {
+            if ((entry->Hash2 & 0xff) >= remaining)
+                return true;
+
+            entry->Hash2 = hash2 | remaining;
+            return false;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                       SUFFIX TABLES                                           //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool add_suffix(SuffixTable * table, const SearchNode * preimages, uint32_t next, unsigned op)
+{
+    if (table->NumEntries == table->Capacity)
+    {
+        const unsigned capacity = (table->Capacity == 0) ? 1024 : 2 * table->Capacity;
+
+        SearchNode * new_preimages = realloc(table->Preimages, capacity * sizeof(SearchNode));
+        if (new_preimages == NULL)
+            return false;
+        table->Preimages = new_preimages;
+
+        uint32_t * new_next = realloc(table->Next, capacity * sizeof(uint32_t));
+        if (new_next == NULL)
+            return false;
+        table->Next = new_next;
+
+        uint16_t * new_first_operation = realloc(table->FirstOperation, capacity * sizeof(uint16_t));
+        if (new_first_operation == NULL)
+            return false;
+        table->FirstOperation = new_first_operation;
+
+        table->Capacity = capacity;
+    }
+
+    table->Preimages[table->NumEntries] = *preimages;
+    table->Next[table->NumEntries] = next;
+    table->FirstOperation[table->NumEntries] = op;
+    ++table->NumEntries;
+
+    return true;
+}
+
+static unsigned * join_order_counts;
+
+static int compare_join_order(const void * a, const void * b)
+{
+    const unsigned count_a = join_order_counts[*(const uint16_t *)a];
+    const unsigned count_b = join_order_counts[*(const uint16_t *)b];
+
+    return (count_a > count_b) - (count_a < count_b);
+}
+
+static bool make_suffix_index(SuffixTable * table)
+{
+    unsigned counts[NUM_CPU_VARIANTS * NUM_CPU_STATES] = {0};
+
+    table->IndexWords = (table->NumEntries + 63) / 64;
+    table->Index = calloc(NUM_CPU_VARIANTS * NUM_CPU_STATES * table->IndexWords + 1, sizeof(uint64_t));
+    if (table->Index == NULL)
+        return false;
+
+    for (unsigned k = 0; k < table->NumEntries; ++k)
+    {
+        for (unsigned v = 0; v < NUM_CPU_VARIANTS; ++v)
+        {
+            for (unsigned code = 0; code < NUM_CPU_STATES; ++code)
+            {
+                if ((table->Preimages[k].Sets[v].Bits[code / 64] >> (code % 64)) & 1)
+                {
+                    table->Index[(v * NUM_CPU_STATES + code) * table->IndexWords + k / 64] |= (uint64_t)1 << (k % 64);
+                    ++counts[v * NUM_CPU_STATES + code];
+                }
+            }
+        }
+    }
+
+    table->JoinOrderLength = 0;
+    for (unsigned v = 0; v < NUM_CPU_VARIANTS; ++v)
+    {
+        if (!active[v])
+            continue;
+
+        for (unsigned code = 0; code < NUM_CPU_STATES; ++code)
+        {
+            table->JoinOrder[table->JoinOrderLength++] = v * NUM_CPU_STATES + code;
+        }
+    }
+
+    join_order_counts = counts;
+    qsort(table->JoinOrder, table->JoinOrderLength, sizeof(uint16_t), compare_join_order);
+
+    return true;
+}
+
+// Make the suffix tables of length 0 (only the goal) up to 'suffix_length'. Each suffix extends a suffix
+// of one length less by prepending an operation. As with prefixes, suffixes that lead to the same preimages
+// as a suffix that was found before (including shorter ones) are dropped; so are suffixes that can't be
+// reached from any state of a variant.
+static bool make_suffix_tables(void)
+{
+    SearchNode goal;
+
+    memset(&goal, 0, sizeof(goal));
+    for (unsigned v = 0; v < NUM_CPU_VARIANTS; ++v)
+    {
+        if (active[v])
+            goal.Sets[v] = goal_sets[v];
+    }
+
+    memset(visited_table, 0, (visited_table_mask + 1) * sizeof(VisitedEntry));
+    visited_count = 0;
+
+    check_visited(&goal, 0);
+    if (!add_suffix(&suffix_tables[0], &goal, 0, 0))
+        return false;
+
+    for (unsigned length = 1; length <= suffix_length; ++length)
+    {
+        const SuffixTable * shorter = &suffix_tables[length - 1];
+        SuffixTable * table = &suffix_tables[length];
+
+        for (unsigned k = 0; k < shorter->NumEntries; ++k)
+        {
+            for (unsigned op = 0; op < NUM_OPERATIONS; ++op)
+            {
+                SearchNode preimages;
+                bool reachable = true;
+
+                for (unsigned v = 0; v < NUM_CPU_VARIANTS; ++v)
+                {
+                    if (active[v])
+                    {
+                        set_preimage(v, &shorter->Preimages[k].Sets[v], op, &preimages.Sets[v]);
+                        reachable &= !set_is_empty(&preimages.Sets[v]);
+                    }
+                    else
+                        memset(&preimages.Sets[v], 0, sizeof(StateSet));
+                }
+
+                if (reachable && !check_visited(&preimages, 0) && !add_suffix(table, &preimages, k, op))
+                    return false;
+            }
+        }
+
+        printf("suffixes of length %u: %u\n", length, table->NumEntries);
+        fflush(stdout);
+    }
+
+    size_t max_index_words = 1;
+
+    for (unsigned length = 0; length <= suffix_length; ++length)
+    {
+        if (!make_suffix_index(&suffix_tables[length]))
+            return false;
+
+        free(suffix_tables[length].Preimages);
+        suffix_tables[length].Preimages = NULL;
+
+        if (max_index_words < suffix_tables[length].IndexWords)
+            max_index_words = suffix_tables[length].IndexWords;
+    }
+
+    join_candidates = malloc(max_index_words * sizeof(uint64_t));
+    join_words = malloc(max_index_words * sizeof(size_t));
+
+    return join_candidates != NULL && join_words != NULL;
+}
+
+static void free_suffix_tables(void)
+{
+    for (unsigned length = 0; length <= suffix_length; ++length)
+    {
+        free(suffix_tables[length].Preimages);
+        free(suffix_tables[length].Next);
+        free(suffix_tables[length].FirstOperation);
+        free(suffix_tables[length].Index);
+    }
+    free(join_candidates);
+    free(join_words);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                          SEARCH                                               //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A lower bound on the number of operations needed to reach the goal from this node.
+static unsigned lower_bound(const SearchNode * node)
+{
+    bool any_decimal_states = false;
+    bool all_accumulators_ok = true;
+    unsigned bound;
+
+    for (unsigned v = 0; v < NUM_CPU_VARIANTS; ++v)
+    {
+        if (!active[v])
+            continue;
+
+        any_decimal_states |= set_has_decimal_states(&node->Sets[v]);
+        all_accumulators_ok &= set_has_only_accumulator(&node->Sets[v], targets[v]);
+    }
+
+    if (!any_decimal_states && all_accumulators_ok)
+        return 0;
+
+    bound = (any_decimal_states && !all_accumulators_ok) ? 2 : 1;
+
+    for (unsigned v1 = 0; v1 < NUM_CPU_VARIANTS; ++v1)
+    {
+        for (unsigned v2 = v1 + 1; v2 < NUM_CPU_VARIANTS; ++v2)
+        {
+            if (active[v1] && active[v2] && targets[v1] != targets[v2] && set_equal(&node->Sets[v1], &node->Sets[v2]))
+            {
+                const unsigned needed = set_has_decimal_states(&node->Sets[v1]) ? 2 : 3;
+                if (bound < needed)
+                    bound = needed;
+            }
+        }
+    }
+
+    return bound;
+}
+
+static void print_operation(unsigned op)
+{
+    static const char * immediate_mnemonics[7] = {"LDA", "ADC", "SBC", "CMP", "ORA", "AND", "EOR"};
+    static const char * implied_mnemonics[8] = {"CLD", "SED", "CLC", "SEC", "LSR A", "ASL A", "ROR A", "ROL A"};
+
+    if (op < 0x700)
+        printf("%s #$%02x", immediate_mnemonics[op >> 8], op & 0xff);
+    else
+        printf("%s", implied_mnemonics[op - 0x700]);
+}
+
+// Parse an operation as written by print_operation().
+static bool parse_operation(const char * text, unsigned * op)
+{
+    static const char * immediate_mnemonics[7] = {"LDA", "ADC", "SBC", "CMP", "ORA", "AND", "EOR"};
+    static const char * implied_mnemonics[8] = {"CLD", "SED", "CLC", "SEC", "LSR A", "ASL A", "ROR A", "ROL A"};
+    unsigned operand;
+    char end;
+
+    for (unsigned k = 0; k < 8; ++k)
+    {
+        const size_t n = strlen(implied_mnemonics[k]);
+
+        if (strncasecmp(text, implied_mnemonics[k], n) == 0 && text[n + strspn(text + n, " ")] == '\0')
+        {
+            *op = 0x700 + k;
+            return true;
+        }
+    }
+
+    for (unsigned k = 0; k < 7; ++k)
+    {
+        if (strncasecmp(text, immediate_mnemonics[k], 3) == 0 && sscanf(text + 3, " #$%x %c", &operand, &end) == 1 && operand <= 0xff)
+        {
+            *op = (k << 8) | operand;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Parse a sequence of operations, separated by semicolons. Returns the length, or 0 if it can't be parsed
+// (this includes an empty operation, as in 'SED;;CLD').
+static unsigned parse_sequence(char * text)
+{
+    unsigned length = 0;
+
+    for (char * token = text; token != NULL; ++length)
+    {
+        char * const separator = strchr(token, ';');
+        if (separator != NULL)
+            *separator = '\0';
+
+        token += strspn(token, " ");
+        if (length == MAX_LENGTH || !parse_operation(token, &sequence[length]))
+            return 0;
+
+        token = (separator != NULL) ? separator + 1 : NULL;
+    }
+    return length;
+}
+
+// Parse a target accumulator value (0 to 255), or '-' for a variant that is not considered.
+static bool parse_target(const char * text, int * target)
+{
+    char * end;
+    long value;
+
+    if (strcmp(text, "-") == 0)
+    {
+        *target = NO_TARGET;
+        return true;
+    }
+
+    value = strtol(text, &end, 0);
+    if (end == text || *end != '\0' || value < 0 || value > 0xff)
+        return false;
+
+    *target = value;
+    return true;
+}
+
+// Check a sequence for all initial states of all active variants.
+static bool verify_sequence(unsigned length)
+{
+    for (unsigned v = 0; v < NUM_CPU_VARIANTS; ++v)
+    {
+        if (active[v] && !sequence_always_reaches_target(v, sequence, length, targets[v]))
+            return false;
+    }
+    return true;
+}
+
+static void print_solution(unsigned length)
+{
+    printf(verify_sequence(length) ? "solution:" : "solution (VERIFICATION FAILED):");
+    for (unsigned k = 0; k < length; ++k)
+    {
+        printf(k == 0 ? " " : "; ");
+        print_operation(sequence[k]);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+// Join the prefix of the given length with the suffixes of the given length: a suffix completes the
+// prefix if the preimages hold all states of the node. The bitmaps of the candidate entries are ANDed
+// for each state of the node, in join order, only visiting the words that still have candidates.
+// Returns false when enough solutions were found.
+static bool join_suffixes(const SearchNode * node, unsigned length, unsigned remaining)
+{
+    const SuffixTable * table = &suffix_tables[remaining];
+    size_t num_words = table->IndexWords;
+
+    for (size_t w = 0; w < num_words; ++w)
+    {
+        join_candidates[w] = ~(uint64_t)0;
+        join_words[w] = w;
+    }
+    if (table->NumEntries % 64 != 0)
+        join_candidates[num_words - 1] = ((uint64_t)1 << (table->NumEntries % 64)) - 1;
+
+    for (unsigned k = 0; k < table->JoinOrderLength; ++k)
+    {
+        const unsigned v = table->JoinOrder[k] / NUM_CPU_STATES;
+        const CpuStateCode code = table->JoinOrder[k] % NUM_CPU_STATES;
+
+        if ((node->Sets[v].Bits[code / 64] >> (code % 64)) & 1)
+        {
+            const uint64_t * bitmap = &table->Index[table->JoinOrder[k] * table->IndexWords];
+            size_t num_live_words = 0;
+
+            for (size_t i = 0; i < num_words; ++i)
+            {
+                const size_t word = join_words[i];
+                join_candidates[word] &= bitmap[word];
+                if (join_candidates[word] != 0)
+                    join_words[num_live_words++] = word;
+            }
+
+            num_words = num_live_words;
+            if (num_words == 0)
+                return true;
+        }
+    }
+
+    for (size_t k = 0; k < num_words; ++k)
+    {
+        const size_t word = join_words[k];
+        uint64_t bits = join_candidates[word];
+        while (bits != 0)
+        {
+            uint32_t entry = 64 * word + __builtin_ctzll(bits);
+
+            for (unsigned n = remaining; n != 0; --n)
+            {
+                sequence[length + remaining - n] = suffix_tables[n].FirstOperation[entry];
+                entry = suffix_tables[n].Next[entry];
+            }
+
+            print_solution(length + remaining);
+            if (++num_solutions == max_solutions)
+                return false;
+
+            bits &= bits - 1;
+        }
+    }
+
+    return true;
+}
+
+// Extend the prefix of the given length; returns false when enough solutions were found.
+static bool search(const SearchNode * node, unsigned length, unsigned max_length)
+{
+    const unsigned remaining = max_length - length;
+
+    if (lower_bound(node) > remaining || check_visited(node, remaining))
+        return true;
+
+    ++nodes_expanded;
+
+    if (remaining <= suffix_length)
+        return join_suffixes(node, length, remaining);
+
+    for (unsigned op = 0; op < NUM_OPERATIONS; ++op)
+    {
+        SearchNode child;
+
+        for (unsigned v = 0; v < NUM_CPU_VARIANTS; ++v)
+        {
+            if (active[v])
+                set_image(v, &node->Sets[v], op, &child.Sets[v]);
+            else
+                memset(&child.Sets[v], 0, sizeof(StateSet));
+        }
+
+        sequence[length] = op;
+
+        if (!search(&child, length + 1, max_length))
+            return false;
+    }
+
+    return true;
+}
+
+static double seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned max_length = 4;
+    unsigned log2_table_size = 24;
+    unsigned num_targets = 0;
+    char * check_sequence = NULL;
+    SearchNode root;
+
+    for (int k = 1; k < argc; ++k)
+    {
+        if (strcmp(argv[k], "-n") == 0 && k + 1 < argc)
+            max_length = strtoul(argv[++k], NULL, 0);
+        else if (strcmp(argv[k], "-s") == 0 && k + 1 < argc)
+            max_solutions = strtoul(argv[++k], NULL, 0);
+        else if (strcmp(argv[k], "-m") == 0 && k + 1 < argc)
+            log2_table_size = strtoul(argv[++k], NULL, 0);
+        else if (strcmp(argv[k], "-t") == 0 && k + 1 < argc)
+            suffix_length = strtoul(argv[++k], NULL, 0);
+        else if (strcmp(argv[k], "-c") == 0 && k + 1 < argc)
+            check_sequence = argv[++k];
+        else if (num_targets < NUM_CPU_VARIANTS && (argv[k][0] != '-' || argv[k][1] == '\0') && parse_target(argv[k], &targets[num_targets]))
+            ++num_targets;
+        else
+        {
+            fprintf(stderr, "Usage: %s [-n max_length] [-s max_solutions] [-t suffix_length] [-m log2_table_size] [target_V0 target_V1 target_V2]\n", argv[0]);
+            fprintf(stderr, "       %s -c sequence [target_V0 target_V1 target_V2]\n", argv[0]);
+            fprintf(stderr, "Targets are 0 to 255, or '-'. The default '-n 4' takes about 10 s; '-n 5 -t 3' takes about 2.5 min.\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ((num_targets != 0 && num_targets != NUM_CPU_VARIANTS) || max_length > MAX_LENGTH || suffix_length < 1 || suffix_length > MAX_SUFFIX_LENGTH || log2_table_size < 10 || log2_table_size > 32)
+    {
+        fprintf(stderr, "%s: bad arguments.\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (check_sequence != NULL)
+    {
+        const unsigned length = parse_sequence(check_sequence);
+        bool ok = true;
+
+        if (length == 0)
+        {
+            fprintf(stderr, "%s: cannot parse the sequence.\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        make_transition_tables();
+
+        for (unsigned v = 0; v < NUM_CPU_VARIANTS; ++v)
+        {
+            active[v] = (targets[v] != NO_TARGET);
+            if (active[v])
+            {
+                const bool reached = sequence_always_reaches_target(v, sequence, length, targets[v]);
+                printf("V%u : target accumulator value %d %s\n", v, targets[v], reached ? "reached from all initial states" : "NOT reached from all initial states");
+                ok &= reached;
+            }
+        }
+
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    visited_table = calloc((size_t)1 << log2_table_size, sizeof(VisitedEntry));
+    if (visited_table == NULL)
+    {
+        fprintf(stderr, "%s: cannot allocate the table of visited nodes.\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    visited_table_mask = ((uint64_t)1 << log2_table_size) - 1;
+
+    make_transition_tables();
+
+#if defined(SET_PREIMAGE_AVX2)
+    use_avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+    memset(&root, 0, sizeof(root));
+
+    for (unsigned v = 0; v < NUM_CPU_VARIANTS; ++v)
+    {
+        active[v] = (targets[v] != NO_TARGET);
+        if (active[v])
+        {
+            memset(&root.Sets[v], 0xff, sizeof(StateSet));
+            set_add(&goal_sets[v], 0x000 | targets[v]);
+            set_add(&goal_sets[v], 0x100 | targets[v]);
+            printf("V%u : target accumulator value %d\n", v, targets[v]);
+        }
+    }
+
+    const double t_start = seconds();
+
+    if (!make_suffix_tables())
+    {
+        fprintf(stderr, "%s: cannot allocate the suffix tables.\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("suffix tables made in %.3f seconds.\n", seconds() - t_start);
+
+    for (unsigned length = 1; length <= max_length && num_solutions < max_solutions; ++length)
+    {
+        memset(visited_table, 0, ((size_t)1 << log2_table_size) * sizeof(VisitedEntry));
+        visited_count = 0;
+        nodes_expanded = 0;
+
+        search(&root, 0, length);
+
+        printf("length %u: %u solution(s) so far, %llu nodes expanded, %llu nodes recorded, %.3f seconds.\n",
+               length, num_solutions, (unsigned long long)nodes_expanded, (unsigned long long)visited_count, seconds() - t_start);
+        fflush(stdout);
+
+        if (num_solutions != 0)
+            break;
+    }
+
+    if (num_solutions == 0)
+        printf("No solutions of length %u or less.\n", max_length);
+
+    free_suffix_tables();
+    free(visited_table);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,255 @@
+/////////////////////////////
+// test_limited_sim_6502.c //
+/////////////////////////////
+
+// Check that the table-driven operation() gives the same result as operation_direct() for all variants, operations,
+// and states, and compare their speed.
+//
+// Then check that state vectors give the same final states as simulating each initial state separately, for random
+// sequences of operations, and compare their speed.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "limited_sim_6502.h"
+
+static double seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static bool same_state(CpuState s1, CpuState s2)
+{
+    return (s1.FlagD == s2.FlagD) && (s1.FlagC == s2.FlagC) && (s1.Accumulator == s2.Accumulator);
+}
+
+// Run all operations on all states, a number of times; return a checksum of the final states.
+// This is inlined, so that the function is called directly rather than through a pointer.
+static inline __attribute__((always_inline)) unsigned benchmark(CpuState (*f)(CpuVariant, CpuState, unsigned), unsigned repeats)
+{
+    unsigned checksum = 0;
+
+    for (unsigned r = 0; r < repeats; ++r)
+    {
+        for (unsigned variant = 0; variant < NUM_CPU_VARIANTS; ++variant)
+        {
+            for (unsigned op = 0; op < NUM_OPERATIONS; ++op)
+            {
+                for (unsigned code = 0; code < NUM_CPU_STATES; ++code)
+                {
+                    checksum += encode_cpu_state(f(variant, decode_cpu_state(code), op));
+                }
+            }
+        }
+    }
+    return checksum;
+}
+
+// The same, using transition() on encoded states.
+static unsigned benchmark_transition(unsigned repeats)
+{
+    unsigned checksum = 0;
+
+    for (unsigned r = 0; r < repeats; ++r)
+    {
+        for (unsigned variant = 0; variant < NUM_CPU_VARIANTS; ++variant)
+        {
+            for (unsigned op = 0; op < NUM_OPERATIONS; ++op)
+            {
+                for (unsigned code = 0; code < NUM_CPU_STATES; ++code)
+                {
+                    checksum += transition(variant, code, op);
+                }
+            }
+        }
+    }
+    return checksum;
+}
+
+#define NUM_SEQUENCES   2000
+#define SEQUENCE_LENGTH 8
+
+static unsigned random_state = 1;
+
+static unsigned random_operation(void)
+{
+    random_state = random_state * 1103515245 + 12345;
+    return (random_state >> 8) % NUM_OPERATIONS;
+}
+
+static bool same_state_vector(const StateVector * sv1, const StateVector * sv2)
+{
+    return memcmp(sv1, sv2, sizeof(StateVector)) == 0;
+}
+
+// Simulate the sequence for each initial state separately, as always_reaches_target() in 'detect_processor_v1.c' does.
+static void run_sequence_per_state(CpuVariant variant, const unsigned * operations, StateVector * sv)
+{
+    for (unsigned code = 0; code < NUM_CPU_STATES; ++code)
+    {
+        CpuState s = decode_cpu_state(code);
+        for (unsigned k = 0; k < SEQUENCE_LENGTH; ++k)
+        {
+            s = operation(variant, s, operations[k]);
+        }
+        sv->Codes[code] = encode_cpu_state(s);
+    }
+}
+
+static void run_sequence_state_vector(CpuVariant variant, const unsigned * operations, StateVector * sv)
+{
+    state_vector_init(sv);
+    for (unsigned k = 0; k < SEQUENCE_LENGTH; ++k)
+    {
+        state_vector_apply(variant, sv, operations[k]);
+    }
+}
+
+// Run all sequences for all variants using state vectors; return the number of final state vectors that differ
+// from the reference.
+static unsigned benchmark_state_vectors(unsigned operations[NUM_SEQUENCES][SEQUENCE_LENGTH], StateVector (*reference)[NUM_CPU_VARIANTS], double * time_per_sequence)
+{
+    unsigned count_errors = 0;
+    StateVector sv;
+
+    const double t1 = seconds();
+    for (unsigned i = 0; i < NUM_SEQUENCES; ++i)
+    {
+        for (unsigned variant = 0; variant < NUM_CPU_VARIANTS; ++variant)
+        {
+            run_sequence_state_vector(variant, operations[i], &sv);
+            if (!same_state_vector(&sv, &reference[i][variant]))
+            {
+                ++count_errors;
+            }
+        }
+    }
+    const double t2 = seconds();
+
+    *time_per_sequence = (t2 - t1) / (NUM_SEQUENCES * NUM_CPU_VARIANTS);
+    return count_errors;
+}
+
+static bool test_state_vectors(void)
+{
+    static unsigned operations[NUM_SEQUENCES][SEQUENCE_LENGTH];
+    static StateVector reference[NUM_SEQUENCES][NUM_CPU_VARIANTS];
+    unsigned count_errors = 0;
+    double time_scalar, time_avx2;
+
+    for (unsigned i = 0; i < NUM_SEQUENCES; ++i)
+    {
+        for (unsigned k = 0; k < SEQUENCE_LENGTH; ++k)
+        {
+            operations[i][k] = random_operation();
+        }
+    }
+
+    const double t1 = seconds();
+    for (unsigned i = 0; i < NUM_SEQUENCES; ++i)
+    {
+        for (unsigned variant = 0; variant < NUM_CPU_VARIANTS; ++variant)
+        {
+            run_sequence_per_state(variant, operations[i], &reference[i][variant]);
+        }
+    }
+    const double t2 = seconds();
+    const double time_per_state = (t2 - t1) / (NUM_SEQUENCES * NUM_CPU_VARIANTS);
+
+    printf("sequences ... : %u x %u operations, %u variants\n", NUM_SEQUENCES, SEQUENCE_LENGTH, NUM_CPU_VARIANTS);
+    printf("per state ........... : %.2f us/sequence\n", time_per_state * 1e6);
+
+    state_vector_select_avx2(false);
+    count_errors += benchmark_state_vectors(operations, reference, &time_scalar);
+    printf("state vector, scalar  : %.2f us/sequence\n", time_scalar * 1e6);
+
+    if (state_vector_select_avx2(true))
+    {
+        count_errors += benchmark_state_vectors(operations, reference, &time_avx2);
+        printf("state vector, avx2    : %.2f us/sequence\n", time_avx2 * 1e6);
+    }
+    else
+    {
+        printf("state vector, avx2    : not supported\n");
+    }
+
+    // 'CLD; LDA #$xx' always works; 'SED; LDA #$xx' and 'CLD; LDA #$xx; ADC #$00' never do.
+    const unsigned sequence_ok[2] = {0x700, 0x05};
+    const unsigned sequence_decimal[2] = {0x701, 0x05};
+    const unsigned sequence_carry[3] = {0x700, 0x05, 0x100};
+
+    for (unsigned variant = 0; variant < NUM_CPU_VARIANTS; ++variant)
+    {
+        if (!sequence_always_reaches_target(variant, sequence_ok, 2, 0x05) ||
+            sequence_always_reaches_target(variant, sequence_decimal, 2, 0x05) ||
+            sequence_always_reaches_target(variant, sequence_carry, 3, 0x05))
+        {
+            ++count_errors;
+        }
+    }
+
+    printf("errors ...... : %u\n", count_errors);
+
+    return count_errors == 0;
+}
+
+int main(void)
+{
+    const unsigned repeats = 4;
+    unsigned count_tests = 0;
+    unsigned count_errors = 0;
+    double t1, t2;
+
+    t1 = seconds();
+    make_transition_tables();
+    t2 = seconds();
+
+    printf("Transition tables generated in %.3f seconds.\n", t2 - t1);
+
+    for (unsigned variant = 0; variant < NUM_CPU_VARIANTS; ++variant)
+    {
+        for (unsigned op = 0; op < NUM_OPERATIONS; ++op)
+        {
+            for (unsigned code = 0; code < NUM_CPU_STATES; ++code)
+            {
+                const CpuState s = decode_cpu_state(code);
+
+                ++count_tests;
+                if (!same_state(operation(variant, s, op), operation_direct(variant, s, op)))
+                {
+                    ++count_errors;
+                }
+            }
+        }
+    }
+
+    printf("tests ....... : %u\n", count_tests);
+    printf("errors ...... : %u\n", count_errors);
+
+    t1 = seconds();
+    const unsigned checksum_direct = benchmark(operation_direct, repeats);
+    t2 = seconds();
+    const double time_direct = (t2 - t1) / (repeats * count_tests);
+
+    t1 = seconds();
+    const unsigned checksum_table = benchmark(operation, repeats);
+    t2 = seconds();
+    const double time_table = (t2 - t1) / (repeats * count_tests);
+
+    t1 = seconds();
+    const unsigned checksum_transition = benchmark_transition(repeats);
+    t2 = seconds();
+    const double time_transition = (t2 - t1) / (repeats * count_tests);
+
+    printf("operation_direct() : %.2f ns/operation (checksum %08x)\n", time_direct * 1e9, checksum_direct);
+    printf("operation()        : %.2f ns/operation (checksum %08x)\n", time_table * 1e9, checksum_table);
+    printf("transition()       : %.2f ns/operation (checksum %08x)\n", time_transition * 1e9, checksum_transition);
+
+    const bool state_vectors_ok = test_state_vectors();
+
+    return (count_errors == 0 && checksum_direct == checksum_table && checksum_direct == checksum_transition && state_vectors_ok) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
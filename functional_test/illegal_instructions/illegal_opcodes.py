@@ -40,7 +40,10 @@ NOTE: in case of the TAS instruction, an added complexity is that the S register
 
 from typing import NamedTuple
 
+import os
 import json
+import mmap
+import struct
 
 class MachineState(NamedTuple):
     PC: int
@@ -57,6 +60,43 @@ class MachineState(NamedTuple):
     Mem: dict[int, int]
 
 
+def read_binary_state(record, offset):
+    """Decode a state from a binary cache record (see 'singlestep_tests.h')."""
+    (pc, s, a, x, y, p, num_ram) = struct.unpack_from("<HBBBBBB", record, offset)
+    ram = [list(struct.unpack_from("<HB", record, offset + 8 + 3 * k)) for k in range(num_ram)]
+    return {"pc": pc, "s": s, "a": a, "x": x, "y": y, "p": p, "ram": ram}
+
+
+def read_binary_testcases(filename):
+    """Read the test cases from a binary cache file made by 'singlestep_to_bin'."""
+    with open(filename, "rb") as fi, mmap.mmap(fi.fileno(), 0, access=mmap.ACCESS_READ) as data:
+        (magic, version, record_size, count) = struct.unpack_from("<8sHHI", data, 0)
+        if magic != b"SST65X02" or version != 1 or record_size != 320:
+            raise ValueError(f"{filename}: not a binary test file, or wrong version.")
+        if len(data) != 16 + count * record_size:
+            raise ValueError(f"{filename}: file size does not match the number of test cases.")
+        for k in range(count):
+            record = data[16 + k * record_size:16 + (k + 1) * record_size]
+            num_cycles = record[240]
+            cycles = [struct.unpack_from("<HBB", record, 244 + 4 * j) for j in range(num_cycles)]
+            yield {
+                "name": record[0:32].rstrip(b"\0").decode(),
+                "initial": read_binary_state(record, 32),
+                "final": read_binary_state(record, 136),
+                "cycles": [[address, value, "write" if write else "read"] for (address, value, write) in cycles]
+            }
+
+
+def load_testcases(opcode):
+    """Load the test cases of an opcode, from the binary cache file if it exists and is not older than the JSON file."""
+    filename = f"65x02/6502/v1/{opcode:02x}"
+    if os.path.exists(filename + ".bin") and (not os.path.exists(filename + ".json") or
+                                              os.path.getmtime(filename + ".bin") >= os.path.getmtime(filename + ".json")):
+        return read_binary_testcases(filename + ".bin")
+    with open(filename + ".json", "rb") as fi:
+        return json.load(fi)
+
+
 def make_machine_state(state_description):
     return MachineState(
         state_description["pc"],
@@ -77,9 +117,7 @@ def make_machine_state(state_description):
 def test_93():
     """Replicate the behavior of opcode 0x93: SHA (zp),y"""
 
-    filename = "65x02/6502/v1/93.json"
-    with open(filename, "rb") as fi:
-        testcases = json.load(fi)
+    testcases = load_testcases(0x93)
 
     for testcase in testcases:
 
@@ -159,9 +197,7 @@ def test_93():
 def test_9b():
     """Replicate the behavior of opcode 0x9b: TAS abs,y"""
 
-    filename = "65x02/6502/v1/9b.json"
-    with open(filename, "rb") as fi:
-        testcases = json.load(fi)
+    testcases = load_testcases(0x9b)
 
     for testcase in testcases:
 
@@ -238,9 +274,7 @@ def test_9b():
 def test_9c():
     """Replicate the behavior of opcode 0x9c: SHY abs,x"""
 
-    filename = "65x02/6502/v1/9c.json"
-    with open(filename, "rb") as fi:
-        testcases = json.load(fi)
+    testcases = load_testcases(0x9c)
 
     for testcase in testcases:
 
@@ -316,9 +350,7 @@ def test_9c():
 def test_9e():
     """Replicate the behavior of opcode 0x9e: SHX abs,y"""
 
-    filename = "65x02/6502/v1/9e.json"
-    with open(filename, "rb") as fi:
-        testcases = json.load(fi)
+    testcases = load_testcases(0x9e)
 
     for testcase in testcases:
 
@@ -395,9 +427,7 @@ def test_9e():
 def test_9f():
     """Replicate the behavior of opcode 0x9f: SHA abs,y"""
 
-    filename = "65x02/6502/v1/9f.json"
-    with open(filename, "rb") as fi:
-        testcases = json.load(fi)
+    testcases = load_testcases(0x9f)
 
     for testcase in testcases:
 
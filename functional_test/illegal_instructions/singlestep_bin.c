@@ -0,0 +1,202 @@
+//////////////////////
+// singlestep_bin.c //
+//////////////////////
+
+// Binary cache files of the SingleStepTests 65x02 corpus; see 'singlestep_tests.h' for the format.
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "singlestep_tests.h"
+
+#define STATE_SIZE 104
+
+#define OFFSET_NAME       0
+#define OFFSET_INITIAL   32
+#define OFFSET_FINAL    136
+#define OFFSET_NCYCLES  240
+#define OFFSET_CYCLES   244
+
+static void put_uint16(uint8_t * p, unsigned value)
+{
+    p[0] = value & 0xff;
+    p[1] = value >> 8;
+}
+
+static unsigned get_uint16(const uint8_t * p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static void encode_state(const SingleStepState * state, uint8_t * p)
+{
+    unsigned k;
+
+    put_uint16(p, state->PC);
+    p[2] = state->S;
+    p[3] = state->A;
+    p[4] = state->X;
+    p[5] = state->Y;
+    p[6] = state->P;
+    p[7] = state->NumRamEntries;
+
+    for (k = 0; k < state->NumRamEntries; ++k)
+    {
+        put_uint16(&p[8 + 3 * k], state->Ram[k].Address);
+        p[8 + 3 * k + 2] = state->Ram[k].Value;
+    }
+}
+
+static void decode_state(const uint8_t * p, SingleStepState * state)
+{
+    unsigned k;
+
+    state->PC = get_uint16(p);
+    state->S  = p[2];
+    state->A  = p[3];
+    state->X  = p[4];
+    state->Y  = p[5];
+    state->P  = p[6];
+    state->NumRamEntries = (p[7] <= SINGLESTEP_MAX_RAM_ENTRIES) ? p[7] : SINGLESTEP_MAX_RAM_ENTRIES;
+
+    for (k = 0; k < state->NumRamEntries; ++k)
+    {
+        state->Ram[k].Address = get_uint16(&p[8 + 3 * k]);
+        state->Ram[k].Value   = p[8 + 3 * k + 2];
+    }
+}
+
+void singlestep_bin_encode(const SingleStepTest * test, uint8_t * record)
+{
+    unsigned k;
+
+    memset(record, 0, SINGLESTEP_BIN_RECORD_SIZE);
+
+    memcpy(&record[OFFSET_NAME], test->Name, strlen(test->Name));
+
+    encode_state(&test->Initial, &record[OFFSET_INITIAL]);
+    encode_state(&test->Final  , &record[OFFSET_FINAL  ]);
+
+    record[OFFSET_NCYCLES] = test->NumCycles;
+
+    for (k = 0; k < test->NumCycles; ++k)
+    {
+        uint8_t * p = &record[OFFSET_CYCLES + 4 * k];
+
+        put_uint16(p, test->Cycles[k].Address);
+        p[2] = test->Cycles[k].Value;
+        p[3] = test->Cycles[k].Write;
+    }
+}
+
+void singlestep_bin_decode(const uint8_t * record, SingleStepTest * test)
+{
+    unsigned k;
+
+    memcpy(test->Name, &record[OFFSET_NAME], SINGLESTEP_MAX_NAME_LENGTH);
+    test->Name[SINGLESTEP_MAX_NAME_LENGTH] = '\0';
+
+    decode_state(&record[OFFSET_INITIAL], &test->Initial);
+    decode_state(&record[OFFSET_FINAL  ], &test->Final  );
+
+    test->NumCycles = (record[OFFSET_NCYCLES] <= SINGLESTEP_MAX_CYCLES) ? record[OFFSET_NCYCLES] : SINGLESTEP_MAX_CYCLES;
+
+    for (k = 0; k < test->NumCycles; ++k)
+    {
+        const uint8_t * p = &record[OFFSET_CYCLES + 4 * k];
+
+        test->Cycles[k].Address = get_uint16(p);
+        test->Cycles[k].Value   = p[2];
+        test->Cycles[k].Write   = p[3] != 0;
+    }
+}
+
+bool singlestep_bin_write_header(FILE * f, unsigned long num_tests)
+{
+    uint8_t header[SINGLESTEP_BIN_HEADER_SIZE];
+
+    memcpy(header, SINGLESTEP_BIN_MAGIC, 8);
+    put_uint16(&header[ 8], SINGLESTEP_BIN_VERSION);
+    put_uint16(&header[10], SINGLESTEP_BIN_RECORD_SIZE);
+    put_uint16(&header[12], num_tests & 0xffff);
+    put_uint16(&header[14], num_tests >> 16);
+
+    return fwrite(header, 1, sizeof(header), f) == sizeof(header);
+}
+
+bool singlestep_bin_open(SingleStepBinReader * reader, const char * filename)
+{
+    struct stat st;
+    unsigned long num_tests;
+    void * data;
+    int fd;
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        perror(filename);
+        return false;
+    }
+
+    if (fstat(fd, &st) != 0 || st.st_size < SINGLESTEP_BIN_HEADER_SIZE)
+    {
+        fprintf(stderr, "%s: not a binary test file.\n", filename);
+        close(fd);
+        return false;
+    }
+
+    data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        perror(filename);
+        return false;
+    }
+
+    reader->Filename = filename;
+    reader->Data     = data;
+    reader->Size     = st.st_size;
+    reader->NextTest = 0;
+
+    num_tests = get_uint16(&reader->Data[12]) | ((unsigned long)get_uint16(&reader->Data[14]) << 16);
+
+    if (memcmp(reader->Data, SINGLESTEP_BIN_MAGIC, 8) != 0 ||
+        get_uint16(&reader->Data[8]) != SINGLESTEP_BIN_VERSION ||
+        get_uint16(&reader->Data[10]) != SINGLESTEP_BIN_RECORD_SIZE ||
+        reader->Size != SINGLESTEP_BIN_HEADER_SIZE + num_tests * SINGLESTEP_BIN_RECORD_SIZE)
+    {
+        fprintf(stderr, "%s: not a binary test file, or wrong version.\n", filename);
+        singlestep_bin_close(reader);
+        return false;
+    }
+
+    reader->NumTests = num_tests;
+
+    // The records are read front to back.
+    madvise((void *)reader->Data, reader->Size, MADV_SEQUENTIAL);
+
+    return true;
+}
+
+int singlestep_bin_next(SingleStepBinReader * reader, SingleStepTest * test)
+{
+    if (reader->NextTest == reader->NumTests)
+    {
+        return 0;
+    }
+
+    singlestep_bin_decode(&reader->Data[SINGLESTEP_BIN_HEADER_SIZE + reader->NextTest * SINGLESTEP_BIN_RECORD_SIZE], test);
+    ++reader->NextTest;
+
+    return 1;
+}
+
+void singlestep_bin_close(SingleStepBinReader * reader)
+{
+    munmap((void *)reader->Data, reader->Size);
+}
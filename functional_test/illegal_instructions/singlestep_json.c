@@ -0,0 +1,425 @@
+///////////////////////
+// singlestep_json.c //
+///////////////////////
+
+// A streaming reader for the JSON files of the SingleStepTests 65x02 corpus.
+//
+// This is not a general JSON parser: it knows the structure of the test case files and reads
+// the values it needs directly into a SingleStepTest structure. Object members that it does
+// not know are skipped.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "singlestep_tests.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                      CHARACTER LEVEL                                          //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool parse_error(SingleStepJsonReader * reader, const char * message)
+{
+    fprintf(stderr, "%s: offset %lu: %s\n", reader->Filename, reader->FileOffset + reader->BufferPosition, message);
+    return false;
+}
+
+// Return the next character without consuming it, or EOF.
+static int peek_char(SingleStepJsonReader * reader)
+{
+    if (reader->BufferPosition == reader->BufferSize)
+    {
+        reader->FileOffset += reader->BufferSize;
+        reader->BufferSize = fread(reader->Buffer, 1, sizeof(reader->Buffer), reader->File);
+        reader->BufferPosition = 0;
+        if (reader->BufferSize == 0)
+        {
+            return EOF;
+        }
+    }
+    return reader->Buffer[reader->BufferPosition];
+}
+
+static int next_char(SingleStepJsonReader * reader)
+{
+    int c = peek_char(reader);
+    if (c != EOF)
+    {
+        ++reader->BufferPosition;
+    }
+    return c;
+}
+
+// Return the next non-whitespace character without consuming it, or EOF.
+static int peek_token(SingleStepJsonReader * reader)
+{
+    for (;;)
+    {
+        int c = peek_char(reader);
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+        {
+            return c;
+        }
+        ++reader->BufferPosition;
+    }
+}
+
+static bool expect(SingleStepJsonReader * reader, char expected)
+{
+    if (peek_token(reader) != expected)
+    {
+        char message[40];
+        sprintf(message, "expected '%c'", expected);
+        return parse_error(reader, message);
+    }
+    ++reader->BufferPosition;
+    return true;
+}
+
+// After an array element or object member: consume a ',' and return true if another one follows,
+// or consume the closing bracket and return false.
+static bool more_elements(SingleStepJsonReader * reader, char closing_bracket, bool * ok)
+{
+    int c = peek_token(reader);
+    if (c == ',')
+    {
+        ++reader->BufferPosition;
+        return true;
+    }
+    if (c == closing_bracket)
+    {
+        ++reader->BufferPosition;
+        return false;
+    }
+    *ok = parse_error(reader, "expected ',' or closing bracket");
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                        VALUE LEVEL                                            //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Parse a string; it is truncated if it doesn't fit in the buffer.
+static bool parse_string(SingleStepJsonReader * reader, char * buffer, size_t buffer_size)
+{
+    size_t length = 0;
+    int c;
+
+    if (!expect(reader, '"'))
+        return false;
+
+    while ((c = next_char(reader)) != '"')
+    {
+        if (c == EOF)
+            return parse_error(reader, "unterminated string");
+
+        if (c == '\\')
+        {
+            // Keep the escaped character as-is; the corpus doesn't use escapes.
+            c = next_char(reader);
+            if (c == EOF)
+                return parse_error(reader, "unterminated string");
+        }
+
+        if (length + 1 < buffer_size)
+        {
+            buffer[length++] = c;
+        }
+    }
+    buffer[length] = '\0';
+    return true;
+}
+
+static bool parse_unsigned(SingleStepJsonReader * reader, unsigned max_value, unsigned * value)
+{
+    unsigned long result = 0;
+    int c = peek_token(reader);
+
+    if (c < '0' || c > '9')
+        return parse_error(reader, "expected a number");
+
+    do
+    {
+        result = 10 * result + (c - '0');
+        if (result > max_value)
+            return parse_error(reader, "number out of range");
+        ++reader->BufferPosition;
+        c = peek_char(reader);
+    }
+    while (c >= '0' && c <= '9');
+
+    *value = result;
+    return true;
+}
+
+static bool parse_byte(SingleStepJsonReader * reader, uint8_t * value)
+{
+    unsigned v;
+    if (!parse_unsigned(reader, 0xff, &v))
+        return false;
+    *value = v;
+    return true;
+}
+
+static bool parse_address(SingleStepJsonReader * reader, uint16_t * value)
+{
+    unsigned v;
+    if (!parse_unsigned(reader, 0xffff, &v))
+        return false;
+    *value = v;
+    return true;
+}
+
+// Skip a value of any type.
+static bool skip_value(SingleStepJsonReader * reader)
+{
+    char dummy[2];
+    bool ok = true;
+    int c = peek_token(reader);
+
+    switch (c)
+    {
+        case '"':
+            return parse_string(reader, dummy, sizeof(dummy));
+        case '[':
+        case '{':
+            ++reader->BufferPosition;
+            if (peek_token(reader) == (c == '[' ? ']' : '}'))
+            {
+                ++reader->BufferPosition;
+                return true;
+            }
+            do
+            {
+                if (c == '{' && !(parse_string(reader, dummy, sizeof(dummy)) && expect(reader, ':')))
+                    return false;
+                if (!skip_value(reader))
+                    return false;
+            }
+            while (more_elements(reader, c == '[' ? ']' : '}', &ok));
+            return ok;
+        case EOF:
+            return parse_error(reader, "unexpected end of file");
+        default:
+            // A number, true, false, or null.
+            while (c != ',' && c != ']' && c != '}' && c != EOF)
+            {
+                ++reader->BufferPosition;
+                c = peek_token(reader);
+            }
+            return true;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                      TEST CASE LEVEL                                          //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Parse the "ram" member of a state: an array of [address, value] pairs.
+static bool parse_ram(SingleStepJsonReader * reader, SingleStepState * state)
+{
+    bool ok = true;
+
+    state->NumRamEntries = 0;
+
+    if (!expect(reader, '['))
+        return false;
+
+    if (peek_token(reader) == ']')
+    {
+        ++reader->BufferPosition;
+        return true;
+    }
+
+    do
+    {
+        SingleStepRamEntry * entry;
+
+        if (state->NumRamEntries == SINGLESTEP_MAX_RAM_ENTRIES)
+            return parse_error(reader, "too many RAM entries");
+
+        entry = &state->Ram[state->NumRamEntries++];
+
+        if (!(expect(reader, '[') && parse_address(reader, &entry->Address) && expect(reader, ',') && parse_byte(reader, &entry->Value) && expect(reader, ']')))
+            return false;
+    }
+    while (more_elements(reader, ']', &ok));
+
+    return ok;
+}
+
+static bool parse_state(SingleStepJsonReader * reader, SingleStepState * state)
+{
+    char key[8];
+    bool ok = true;
+
+    if (!expect(reader, '{'))
+        return false;
+
+    do
+    {
+        if (!(parse_string(reader, key, sizeof(key)) && expect(reader, ':')))
+            return false;
+
+        if      (strcmp(key, "pc" ) == 0) ok = parse_address(reader, &state->PC);
+        else if (strcmp(key, "s"  ) == 0) ok = parse_byte(reader, &state->S);
+        else if (strcmp(key, "a"  ) == 0) ok = parse_byte(reader, &state->A);
+        else if (strcmp(key, "x"  ) == 0) ok = parse_byte(reader, &state->X);
+        else if (strcmp(key, "y"  ) == 0) ok = parse_byte(reader, &state->Y);
+        else if (strcmp(key, "p"  ) == 0) ok = parse_byte(reader, &state->P);
+        else if (strcmp(key, "ram") == 0) ok = parse_ram(reader, state);
+        else                              ok = skip_value(reader);
+
+        if (!ok)
+            return false;
+    }
+    while (more_elements(reader, '}', &ok));
+
+    return ok;
+}
+
+// Parse the "cycles" member of a test case: an array of [address, value, "read" or "write"] triplets.
+static bool parse_cycles(SingleStepJsonReader * reader, SingleStepTest * test)
+{
+    bool ok = true;
+
+    test->NumCycles = 0;
+
+    if (!expect(reader, '['))
+        return false;
+
+    if (peek_token(reader) == ']')
+    {
+        ++reader->BufferPosition;
+        return true;
+    }
+
+    do
+    {
+        SingleStepCycle * cycle;
+        char kind[8];
+
+        if (test->NumCycles == SINGLESTEP_MAX_CYCLES)
+            return parse_error(reader, "too many cycles");
+
+        cycle = &test->Cycles[test->NumCycles++];
+
+        if (!(expect(reader, '[') && parse_address(reader, &cycle->Address) && expect(reader, ',') && parse_byte(reader, &cycle->Value) && expect(reader, ',') && parse_string(reader, kind, sizeof(kind)) && expect(reader, ']')))
+            return false;
+
+        if (strcmp(kind, "read") == 0)
+            cycle->Write = false;
+        else if (strcmp(kind, "write") == 0)
+            cycle->Write = true;
+        else
+            return parse_error(reader, "expected \"read\" or \"write\"");
+    }
+    while (more_elements(reader, ']', &ok));
+
+    return ok;
+}
+
+static bool parse_test(SingleStepJsonReader * reader, SingleStepTest * test)
+{
+    char key[16];
+    bool ok = true;
+
+    memset(test, 0, sizeof(SingleStepTest));
+
+    if (!expect(reader, '{'))
+        return false;
+
+    do
+    {
+        if (!(parse_string(reader, key, sizeof(key)) && expect(reader, ':')))
+            return false;
+
+        if      (strcmp(key, "name"   ) == 0) ok = parse_string(reader, test->Name, sizeof(test->Name));
+        else if (strcmp(key, "initial") == 0) ok = parse_state(reader, &test->Initial);
+        else if (strcmp(key, "final"  ) == 0) ok = parse_state(reader, &test->Final);
+        else if (strcmp(key, "cycles" ) == 0) ok = parse_cycles(reader, test);
+        else                                  ok = skip_value(reader);
+
+        if (!ok)
+            return false;
+    }
+    while (more_elements(reader, '}', &ok));
+
+    return ok;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                        READER API                                             //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool singlestep_json_open(SingleStepJsonReader * reader, const char * filename)
+{
+    reader->File = fopen(filename, "rb");
+    if (reader->File == NULL)
+    {
+        perror(filename);
+        return false;
+    }
+
+    reader->Filename       = filename;
+    reader->BufferSize     = 0;
+    reader->BufferPosition = 0;
+    reader->FileOffset     = 0;
+    reader->AtStart        = true;
+    reader->AtEnd          = false;
+
+    return true;
+}
+
+int singlestep_json_next(SingleStepJsonReader * reader, SingleStepTest * test)
+{
+    if (reader->AtEnd)
+        return 0;
+
+    if (reader->AtStart)
+    {
+        if (!expect(reader, '['))
+            return -1;
+
+        reader->AtStart = false;
+
+        if (peek_token(reader) == ']')
+        {
+            ++reader->BufferPosition;
+            reader->AtEnd = true;
+            return 0;
+        }
+    }
+    else
+    {
+        // Only the closing ']' ends the array; a file that ends before it is truncated.
+        int c = peek_token(reader);
+        if (c == ']')
+        {
+            ++reader->BufferPosition;
+            reader->AtEnd = true;
+            return 0;
+        }
+        if (c == EOF)
+        {
+            parse_error(reader, "unexpected end of file, expected ']'");
+            return -1;
+        }
+        if (!expect(reader, ','))
+            return -1;
+    }
+
+    return parse_test(reader, test) ? 1 : -1;
+}
+
+void singlestep_json_close(SingleStepJsonReader * reader)
+{
+    fclose(reader->File);
+}
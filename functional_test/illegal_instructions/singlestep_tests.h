@@ -0,0 +1,130 @@
+////////////////////////
+// singlestep_tests.h //
+////////////////////////
+
+// Test cases of the "SingleStepTests" 65x02 corpus (https://github.com/SingleStepTests/65x02).
+//
+// Each file in the corpus (e.g. '6502/v1/93.json') holds 10,000 test cases for one opcode.
+// A test case gives the processor state before and after executing a single instruction,
+// and the bus cycles performed by the instruction. For example:
+//
+//   {
+//     "name": "93 d5 3c",
+//     "initial": {"pc": 1234, "s": 240, "a": 1, "x": 2, "y": 3, "p": 36, "ram": [[1234, 147], ...]},
+//     "final":   {"pc": 1236, "s": 240, "a": 1, "x": 2, "y": 3, "p": 36, "ram": [[1234, 147], ...]},
+//     "cycles":  [[1234, 147, "read"], ...]
+//   }
+//
+// The JSON reader below parses such a file incrementally, one test case at a time, so the memory
+// needed does not depend on the size of the file.
+
+#ifndef SINGLESTEP_TESTS_H
+#define SINGLESTEP_TESTS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define SINGLESTEP_MAX_NAME_LENGTH 31
+#define SINGLESTEP_MAX_RAM_ENTRIES 32
+#define SINGLESTEP_MAX_CYCLES      16
+
+typedef struct {
+    uint16_t Address;
+    uint8_t  Value;
+} SingleStepRamEntry;
+
+typedef struct {
+    uint16_t           PC;
+    uint8_t            S;
+    uint8_t            A;
+    uint8_t            X;
+    uint8_t            Y;
+    uint8_t            P;
+    unsigned           NumRamEntries;
+    SingleStepRamEntry Ram[SINGLESTEP_MAX_RAM_ENTRIES];
+} SingleStepState;
+
+typedef struct {
+    uint16_t Address;
+    uint8_t  Value;
+    bool     Write;
+} SingleStepCycle;
+
+typedef struct {
+    char            Name[SINGLESTEP_MAX_NAME_LENGTH + 1];
+    SingleStepState Initial;
+    SingleStepState Final;
+    unsigned        NumCycles;
+    SingleStepCycle Cycles[SINGLESTEP_MAX_CYCLES];
+} SingleStepTest;
+
+typedef struct {
+    FILE *        File;
+    const char *  Filename;
+    unsigned char Buffer[65536];
+    size_t        BufferSize;
+    size_t        BufferPosition;
+    unsigned long FileOffset;     // File offset of the first byte in the buffer.
+    bool          AtStart;        // The opening '[' of the test case array was not read yet.
+    bool          AtEnd;          // The closing ']' of the test case array was read.
+} SingleStepJsonReader;
+
+// Open a JSON file of the corpus. Returns false (after printing a message) on failure.
+bool singlestep_json_open(SingleStepJsonReader * reader, const char * filename);
+
+// Read the next test case. Returns 1 if a test case was read, 0 at the end of the test case array,
+// or -1 if the file is malformed (after printing a message); this includes a file that ends
+// before the closing ']' of the array.
+int singlestep_json_next(SingleStepJsonReader * reader, SingleStepTest * test);
+
+void singlestep_json_close(SingleStepJsonReader * reader);
+
+// Binary cache files.
+//
+// Parsing the JSON files is by far the slowest part of working with the corpus. A JSON file can
+// be converted once to a binary file with fixed-size records, which is memory-mapped for reading.
+// All values are stored in little-endian order:
+//
+//   header (16 bytes): magic "SST65X02", uint16 version, uint16 record size, uint32 test count
+//
+//   record (320 bytes):
+//     offset   0 : name (32 bytes, NUL-padded)
+//     offset  32 : initial state (104 bytes)
+//     offset 136 : final state (104 bytes)
+//     offset 240 : number of cycles (1 byte), followed by 3 padding bytes
+//     offset 244 : 16 cycles of 4 bytes: address (uint16), value, 0 (read) or 1 (write)
+//     offset 308 : padding (12 bytes)
+//
+//   state (104 bytes):
+//     pc (uint16), s, a, x, y, p, number of RAM entries (1 byte),
+//     32 RAM entries of 3 bytes: address (uint16), value
+
+#define SINGLESTEP_BIN_MAGIC       "SST65X02"
+#define SINGLESTEP_BIN_VERSION     1
+#define SINGLESTEP_BIN_HEADER_SIZE 16
+#define SINGLESTEP_BIN_RECORD_SIZE 320
+
+typedef struct {
+    const char *    Filename;
+    const uint8_t * Data;
+    size_t          Size;
+    unsigned long   NumTests;
+    unsigned long   NextTest;
+} SingleStepBinReader;
+
+void singlestep_bin_encode(const SingleStepTest * test, uint8_t * record);
+void singlestep_bin_decode(const uint8_t * record, SingleStepTest * test);
+
+// Write the file header; 'num_tests' is typically updated by rewriting the header at the end.
+bool singlestep_bin_write_header(FILE * f, unsigned long num_tests);
+
+// Open a binary file. Returns false (after printing a message) on failure.
+bool singlestep_bin_open(SingleStepBinReader * reader, const char * filename);
+
+// Read the next test case. Returns 1 if a test case was read, or 0 at the end of the file.
+int singlestep_bin_next(SingleStepBinReader * reader, SingleStepTest * test);
+
+void singlestep_bin_close(SingleStepBinReader * reader);
+
+#endif
@@ -0,0 +1,100 @@
+/////////////////////////
+// singlestep_to_bin.c //
+/////////////////////////
+
+// Convert JSON files of the SingleStepTests 65x02 corpus to binary cache files.
+//
+// Usage: singlestep_to_bin <file.json> ...
+//
+// Each 'XX.json' file is converted to 'XX.bin' in the same directory. The validator and other
+// tools use the binary file instead of the JSON file when it is present.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "singlestep_tests.h"
+
+static bool convert_file(const char * json_filename)
+{
+    static SingleStepJsonReader reader;
+    SingleStepTest test;
+    uint8_t record[SINGLESTEP_BIN_RECORD_SIZE];
+    char bin_filename[4096];
+    unsigned long num_tests = 0;
+    size_t length;
+    bool ok = true;
+    int status = 0;
+    FILE * f;
+
+    length = strlen(json_filename);
+    if (length < 5 || strcmp(json_filename + length - 5, ".json") != 0 || length >= sizeof(bin_filename))
+    {
+        fprintf(stderr, "%s: expected a filename ending in '.json'.\n", json_filename);
+        return false;
+    }
+
+    strcpy(bin_filename, json_filename);
+    strcpy(bin_filename + length - 5, ".bin");
+
+    if (!singlestep_json_open(&reader, json_filename))
+    {
+        return false;
+    }
+
+    f = fopen(bin_filename, "wb");
+    if (f == NULL)
+    {
+        perror(bin_filename);
+        singlestep_json_close(&reader);
+        return false;
+    }
+
+    // The header is rewritten with the actual test count at the end.
+
+    ok = singlestep_bin_write_header(f, 0);
+
+    while (ok && (status = singlestep_json_next(&reader, &test)) == 1)
+    {
+        singlestep_bin_encode(&test, record);
+        ok = fwrite(record, 1, sizeof(record), f) == sizeof(record);
+        ++num_tests;
+    }
+
+    ok = ok && status == 0 && fseek(f, 0, SEEK_SET) == 0 && singlestep_bin_write_header(f, num_tests);
+
+    ok = (fclose(f) == 0) && ok;
+
+    singlestep_json_close(&reader);
+
+    if (ok)
+    {
+        printf("%s : %lu tests\n", bin_filename, num_tests);
+    }
+    else
+    {
+        fprintf(stderr, "%s: conversion failed.\n", json_filename);
+        remove(bin_filename);
+    }
+
+    return ok;
+}
+
+int main(int argc, char ** argv)
+{
+    bool ok = true;
+    int k;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <file.json> ...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    for (k = 1; k < argc; ++k)
+    {
+        ok = convert_file(argv[k]) && ok;
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,435 @@
+///////////////////////////
+// validate_singlestep.c //
+///////////////////////////
+
+// Validate the host 6502 simulator of TIC against the SingleStepTests 65x02 corpus.
+//
+// Usage: validate_singlestep [-j <threads>] <file or directory> ...
+//
+// For a directory (e.g. '65x02/6502/v1'), the files '00.json' to 'ff.json' in it are validated.
+// Binary cache files made by 'singlestep_to_bin' ('XX.bin') can be given instead of JSON files,
+// and are used instead of the JSON files in a directory when present.
+// Each test case is run through the simulator, after which the registers, the RAM, and the bus
+// cycles performed are compared to the expected values. The files are processed by a pool of
+// threads; each file is read incrementally, so memory use doesn't depend on the file size.
+//
+// The JAM opcodes are skipped, since the corpus models the bus activity of a halted processor,
+// which the simulator does not do.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "sim_6502.h"
+#include "singlestep_tests.h"
+
+// The flags that exist in the processor; bits 4 (B) and 5 are not compared.
+
+#define P_FLAGS_MASK 0xcf
+
+typedef struct {
+    char *        Filename;
+    unsigned long TestCount;
+    unsigned long SkipCount;
+    unsigned long FailCount;
+    bool          ReadError;
+    char          FirstFailure[160];
+} FileResult;
+
+static FileResult * file_results;
+static unsigned     num_files;
+static atomic_uint  next_file;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                     RUNNING A TEST CASE                                       //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The 12 JAM opcodes: 0x02, 0x12, ..., 0x72, 0x92, 0xb2, 0xd2, and 0xf2.
+static bool is_jam_opcode(uint8_t opcode)
+{
+    return (opcode & 0x0f) == 0x02 && opcode != 0x82 && opcode != 0xa2 && opcode != 0xc2 && opcode != 0xe2;
+}
+
+// Find the opcode of a test case in its initial RAM contents.
+static bool get_opcode(const SingleStepTest * test, uint8_t * opcode)
+{
+    unsigned k;
+
+    for (k = 0; k < test->Initial.NumRamEntries; ++k)
+    {
+        if (test->Initial.Ram[k].Address == test->Initial.PC)
+        {
+            *opcode = test->Initial.Ram[k].Value;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Record the first mismatch of a test case.
+static bool mismatch(char * message, size_t message_size, const char * format, ...)
+{
+    va_list args;
+
+    if (message[0] == '\0')
+    {
+        va_start(args, format);
+        vsnprintf(message, message_size, format, args);
+        va_end(args);
+    }
+    return false;
+}
+
+static bool run_test(Sim6502 * cpu, const SingleStepTest * test, char * message, size_t message_size)
+{
+    const SingleStepState * initial = &test->Initial;
+    const SingleStepState * final   = &test->Final;
+    unsigned long start_cycle_count;
+    unsigned num_cycles, k;
+    bool ok = true;
+
+    message[0] = '\0';
+
+    for (k = 0; k < initial->NumRamEntries; ++k)
+    {
+        cpu->Memory[initial->Ram[k].Address] = initial->Ram[k].Value;
+    }
+
+    cpu->PC   = initial->PC;
+    cpu->RegA = initial->A;
+    cpu->RegX = initial->X;
+    cpu->RegY = initial->Y;
+    cpu->RegS = initial->S;
+    sim_6502_set_p(cpu, initial->P);
+    cpu->Halted = false;
+
+    start_cycle_count = cpu->CycleCount;
+
+    sim_6502_execute_instruction(cpu);
+
+    num_cycles = cpu->CycleCount - start_cycle_count;
+
+    if (cpu->PC != final->PC)
+        ok = mismatch(message, message_size, "PC is 0x%04x, expected 0x%04x", cpu->PC, final->PC);
+    if (cpu->RegA != final->A)
+        ok = mismatch(message, message_size, "A is 0x%02x, expected 0x%02x", cpu->RegA, final->A);
+    if (cpu->RegX != final->X)
+        ok = mismatch(message, message_size, "X is 0x%02x, expected 0x%02x", cpu->RegX, final->X);
+    if (cpu->RegY != final->Y)
+        ok = mismatch(message, message_size, "Y is 0x%02x, expected 0x%02x", cpu->RegY, final->Y);
+    if (cpu->RegS != final->S)
+        ok = mismatch(message, message_size, "S is 0x%02x, expected 0x%02x", cpu->RegS, final->S);
+    if (((sim_6502_get_p(cpu) ^ final->P) & P_FLAGS_MASK) != 0)
+        ok = mismatch(message, message_size, "P is 0x%02x, expected 0x%02x", sim_6502_get_p(cpu), final->P);
+
+    for (k = 0; k < final->NumRamEntries; ++k)
+    {
+        uint8_t value = cpu->Memory[final->Ram[k].Address];
+        if (value != final->Ram[k].Value)
+            ok = mismatch(message, message_size, "RAM[0x%04x] is 0x%02x, expected 0x%02x", final->Ram[k].Address, value, final->Ram[k].Value);
+    }
+
+    if (num_cycles != test->NumCycles)
+    {
+        ok = mismatch(message, message_size, "%u cycles, expected %u", num_cycles, test->NumCycles);
+    }
+    else
+    {
+        for (k = 0; k < num_cycles; ++k)
+        {
+            const Sim6502BusCycle * actual   = &cpu->Trace->Cycles[(start_cycle_count + k) % SIM_6502_TRACE_SIZE];
+            const SingleStepCycle * expected = &test->Cycles[k];
+
+            if (actual->Address != expected->Address || actual->Data != expected->Value || actual->Write != expected->Write)
+            {
+                ok = mismatch(message, message_size, "cycle %u is %c 0x%04x 0x%02x, expected %c 0x%04x 0x%02x", k + 1,
+                              actual->Write ? 'W' : 'R', actual->Address, actual->Data,
+                              expected->Write ? 'W' : 'R', expected->Address, expected->Value);
+                break;
+            }
+        }
+    }
+
+    // Clear the memory touched by the test case, so it doesn't influence the next one.
+
+    for (k = 0; k < initial->NumRamEntries; ++k)
+    {
+        cpu->Memory[initial->Ram[k].Address] = 0;
+    }
+    for (k = 0; k < final->NumRamEntries; ++k)
+    {
+        cpu->Memory[final->Ram[k].Address] = 0;
+    }
+
+    return ok;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                     VALIDATING FILES                                          //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Test cases are read either from a JSON file or from a binary cache file.
+
+typedef struct {
+    bool                 Binary;
+    SingleStepJsonReader JsonReader;
+    SingleStepBinReader  BinReader;
+} TestReader;
+
+static bool has_extension(const char * filename, const char * extension)
+{
+    size_t length = strlen(filename);
+    size_t extension_length = strlen(extension);
+
+    return length >= extension_length && strcmp(filename + length - extension_length, extension) == 0;
+}
+
+static bool open_test_file(TestReader * reader, const char * filename)
+{
+    reader->Binary = has_extension(filename, ".bin");
+
+    if (reader->Binary)
+        return singlestep_bin_open(&reader->BinReader, filename);
+    else
+        return singlestep_json_open(&reader->JsonReader, filename);
+}
+
+static int next_test(TestReader * reader, SingleStepTest * test)
+{
+    if (reader->Binary)
+        return singlestep_bin_next(&reader->BinReader, test);
+    else
+        return singlestep_json_next(&reader->JsonReader, test);
+}
+
+static void close_test_file(TestReader * reader)
+{
+    if (reader->Binary)
+        singlestep_bin_close(&reader->BinReader);
+    else
+        singlestep_json_close(&reader->JsonReader);
+}
+
+static void validate_file(Sim6502 * cpu, TestReader * reader, SingleStepTest * test, FileResult * result)
+{
+    char message[120];
+    uint8_t opcode;
+    int status;
+
+    if (!open_test_file(reader, result->Filename))
+    {
+        result->ReadError = true;
+        return;
+    }
+
+    while ((status = next_test(reader, test)) == 1)
+    {
+        if (get_opcode(test, &opcode) && is_jam_opcode(opcode))
+        {
+            ++result->SkipCount;
+            continue;
+        }
+
+        ++result->TestCount;
+
+        if (!run_test(cpu, test, message, sizeof(message)))
+        {
+            if (result->FailCount++ == 0)
+            {
+                snprintf(result->FirstFailure, sizeof(result->FirstFailure), "\"%s\": %s", test->Name, message);
+            }
+        }
+    }
+
+    if (status < 0)
+    {
+        result->ReadError = true;
+    }
+
+    close_test_file(reader);
+}
+
+static void * worker_thread_main(void * arg)
+{
+    // Each worker has its own simulated processor, memory image, and reader.
+
+    TestReader           * reader = malloc(sizeof(TestReader));
+    SingleStepTest       * test   = malloc(sizeof(SingleStepTest));
+    Sim6502Trace         * trace  = malloc(sizeof(Sim6502Trace));
+    uint8_t              * memory = calloc(0x10000, 1);
+    Sim6502 cpu;
+    unsigned index;
+
+    (void)arg;
+
+    if (reader == NULL || test == NULL || trace == NULL || memory == NULL)
+    {
+        fprintf(stderr, "Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    sim_6502_reset(&cpu, memory);
+    cpu.Trace = trace;
+
+    while ((index = atomic_fetch_add(&next_file, 1)) < num_files)
+    {
+        validate_file(&cpu, reader, test, &file_results[index]);
+    }
+
+    free(memory);
+    free(trace);
+    free(test);
+    free(reader);
+
+    return NULL;
+}
+
+static void add_file(const char * filename)
+{
+    file_results = realloc(file_results, (num_files + 1) * sizeof(FileResult));
+    if (file_results == NULL)
+    {
+        fprintf(stderr, "Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memset(&file_results[num_files], 0, sizeof(FileResult));
+    file_results[num_files].Filename = strdup(filename);
+    ++num_files;
+}
+
+static void add_directory(const char * directory)
+{
+    char bin_filename[4096], json_filename[4096];
+    struct stat bin_st, json_st;
+    bool have_bin, have_json;
+    unsigned opcode;
+
+    for (opcode = 0; opcode < 256; ++opcode)
+    {
+        snprintf(bin_filename, sizeof(bin_filename), "%s/%02x.bin", directory, opcode);
+        snprintf(json_filename, sizeof(json_filename), "%s/%02x.json", directory, opcode);
+
+        have_bin  = stat(bin_filename, &bin_st) == 0;
+        have_json = stat(json_filename, &json_st) == 0;
+
+        // A binary cache file that is older than its JSON file is stale; use the JSON file instead.
+        if (have_bin && (!have_json || bin_st.st_mtime >= json_st.st_mtime))
+        {
+            add_file(bin_filename);
+        }
+        else if (have_json)
+        {
+            if (have_bin)
+                fprintf(stderr, "%s: older than %s, not used.\n", bin_filename, json_filename);
+            add_file(json_filename);
+        }
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned long total_tests = 0, total_skipped = 0, total_failed = 0;
+    unsigned num_threads = 0, num_bad_files = 0;
+    struct timespec start_time, end_time;
+    pthread_t * threads;
+    unsigned k;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "j:")) != -1)
+    {
+        if (opt == 'j')
+        {
+            num_threads = strtoul(optarg, NULL, 0);
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [-j <threads>] <file or directory> ...\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (k = optind; k < (unsigned)argc; ++k)
+    {
+        struct stat st;
+        if (stat(argv[k], &st) == 0 && S_ISDIR(st.st_mode))
+            add_directory(argv[k]);
+        else
+            add_file(argv[k]);
+    }
+
+    if (num_files == 0)
+    {
+        fprintf(stderr, "No test files specified.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (num_threads == 0)
+    {
+        long num_processors = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = (num_processors > 0) ? num_processors : 1;
+    }
+    if (num_threads > num_files)
+    {
+        num_threads = num_files;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    threads = malloc(num_threads * sizeof(pthread_t));
+    for (k = 0; k < num_threads; ++k)
+    {
+        if (pthread_create(&threads[k], NULL, worker_thread_main, NULL) != 0)
+        {
+            fprintf(stderr, "Unable to create thread.\n");
+            return EXIT_FAILURE;
+        }
+    }
+    for (k = 0; k < num_threads; ++k)
+    {
+        pthread_join(threads[k], NULL);
+    }
+    free(threads);
+
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+
+    for (k = 0; k < num_files; ++k)
+    {
+        const FileResult * result = &file_results[k];
+
+        printf("%s : %lu tests", result->Filename, result->TestCount);
+        if (result->SkipCount != 0)
+            printf(", %lu skipped", result->SkipCount);
+        printf(", %lu failed", result->FailCount);
+        if (result->FailCount != 0)
+            printf(" (first: %s)", result->FirstFailure);
+        if (result->ReadError)
+            printf(" -- READ ERROR");
+        printf("\n");
+
+        total_tests   += result->TestCount;
+        total_skipped += result->SkipCount;
+        total_failed  += result->FailCount;
+        num_bad_files += result->ReadError;
+    }
+
+    printf("\n");
+    printf("Files .................... : %u\n", num_files);
+    printf("Tests performed .......... : %lu\n", total_tests);
+    printf("Tests skipped ............ : %lu\n", total_skipped);
+    printf("Tests failed ............. : %lu\n", total_failed);
+    printf("Threads .................. : %u\n", num_threads);
+    printf("Duration ................. : %.3f s\n", (end_time.tv_sec - start_time.tv_sec) + 1e-9 * (end_time.tv_nsec - start_time.tv_nsec));
+
+    return (total_failed == 0 && num_bad_files == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,620 @@
+////////////////
+// sim_6502.c //
+////////////////
+
+#include <stddef.h>
+
+#include "sim_6502.h"
+#include "6502_adc_sbc.h"
+
+// The processor variant is selected at compile time, like in the rest of TIC:
+//
+// CPU_6502  - NMOS 6502, including the undocumented opcodes.
+// CPU_65C02 - WDC 65C02.
+//
+// For the 65C02, the number of bus cycles of each instruction is exact. The addresses of the
+// dummy cycles of the 65C02 are only modeled as far as they are the same as on the 6502.
+
+#if !defined(CPU_6502) && !defined(CPU_65C02)
+#error "CPU type not specified."
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                          BUS ACCESS                                           //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Each bus access takes precisely one clock cycle.
+
+static inline void trace_bus_cycle(Sim6502 * cpu, uint16_t address, uint8_t value, bool write)
+{
+    if (cpu->Trace != NULL)
+    {
+        Sim6502BusCycle * cycle = &cpu->Trace->Cycles[cpu->CycleCount % SIM_6502_TRACE_SIZE];
+
+        cycle->Address = address;
+        cycle->Data    = value;
+        cycle->Write   = write;
+    }
+}
+
+static inline uint8_t bus_read(Sim6502 * cpu, uint16_t address)
+{
+    uint8_t value = cpu->Memory[address];
+    trace_bus_cycle(cpu, address, value, false);
+    ++cpu->CycleCount;
+    return value;
+}
+
+static inline void bus_write(Sim6502 * cpu, uint16_t address, uint8_t value)
+{
+    trace_bus_cycle(cpu, address, value, true);
+    ++cpu->CycleCount;
+    cpu->Memory[address] = value;
+}
+
+static inline uint8_t fetch(Sim6502 * cpu)
+{
+    return bus_read(cpu, cpu->PC++);
+}
+
+static inline void push(Sim6502 * cpu, uint8_t value)
+{
+    bus_write(cpu, 0x100 + cpu->RegS--, value);
+}
+
+static inline uint8_t pull(Sim6502 * cpu)
+{
+    return bus_read(cpu, 0x100 + ++cpu->RegS);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                       ADDRESSING MODES                                        //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// These functions fetch the operand bytes of an instruction and perform the dummy bus accesses
+// that the 6502 does while calculating the effective address. They return the effective address.
+//
+// Indexed addressing modes come in two flavors. Read instructions only do a dummy read of the
+// (not yet corrected) effective address if the index crosses a page boundary. Write and
+// read-modify-write instructions always do that dummy read.
+
+static inline uint16_t am_zpage(Sim6502 * cpu)
+{
+    return fetch(cpu);
+}
+
+static inline uint16_t am_zpage_indexed(Sim6502 * cpu, uint8_t index)
+{
+    const uint8_t base = fetch(cpu);
+    bus_read(cpu, base);
+    return (uint8_t)(base + index);
+}
+
+static inline uint16_t am_abs(Sim6502 * cpu)
+{
+    const uint8_t lo = fetch(cpu);
+    const uint8_t hi = fetch(cpu);
+    return hi * 0x100 + lo;
+}
+
+static inline uint16_t indexed_address(Sim6502 * cpu, uint16_t base, uint8_t index, bool always_dummy_read)
+{
+    const uint16_t address = base + index;
+    if (always_dummy_read || (address & 0xff00) != (base & 0xff00))
+    {
+        bus_read(cpu, (base & 0xff00) | (address & 0x00ff));
+    }
+    return address;
+}
+
+static inline uint16_t am_abs_indexed(Sim6502 * cpu, uint8_t index, bool always_dummy_read)
+{
+    return indexed_address(cpu, am_abs(cpu), index, always_dummy_read);
+}
+
+static inline uint16_t am_zpage_x_indirect(Sim6502 * cpu)
+{
+    const uint8_t base = fetch(cpu);
+    bus_read(cpu, base);
+    const uint8_t pointer = base + cpu->RegX;
+    const uint8_t lo = bus_read(cpu, pointer);
+    const uint8_t hi = bus_read(cpu, (uint8_t)(pointer + 1));
+    return hi * 0x100 + lo;
+}
+
+static inline uint16_t am_zpage_indirect_y(Sim6502 * cpu, bool always_dummy_read)
+{
+    const uint8_t pointer = fetch(cpu);
+    const uint8_t lo = bus_read(cpu, pointer);
+    const uint8_t hi = bus_read(cpu, (uint8_t)(pointer + 1));
+    return indexed_address(cpu, hi * 0x100 + lo, cpu->RegY, always_dummy_read);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                          OPERATIONS                                           //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline uint8_t set_nz(Sim6502 * cpu, uint8_t value)
+{
+    cpu->FlagN = (value & 0x80) != 0;
+    cpu->FlagZ = value == 0;
+    return value;
+}
+
+static inline void set_add_sub_result(Sim6502 * cpu, AddSubResult result)
+{
+    cpu->RegA  = result.Accumulator;
+    cpu->FlagN = result.FlagN;
+    cpu->FlagV = result.FlagV;
+    cpu->FlagZ = result.FlagZ;
+    cpu->FlagC = result.FlagC;
+}
+
+#if defined(CPU_6502)
+
+static inline void op_adc(Sim6502 * cpu, uint8_t operand)
+{
+    set_add_sub_result(cpu, adc_6502(cpu->FlagD, cpu->FlagC, cpu->RegA, operand));
+}
+
+static inline void op_sbc(Sim6502 * cpu, uint8_t operand)
+{
+    set_add_sub_result(cpu, sbc_6502(cpu->FlagD, cpu->FlagC, cpu->RegA, operand));
+}
+
+#elif defined(CPU_65C02)
+
+// The 65C02 takes an extra clock cycle to fix the flags in decimal mode.
+
+static inline void op_adc(Sim6502 * cpu, uint8_t operand)
+{
+    if (cpu->FlagD)
+    {
+        bus_read(cpu, cpu->PC - 1);
+    }
+    set_add_sub_result(cpu, adc_65c02(cpu->FlagD, cpu->FlagC, cpu->RegA, operand));
+}
+
+static inline void op_sbc(Sim6502 * cpu, uint8_t operand)
+{
+    if (cpu->FlagD)
+    {
+        bus_read(cpu, cpu->PC - 1);
+    }
+    set_add_sub_result(cpu, sbc_65c02(cpu->FlagD, cpu->FlagC, cpu->RegA, operand));
+}
+
+#endif
+
+static inline void op_compare(Sim6502 * cpu, uint8_t reg, uint8_t operand)
+{
+    cpu->FlagC = reg >= operand;
+    set_nz(cpu, reg - operand);
+}
+
+static inline void op_bit(Sim6502 * cpu, uint8_t operand)
+{
+    cpu->FlagN = (operand & 0x80) != 0;
+    cpu->FlagV = (operand & 0x40) != 0;
+    cpu->FlagZ = (cpu->RegA & operand) == 0;
+}
+
+// The shift/rotate/increment/decrement operations are used both for the accumulator and for
+// read-modify-write instructions, so they return their result.
+
+static inline uint8_t op_asl(Sim6502 * cpu, uint8_t operand)
+{
+    cpu->FlagC = (operand & 0x80) != 0;
+    return set_nz(cpu, operand << 1);
+}
+
+static inline uint8_t op_lsr(Sim6502 * cpu, uint8_t operand)
+{
+    cpu->FlagC = (operand & 0x01) != 0;
+    return set_nz(cpu, operand >> 1);
+}
+
+static inline uint8_t op_rol(Sim6502 * cpu, uint8_t operand)
+{
+    const uint8_t result = (operand << 1) | cpu->FlagC;
+    cpu->FlagC = (operand & 0x80) != 0;
+    return set_nz(cpu, result);
+}
+
+static inline uint8_t op_ror(Sim6502 * cpu, uint8_t operand)
+{
+    const uint8_t result = (operand >> 1) | (cpu->FlagC << 7);
+    cpu->FlagC = (operand & 0x01) != 0;
+    return set_nz(cpu, result);
+}
+
+static inline uint8_t op_inc(Sim6502 * cpu, uint8_t operand)
+{
+    return set_nz(cpu, operand + 1);
+}
+
+static inline uint8_t op_dec(Sim6502 * cpu, uint8_t operand)
+{
+    return set_nz(cpu, operand - 1);
+}
+
+#if defined(CPU_6502)
+
+// The undocumented read-modify-write instructions combine a shift/rotate/increment/decrement
+// with an accumulator operation.
+
+static inline uint8_t op_slo(Sim6502 * cpu, uint8_t operand)
+{
+    const uint8_t result = op_asl(cpu, operand);
+    set_nz(cpu, cpu->RegA |= result);
+    return result;
+}
+
+static inline uint8_t op_rla(Sim6502 * cpu, uint8_t operand)
+{
+    const uint8_t result = op_rol(cpu, operand);
+    set_nz(cpu, cpu->RegA &= result);
+    return result;
+}
+
+static inline uint8_t op_sre(Sim6502 * cpu, uint8_t operand)
+{
+    const uint8_t result = op_lsr(cpu, operand);
+    set_nz(cpu, cpu->RegA ^= result);
+    return result;
+}
+
+static inline uint8_t op_rra(Sim6502 * cpu, uint8_t operand)
+{
+    const uint8_t result = op_ror(cpu, operand);
+    op_adc(cpu, result);
+    return result;
+}
+
+static inline uint8_t op_dcp(Sim6502 * cpu, uint8_t operand)
+{
+    const uint8_t result = operand - 1;
+    op_compare(cpu, cpu->RegA, result);
+    return result;
+}
+
+static inline uint8_t op_isc(Sim6502 * cpu, uint8_t operand)
+{
+    const uint8_t result = operand + 1;
+    op_sbc(cpu, result);
+    return result;
+}
+
+static inline void op_arr(Sim6502 * cpu, uint8_t operand)
+{
+    const uint8_t temp = cpu->RegA & operand;
+    uint8_t result = (temp >> 1) | (cpu->FlagC << 7);
+
+    if (!cpu->FlagD)
+    {
+        set_nz(cpu, result);
+        cpu->FlagC = (result & 0x40) != 0;
+        cpu->FlagV = ((result >> 6) ^ (result >> 5)) & 1;
+    }
+    else
+    {
+        // In decimal mode, the N and Z flags reflect the result before decimal correction,
+        // and both nibbles of the result are corrected based on the nibbles of 'temp'.
+        cpu->FlagN = cpu->FlagC;
+        cpu->FlagZ = result == 0;
+        cpu->FlagV = ((temp ^ result) & 0x40) != 0;
+        if ((temp & 0x0f) + (temp & 0x01) > 0x05)
+        {
+            result = (result & 0xf0) | ((result + 0x06) & 0x0f);
+        }
+        cpu->FlagC = (temp & 0xf0) + (temp & 0x10) > 0x50;
+        if (cpu->FlagC)
+        {
+            result += 0x60;
+        }
+    }
+
+    cpu->RegA = result;
+}
+
+#elif defined(CPU_65C02)
+
+static inline uint8_t op_tsb(Sim6502 * cpu, uint8_t operand)
+{
+    cpu->FlagZ = (cpu->RegA & operand) == 0;
+    return operand | cpu->RegA;
+}
+
+static inline uint8_t op_trb(Sim6502 * cpu, uint8_t operand)
+{
+    cpu->FlagZ = (cpu->RegA & operand) == 0;
+    return operand & ~cpu->RegA;
+}
+
+#define DEFINE_RMB_SMB(bit)                                                                         \
+    static inline uint8_t op_rmb##bit(Sim6502 * cpu, uint8_t operand)                              \
+    {                                                                                               \
+        (void)cpu;                                                                                  \
+        return operand & ~(1 << bit);                                                               \
+    }                                                                                               \
+    static inline uint8_t op_smb##bit(Sim6502 * cpu, uint8_t operand)                              \
+    {                                                                                               \
+        (void)cpu;                                                                                  \
+        return operand | (1 << bit);                                                                \
+    }
+
+DEFINE_RMB_SMB(0)
+DEFINE_RMB_SMB(1)
+DEFINE_RMB_SMB(2)
+DEFINE_RMB_SMB(3)
+DEFINE_RMB_SMB(4)
+DEFINE_RMB_SMB(5)
+DEFINE_RMB_SMB(6)
+DEFINE_RMB_SMB(7)
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                    INSTRUCTION TEMPLATES                                      //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef uint8_t (*rmw_operation)(Sim6502 * cpu, uint8_t operand);
+
+static inline void implied(Sim6502 * cpu)
+{
+    // Single-byte instructions read the byte following the opcode, and ignore it.
+    bus_read(cpu, cpu->PC);
+}
+
+static inline void read_modify_write(Sim6502 * cpu, uint16_t address, rmw_operation operation)
+{
+    const uint8_t operand = bus_read(cpu, address);
+#if defined(CPU_6502)
+    // The NMOS 6502 writes back the unmodified value before writing the modified value.
+    bus_write(cpu, address, operand);
+#elif defined(CPU_65C02)
+    // The 65C02 reads the operand a second time instead.
+    bus_read(cpu, address);
+#endif
+    bus_write(cpu, address, operation(cpu, operand));
+}
+
+static inline uint16_t am_abs_x_shift(Sim6502 * cpu)
+{
+    // The ASL/LSR/ROL/ROR abs,X instructions always take the extra cycle on the 6502.
+    // The 65C02 only takes it if the indexing crosses a page boundary.
+#if defined(CPU_6502)
+    return am_abs_indexed(cpu, cpu->RegX, true);
+#elif defined(CPU_65C02)
+    return am_abs_indexed(cpu, cpu->RegX, false);
+#endif
+}
+
+static inline void branch(Sim6502 * cpu, bool condition)
+{
+    const int8_t displacement = fetch(cpu);
+    if (condition)
+    {
+        const uint16_t target = cpu->PC + displacement;
+        bus_read(cpu, cpu->PC);
+        if ((target & 0xff00) != (cpu->PC & 0xff00))
+        {
+            bus_read(cpu, (cpu->PC & 0xff00) | (target & 0x00ff));
+        }
+        cpu->PC = target;
+    }
+}
+
+// The undocumented SHA, SHX, SHY and TAS instructions store a value that is ANDed with the
+// high byte of the base address plus one. If the indexing crosses a page boundary, the high
+// byte of the effective address is replaced by the value being stored.
+
+#if defined(CPU_6502)
+
+static inline void store_and_high_byte(Sim6502 * cpu, uint16_t base, uint8_t index, uint8_t value)
+{
+    const uint16_t address = indexed_address(cpu, base, index, true);
+    value &= (base >> 8) + 1;
+    if ((address & 0xff00) != (base & 0xff00))
+    {
+        bus_write(cpu, value * 0x100 + (address & 0x00ff), value);
+    }
+    else
+    {
+        bus_write(cpu, address, value);
+    }
+}
+
+#endif
+
+static inline uint16_t zpage_pointer(Sim6502 * cpu)
+{
+    const uint8_t pointer = fetch(cpu);
+    const uint8_t lo = bus_read(cpu, pointer);
+    const uint8_t hi = bus_read(cpu, (uint8_t)(pointer + 1));
+    return hi * 0x100 + lo;
+}
+
+#if defined(CPU_65C02)
+
+static inline void bit_branch(Sim6502 * cpu, uint8_t mask, bool branch_when_bit_set)
+{
+    const uint8_t operand = bus_read(cpu, am_zpage(cpu));
+    bus_read(cpu, cpu->PC - 1);
+    branch(cpu, ((operand & mask) != 0) == branch_when_bit_set);
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                               //
+//                                       PUBLIC FUNCTIONS                                        //
+//                                                                                               //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void sim_6502_reset(Sim6502 * cpu, uint8_t * memory)
+{
+    cpu->Memory     = memory;
+    cpu->PC         = 0;
+    cpu->RegA       = 0;
+    cpu->RegX       = 0;
+    cpu->RegY       = 0;
+    cpu->RegS       = 0xff;
+    cpu->FlagN      = false;
+    cpu->FlagV      = false;
+    cpu->FlagD      = false;
+    cpu->FlagI      = true;
+    cpu->FlagZ      = false;
+    cpu->FlagC      = false;
+    cpu->Halted     = false;
+    cpu->CycleCount = 0;
+
+    cpu->InstructionCount = 0;
+    cpu->Dispatch         = DispatchSwitch;
+    cpu->Trace            = NULL;
+}
+
+uint8_t sim_6502_get_p(const Sim6502 * cpu)
+{
+    // The B bit and the unused bit do not exist in the processor; they read as 1.
+    return cpu->FlagN << 7 | cpu->FlagV << 6 | 0x30 | cpu->FlagD << 3 | cpu->FlagI << 2 | cpu->FlagZ << 1 | cpu->FlagC;
+}
+
+void sim_6502_set_p(Sim6502 * cpu, uint8_t p)
+{
+    cpu->FlagN = (p & 0x80) != 0;
+    cpu->FlagV = (p & 0x40) != 0;
+    cpu->FlagD = (p & 0x08) != 0;
+    cpu->FlagI = (p & 0x04) != 0;
+    cpu->FlagZ = (p & 0x02) != 0;
+    cpu->FlagC = (p & 0x01) != 0;
+}
+
+void sim_6502_execute_instruction(Sim6502 * cpu)
+{
+    uint16_t address;
+    uint8_t lo, hi;
+
+    if (cpu->Halted)
+    {
+        return;
+    }
+
+    ++cpu->InstructionCount;
+
+#define OPCODE(opcode) case opcode:
+#define NEXT break
+
+    switch (fetch(cpu))
+    {
+#include "sim_6502_instructions.h"
+    }
+
+#undef OPCODE
+#undef NEXT
+}
+
+#if defined(__GNUC__)
+
+// Threaded dispatch, using the "labels as values" extension of GCC.
+//
+// Each instruction jumps directly to the implementation of the next instruction, rather than
+// returning to a single central dispatch point. This makes the indirect jumps much easier to
+// predict for the host processor. Pre-decoding the test code is not worthwhile, since the
+// test code changes between almost all measurements.
+
+static void execute_threaded(Sim6502 * cpu, unsigned long cycle_limit)
+{
+    static const void * const dispatch_table[256] = {
+        &&opcode_0x00, &&opcode_0x01, &&opcode_0x02, &&opcode_0x03, &&opcode_0x04, &&opcode_0x05, &&opcode_0x06, &&opcode_0x07, &&opcode_0x08, &&opcode_0x09, &&opcode_0x0a, &&opcode_0x0b, &&opcode_0x0c, &&opcode_0x0d, &&opcode_0x0e, &&opcode_0x0f,
+        &&opcode_0x10, &&opcode_0x11, &&opcode_0x12, &&opcode_0x13, &&opcode_0x14, &&opcode_0x15, &&opcode_0x16, &&opcode_0x17, &&opcode_0x18, &&opcode_0x19, &&opcode_0x1a, &&opcode_0x1b, &&opcode_0x1c, &&opcode_0x1d, &&opcode_0x1e, &&opcode_0x1f,
+        &&opcode_0x20, &&opcode_0x21, &&opcode_0x22, &&opcode_0x23, &&opcode_0x24, &&opcode_0x25, &&opcode_0x26, &&opcode_0x27, &&opcode_0x28, &&opcode_0x29, &&opcode_0x2a, &&opcode_0x2b, &&opcode_0x2c, &&opcode_0x2d, &&opcode_0x2e, &&opcode_0x2f,
+        &&opcode_0x30, &&opcode_0x31, &&opcode_0x32, &&opcode_0x33, &&opcode_0x34, &&opcode_0x35, &&opcode_0x36, &&opcode_0x37, &&opcode_0x38, &&opcode_0x39, &&opcode_0x3a, &&opcode_0x3b, &&opcode_0x3c, &&opcode_0x3d, &&opcode_0x3e, &&opcode_0x3f,
+        &&opcode_0x40, &&opcode_0x41, &&opcode_0x42, &&opcode_0x43, &&opcode_0x44, &&opcode_0x45, &&opcode_0x46, &&opcode_0x47, &&opcode_0x48, &&opcode_0x49, &&opcode_0x4a, &&opcode_0x4b, &&opcode_0x4c, &&opcode_0x4d, &&opcode_0x4e, &&opcode_0x4f,
+        &&opcode_0x50, &&opcode_0x51, &&opcode_0x52, &&opcode_0x53, &&opcode_0x54, &&opcode_0x55, &&opcode_0x56, &&opcode_0x57, &&opcode_0x58, &&opcode_0x59, &&opcode_0x5a, &&opcode_0x5b, &&opcode_0x5c, &&opcode_0x5d, &&opcode_0x5e, &&opcode_0x5f,
+        &&opcode_0x60, &&opcode_0x61, &&opcode_0x62, &&opcode_0x63, &&opcode_0x64, &&opcode_0x65, &&opcode_0x66, &&opcode_0x67, &&opcode_0x68, &&opcode_0x69, &&opcode_0x6a, &&opcode_0x6b, &&opcode_0x6c, &&opcode_0x6d, &&opcode_0x6e, &&opcode_0x6f,
+        &&opcode_0x70, &&opcode_0x71, &&opcode_0x72, &&opcode_0x73, &&opcode_0x74, &&opcode_0x75, &&opcode_0x76, &&opcode_0x77, &&opcode_0x78, &&opcode_0x79, &&opcode_0x7a, &&opcode_0x7b, &&opcode_0x7c, &&opcode_0x7d, &&opcode_0x7e, &&opcode_0x7f,
+        &&opcode_0x80, &&opcode_0x81, &&opcode_0x82, &&opcode_0x83, &&opcode_0x84, &&opcode_0x85, &&opcode_0x86, &&opcode_0x87, &&opcode_0x88, &&opcode_0x89, &&opcode_0x8a, &&opcode_0x8b, &&opcode_0x8c, &&opcode_0x8d, &&opcode_0x8e, &&opcode_0x8f,
+        &&opcode_0x90, &&opcode_0x91, &&opcode_0x92, &&opcode_0x93, &&opcode_0x94, &&opcode_0x95, &&opcode_0x96, &&opcode_0x97, &&opcode_0x98, &&opcode_0x99, &&opcode_0x9a, &&opcode_0x9b, &&opcode_0x9c, &&opcode_0x9d, &&opcode_0x9e, &&opcode_0x9f,
+        &&opcode_0xa0, &&opcode_0xa1, &&opcode_0xa2, &&opcode_0xa3, &&opcode_0xa4, &&opcode_0xa5, &&opcode_0xa6, &&opcode_0xa7, &&opcode_0xa8, &&opcode_0xa9, &&opcode_0xaa, &&opcode_0xab, &&opcode_0xac, &&opcode_0xad, &&opcode_0xae, &&opcode_0xaf,
+        &&opcode_0xb0, &&opcode_0xb1, &&opcode_0xb2, &&opcode_0xb3, &&opcode_0xb4, &&opcode_0xb5, &&opcode_0xb6, &&opcode_0xb7, &&opcode_0xb8, &&opcode_0xb9, &&opcode_0xba, &&opcode_0xbb, &&opcode_0xbc, &&opcode_0xbd, &&opcode_0xbe, &&opcode_0xbf,
+        &&opcode_0xc0, &&opcode_0xc1, &&opcode_0xc2, &&opcode_0xc3, &&opcode_0xc4, &&opcode_0xc5, &&opcode_0xc6, &&opcode_0xc7, &&opcode_0xc8, &&opcode_0xc9, &&opcode_0xca, &&opcode_0xcb, &&opcode_0xcc, &&opcode_0xcd, &&opcode_0xce, &&opcode_0xcf,
+        &&opcode_0xd0, &&opcode_0xd1, &&opcode_0xd2, &&opcode_0xd3, &&opcode_0xd4, &&opcode_0xd5, &&opcode_0xd6, &&opcode_0xd7, &&opcode_0xd8, &&opcode_0xd9, &&opcode_0xda, &&opcode_0xdb, &&opcode_0xdc, &&opcode_0xdd, &&opcode_0xde, &&opcode_0xdf,
+        &&opcode_0xe0, &&opcode_0xe1, &&opcode_0xe2, &&opcode_0xe3, &&opcode_0xe4, &&opcode_0xe5, &&opcode_0xe6, &&opcode_0xe7, &&opcode_0xe8, &&opcode_0xe9, &&opcode_0xea, &&opcode_0xeb, &&opcode_0xec, &&opcode_0xed, &&opcode_0xee, &&opcode_0xef,
+        &&opcode_0xf0, &&opcode_0xf1, &&opcode_0xf2, &&opcode_0xf3, &&opcode_0xf4, &&opcode_0xf5, &&opcode_0xf6, &&opcode_0xf7, &&opcode_0xf8, &&opcode_0xf9, &&opcode_0xfa, &&opcode_0xfb, &&opcode_0xfc, &&opcode_0xfd, &&opcode_0xfe, &&opcode_0xff
+    };
+
+    uint16_t address;
+    uint8_t lo, hi;
+
+#define OPCODE(opcode) opcode_##opcode:
+#define NEXT                                                                                            \
+    do {                                                                                                \
+        if (cpu->PC == SIM_6502_RETURN_ADDRESS || cpu->Halted || cpu->CycleCount > cycle_limit)         \
+        {                                                                                               \
+            return;                                                                                     \
+        }                                                                                               \
+        ++cpu->InstructionCount;                                                                        \
+        goto *dispatch_table[fetch(cpu)];                                                               \
+    } while (0)
+
+    NEXT;
+
+#include "sim_6502_instructions.h"
+
+#undef OPCODE
+#undef NEXT
+}
+
+#endif
+
+int sim_6502_run_subroutine(Sim6502 * cpu, uint16_t entry, unsigned max_cycles)
+{
+    // Execute a subroutine as if it was called from SIM_6502_RETURN_ADDRESS - 3 by a JSR instruction.
+    //
+    // The return value is the number of clock cycles taken by the subroutine, not counting the
+    // final RTS instruction, or -1 if the subroutine did not return within the given number
+    // of clock cycles.
+
+    const uint16_t return_address = SIM_6502_RETURN_ADDRESS - 1;
+    unsigned long start_cycle_count;
+
+    cpu->Memory[0x100 + cpu->RegS--] = return_address >> 8;
+    cpu->Memory[0x100 + cpu->RegS--] = return_address & 0xff;
+
+    cpu->PC = entry;
+    cpu->Halted = false;
+
+    start_cycle_count = cpu->CycleCount;
+
+#if defined(__GNUC__)
+    if (cpu->Dispatch == DispatchThreaded)
+    {
+        execute_threaded(cpu, start_cycle_count + max_cycles);
+    }
+    else
+#endif
+    {
+        while (cpu->PC != SIM_6502_RETURN_ADDRESS && !cpu->Halted && cpu->CycleCount - start_cycle_count <= max_cycles)
+        {
+            sim_6502_execute_instruction(cpu);
+        }
+    }
+
+    if (cpu->PC != SIM_6502_RETURN_ADDRESS)
+    {
+        return -1;
+    }
+
+    // Do not count the 6 clock cycles of the final RTS instruction.
+
+    return cpu->CycleCount - start_cycle_count - 6;
+}
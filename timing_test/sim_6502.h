@@ -0,0 +1,76 @@
+////////////////
+// sim_6502.h //
+////////////////
+
+// A bus-cycle accurate 6502/65C02 simulator for use on the host.
+//
+// Every clock cycle of the simulated processor performs exactly one bus access (read or write),
+// including the "dummy" accesses that the real processor does while it is busy with address
+// calculations. The number of clock cycles taken by a piece of code is therefore simply the
+// number of bus accesses it performs.
+
+#ifndef SIM_6502_H
+#define SIM_6502_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The address the simulated processor returns to when sim_6502_run_subroutine() is done.
+// It should not be used by the code being executed.
+
+#define SIM_6502_RETURN_ADDRESS 0xfff0
+
+// The simulator can dispatch instructions through a switch statement, or (when compiled with GCC)
+// through threaded dispatch, which is faster.
+
+typedef enum {
+    DispatchSwitch,
+    DispatchThreaded
+} Sim6502Dispatch;
+
+// Optionally, the simulator records the most recent bus cycles in a ring buffer.
+// Bus cycle n is stored at index (n % SIM_6502_TRACE_SIZE), where n is the value of CycleCount
+// before the access.
+
+#define SIM_6502_TRACE_SIZE 256 // Must be a power of two.
+
+typedef struct {
+    uint16_t Address;
+    uint8_t  Data;
+    bool     Write;
+} Sim6502BusCycle;
+
+typedef struct {
+    Sim6502BusCycle Cycles[SIM_6502_TRACE_SIZE];
+} Sim6502Trace;
+
+typedef struct {
+    uint8_t *       Memory;           // Flat 64 KB guest memory image.
+    uint16_t        PC;
+    uint8_t         RegA;
+    uint8_t         RegX;
+    uint8_t         RegY;
+    uint8_t         RegS;
+    bool            FlagN;
+    bool            FlagV;
+    bool            FlagD;
+    bool            FlagI;
+    bool            FlagZ;
+    bool            FlagC;
+    bool            Halted;           // Set when a JAM, WAI, or STP instruction is executed.
+    unsigned long   CycleCount;
+    unsigned long   InstructionCount;
+    Sim6502Dispatch Dispatch;         // Used by sim_6502_run_subroutine().
+    Sim6502Trace *  Trace;            // Bus cycle trace buffer, or NULL if tracing is disabled.
+} Sim6502;
+
+void sim_6502_reset(Sim6502 * cpu, uint8_t * memory);
+
+uint8_t sim_6502_get_p(const Sim6502 * cpu);
+void sim_6502_set_p(Sim6502 * cpu, uint8_t p);
+
+void sim_6502_execute_instruction(Sim6502 * cpu);
+
+int sim_6502_run_subroutine(Sim6502 * cpu, uint16_t entry, unsigned max_cycles);
+
+#endif
@@ -0,0 +1,553 @@
+/////////////////////////////
+// sim_6502_instructions.h //
+/////////////////////////////
+
+// The instruction implementations of the simulator.
+//
+// This file is included twice by 'sim_6502.c': once as the body of a switch statement, and
+// once as the body of a function that uses threaded dispatch. Before including it, the
+// OPCODE(opcode) macro must be defined to produce a label for the given opcode, and the NEXT
+// macro must be defined to proceed to the next instruction.
+//
+// The local variables 'address', 'lo', and 'hi' are available as scratch variables.
+
+// Loads.
+
+OPCODE(0xa9) set_nz(cpu, cpu->RegA = fetch(cpu)); NEXT;                                             // LDA #imm
+OPCODE(0xa5) set_nz(cpu, cpu->RegA = bus_read(cpu, am_zpage(cpu))); NEXT;                           // LDA zp
+OPCODE(0xb5) set_nz(cpu, cpu->RegA = bus_read(cpu, am_zpage_indexed(cpu, cpu->RegX))); NEXT;        // LDA zp,X
+OPCODE(0xad) set_nz(cpu, cpu->RegA = bus_read(cpu, am_abs(cpu))); NEXT;                             // LDA abs
+OPCODE(0xbd) set_nz(cpu, cpu->RegA = bus_read(cpu, am_abs_indexed(cpu, cpu->RegX, false))); NEXT;   // LDA abs,X
+OPCODE(0xb9) set_nz(cpu, cpu->RegA = bus_read(cpu, am_abs_indexed(cpu, cpu->RegY, false))); NEXT;   // LDA abs,Y
+OPCODE(0xa1) set_nz(cpu, cpu->RegA = bus_read(cpu, am_zpage_x_indirect(cpu))); NEXT;                // LDA (zp,X)
+OPCODE(0xb1) set_nz(cpu, cpu->RegA = bus_read(cpu, am_zpage_indirect_y(cpu, false))); NEXT;         // LDA (zp),Y
+
+OPCODE(0xa2) set_nz(cpu, cpu->RegX = fetch(cpu)); NEXT;                                             // LDX #imm
+OPCODE(0xa6) set_nz(cpu, cpu->RegX = bus_read(cpu, am_zpage(cpu))); NEXT;                           // LDX zp
+OPCODE(0xb6) set_nz(cpu, cpu->RegX = bus_read(cpu, am_zpage_indexed(cpu, cpu->RegY))); NEXT;        // LDX zp,Y
+OPCODE(0xae) set_nz(cpu, cpu->RegX = bus_read(cpu, am_abs(cpu))); NEXT;                             // LDX abs
+OPCODE(0xbe) set_nz(cpu, cpu->RegX = bus_read(cpu, am_abs_indexed(cpu, cpu->RegY, false))); NEXT;   // LDX abs,Y
+
+OPCODE(0xa0) set_nz(cpu, cpu->RegY = fetch(cpu)); NEXT;                                             // LDY #imm
+OPCODE(0xa4) set_nz(cpu, cpu->RegY = bus_read(cpu, am_zpage(cpu))); NEXT;                           // LDY zp
+OPCODE(0xb4) set_nz(cpu, cpu->RegY = bus_read(cpu, am_zpage_indexed(cpu, cpu->RegX))); NEXT;        // LDY zp,X
+OPCODE(0xac) set_nz(cpu, cpu->RegY = bus_read(cpu, am_abs(cpu))); NEXT;                             // LDY abs
+OPCODE(0xbc) set_nz(cpu, cpu->RegY = bus_read(cpu, am_abs_indexed(cpu, cpu->RegX, false))); NEXT;   // LDY abs,X
+
+// Stores.
+
+OPCODE(0x85) bus_write(cpu, am_zpage(cpu), cpu->RegA); NEXT;                                        // STA zp
+OPCODE(0x95) bus_write(cpu, am_zpage_indexed(cpu, cpu->RegX), cpu->RegA); NEXT;                     // STA zp,X
+OPCODE(0x8d) bus_write(cpu, am_abs(cpu), cpu->RegA); NEXT;                                          // STA abs
+OPCODE(0x9d) bus_write(cpu, am_abs_indexed(cpu, cpu->RegX, true), cpu->RegA); NEXT;                 // STA abs,X
+OPCODE(0x99) bus_write(cpu, am_abs_indexed(cpu, cpu->RegY, true), cpu->RegA); NEXT;                 // STA abs,Y
+OPCODE(0x81) bus_write(cpu, am_zpage_x_indirect(cpu), cpu->RegA); NEXT;                             // STA (zp,X)
+OPCODE(0x91) bus_write(cpu, am_zpage_indirect_y(cpu, true), cpu->RegA); NEXT;                       // STA (zp),Y
+
+OPCODE(0x86) bus_write(cpu, am_zpage(cpu), cpu->RegX); NEXT;                                        // STX zp
+OPCODE(0x96) bus_write(cpu, am_zpage_indexed(cpu, cpu->RegY), cpu->RegX); NEXT;                     // STX zp,Y
+OPCODE(0x8e) bus_write(cpu, am_abs(cpu), cpu->RegX); NEXT;                                          // STX abs
+
+OPCODE(0x84) bus_write(cpu, am_zpage(cpu), cpu->RegY); NEXT;                                        // STY zp
+OPCODE(0x94) bus_write(cpu, am_zpage_indexed(cpu, cpu->RegX), cpu->RegY); NEXT;                     // STY zp,X
+OPCODE(0x8c) bus_write(cpu, am_abs(cpu), cpu->RegY); NEXT;                                          // STY abs
+
+// Accumulator operations.
+
+OPCODE(0x09) set_nz(cpu, cpu->RegA |= fetch(cpu)); NEXT;                                            // ORA #imm
+OPCODE(0x05) set_nz(cpu, cpu->RegA |= bus_read(cpu, am_zpage(cpu))); NEXT;                          // ORA zp
+OPCODE(0x15) set_nz(cpu, cpu->RegA |= bus_read(cpu, am_zpage_indexed(cpu, cpu->RegX))); NEXT;       // ORA zp,X
+OPCODE(0x0d) set_nz(cpu, cpu->RegA |= bus_read(cpu, am_abs(cpu))); NEXT;                            // ORA abs
+OPCODE(0x1d) set_nz(cpu, cpu->RegA |= bus_read(cpu, am_abs_indexed(cpu, cpu->RegX, false))); NEXT;  // ORA abs,X
+OPCODE(0x19) set_nz(cpu, cpu->RegA |= bus_read(cpu, am_abs_indexed(cpu, cpu->RegY, false))); NEXT;  // ORA abs,Y
+OPCODE(0x01) set_nz(cpu, cpu->RegA |= bus_read(cpu, am_zpage_x_indirect(cpu))); NEXT;               // ORA (zp,X)
+OPCODE(0x11) set_nz(cpu, cpu->RegA |= bus_read(cpu, am_zpage_indirect_y(cpu, false))); NEXT;        // ORA (zp),Y
+
+OPCODE(0x29) set_nz(cpu, cpu->RegA &= fetch(cpu)); NEXT;                                            // AND #imm
+OPCODE(0x25) set_nz(cpu, cpu->RegA &= bus_read(cpu, am_zpage(cpu))); NEXT;                          // AND zp
+OPCODE(0x35) set_nz(cpu, cpu->RegA &= bus_read(cpu, am_zpage_indexed(cpu, cpu->RegX))); NEXT;       // AND zp,X
+OPCODE(0x2d) set_nz(cpu, cpu->RegA &= bus_read(cpu, am_abs(cpu))); NEXT;                            // AND abs
+OPCODE(0x3d) set_nz(cpu, cpu->RegA &= bus_read(cpu, am_abs_indexed(cpu, cpu->RegX, false))); NEXT;  // AND abs,X
+OPCODE(0x39) set_nz(cpu, cpu->RegA &= bus_read(cpu, am_abs_indexed(cpu, cpu->RegY, false))); NEXT;  // AND abs,Y
+OPCODE(0x21) set_nz(cpu, cpu->RegA &= bus_read(cpu, am_zpage_x_indirect(cpu))); NEXT;               // AND (zp,X)
+OPCODE(0x31) set_nz(cpu, cpu->RegA &= bus_read(cpu, am_zpage_indirect_y(cpu, false))); NEXT;        // AND (zp),Y
+
+OPCODE(0x49) set_nz(cpu, cpu->RegA ^= fetch(cpu)); NEXT;                                            // EOR #imm
+OPCODE(0x45) set_nz(cpu, cpu->RegA ^= bus_read(cpu, am_zpage(cpu))); NEXT;                          // EOR zp
+OPCODE(0x55) set_nz(cpu, cpu->RegA ^= bus_read(cpu, am_zpage_indexed(cpu, cpu->RegX))); NEXT;       // EOR zp,X
+OPCODE(0x4d) set_nz(cpu, cpu->RegA ^= bus_read(cpu, am_abs(cpu))); NEXT;                            // EOR abs
+OPCODE(0x5d) set_nz(cpu, cpu->RegA ^= bus_read(cpu, am_abs_indexed(cpu, cpu->RegX, false))); NEXT;  // EOR abs,X
+OPCODE(0x59) set_nz(cpu, cpu->RegA ^= bus_read(cpu, am_abs_indexed(cpu, cpu->RegY, false))); NEXT;  // EOR abs,Y
+OPCODE(0x41) set_nz(cpu, cpu->RegA ^= bus_read(cpu, am_zpage_x_indirect(cpu))); NEXT;               // EOR (zp,X)
+OPCODE(0x51) set_nz(cpu, cpu->RegA ^= bus_read(cpu, am_zpage_indirect_y(cpu, false))); NEXT;        // EOR (zp),Y
+
+OPCODE(0x69) op_adc(cpu, fetch(cpu)); NEXT;                                                         // ADC #imm
+OPCODE(0x65) op_adc(cpu, bus_read(cpu, am_zpage(cpu))); NEXT;                                       // ADC zp
+OPCODE(0x75) op_adc(cpu, bus_read(cpu, am_zpage_indexed(cpu, cpu->RegX))); NEXT;                    // ADC zp,X
+OPCODE(0x6d) op_adc(cpu, bus_read(cpu, am_abs(cpu))); NEXT;                                         // ADC abs
+OPCODE(0x7d) op_adc(cpu, bus_read(cpu, am_abs_indexed(cpu, cpu->RegX, false))); NEXT;               // ADC abs,X
+OPCODE(0x79) op_adc(cpu, bus_read(cpu, am_abs_indexed(cpu, cpu->RegY, false))); NEXT;               // ADC abs,Y
+OPCODE(0x61) op_adc(cpu, bus_read(cpu, am_zpage_x_indirect(cpu))); NEXT;                            // ADC (zp,X)
+OPCODE(0x71) op_adc(cpu, bus_read(cpu, am_zpage_indirect_y(cpu, false))); NEXT;                     // ADC (zp),Y
+
+OPCODE(0xe9) op_sbc(cpu, fetch(cpu)); NEXT;                                                         // SBC #imm
+OPCODE(0xe5) op_sbc(cpu, bus_read(cpu, am_zpage(cpu))); NEXT;                                       // SBC zp
+OPCODE(0xf5) op_sbc(cpu, bus_read(cpu, am_zpage_indexed(cpu, cpu->RegX))); NEXT;                    // SBC zp,X
+OPCODE(0xed) op_sbc(cpu, bus_read(cpu, am_abs(cpu))); NEXT;                                         // SBC abs
+OPCODE(0xfd) op_sbc(cpu, bus_read(cpu, am_abs_indexed(cpu, cpu->RegX, false))); NEXT;               // SBC abs,X
+OPCODE(0xf9) op_sbc(cpu, bus_read(cpu, am_abs_indexed(cpu, cpu->RegY, false))); NEXT;               // SBC abs,Y
+OPCODE(0xe1) op_sbc(cpu, bus_read(cpu, am_zpage_x_indirect(cpu))); NEXT;                            // SBC (zp,X)
+OPCODE(0xf1) op_sbc(cpu, bus_read(cpu, am_zpage_indirect_y(cpu, false))); NEXT;                     // SBC (zp),Y
+
+OPCODE(0xc9) op_compare(cpu, cpu->RegA, fetch(cpu)); NEXT;                                          // CMP #imm
+OPCODE(0xc5) op_compare(cpu, cpu->RegA, bus_read(cpu, am_zpage(cpu))); NEXT;                        // CMP zp
+OPCODE(0xd5) op_compare(cpu, cpu->RegA, bus_read(cpu, am_zpage_indexed(cpu, cpu->RegX))); NEXT;     // CMP zp,X
+OPCODE(0xcd) op_compare(cpu, cpu->RegA, bus_read(cpu, am_abs(cpu))); NEXT;                          // CMP abs
+OPCODE(0xdd) op_compare(cpu, cpu->RegA, bus_read(cpu, am_abs_indexed(cpu, cpu->RegX, false))); NEXT;// CMP abs,X
+OPCODE(0xd9) op_compare(cpu, cpu->RegA, bus_read(cpu, am_abs_indexed(cpu, cpu->RegY, false))); NEXT;// CMP abs,Y
+OPCODE(0xc1) op_compare(cpu, cpu->RegA, bus_read(cpu, am_zpage_x_indirect(cpu))); NEXT;             // CMP (zp,X)
+OPCODE(0xd1) op_compare(cpu, cpu->RegA, bus_read(cpu, am_zpage_indirect_y(cpu, false))); NEXT;      // CMP (zp),Y
+
+OPCODE(0xe0) op_compare(cpu, cpu->RegX, fetch(cpu)); NEXT;                                          // CPX #imm
+OPCODE(0xe4) op_compare(cpu, cpu->RegX, bus_read(cpu, am_zpage(cpu))); NEXT;                        // CPX zp
+OPCODE(0xec) op_compare(cpu, cpu->RegX, bus_read(cpu, am_abs(cpu))); NEXT;                          // CPX abs
+
+OPCODE(0xc0) op_compare(cpu, cpu->RegY, fetch(cpu)); NEXT;                                          // CPY #imm
+OPCODE(0xc4) op_compare(cpu, cpu->RegY, bus_read(cpu, am_zpage(cpu))); NEXT;                        // CPY zp
+OPCODE(0xcc) op_compare(cpu, cpu->RegY, bus_read(cpu, am_abs(cpu))); NEXT;                          // CPY abs
+
+OPCODE(0x24) op_bit(cpu, bus_read(cpu, am_zpage(cpu))); NEXT;                                       // BIT zp
+OPCODE(0x2c) op_bit(cpu, bus_read(cpu, am_abs(cpu))); NEXT;                                         // BIT abs
+
+// Shifts, rotates, increments and decrements.
+
+OPCODE(0x0a) implied(cpu); cpu->RegA = op_asl(cpu, cpu->RegA); NEXT;                                // ASL A
+OPCODE(0x06) read_modify_write(cpu, am_zpage(cpu), op_asl); NEXT;                                   // ASL zp
+OPCODE(0x16) read_modify_write(cpu, am_zpage_indexed(cpu, cpu->RegX), op_asl); NEXT;                // ASL zp,X
+OPCODE(0x0e) read_modify_write(cpu, am_abs(cpu), op_asl); NEXT;                                     // ASL abs
+OPCODE(0x1e) read_modify_write(cpu, am_abs_x_shift(cpu), op_asl); NEXT;                             // ASL abs,X
+
+OPCODE(0x4a) implied(cpu); cpu->RegA = op_lsr(cpu, cpu->RegA); NEXT;                                // LSR A
+OPCODE(0x46) read_modify_write(cpu, am_zpage(cpu), op_lsr); NEXT;                                   // LSR zp
+OPCODE(0x56) read_modify_write(cpu, am_zpage_indexed(cpu, cpu->RegX), op_lsr); NEXT;                // LSR zp,X
+OPCODE(0x4e) read_modify_write(cpu, am_abs(cpu), op_lsr); NEXT;                                     // LSR abs
+OPCODE(0x5e) read_modify_write(cpu, am_abs_x_shift(cpu), op_lsr); NEXT;                             // LSR abs,X
+
+OPCODE(0x2a) implied(cpu); cpu->RegA = op_rol(cpu, cpu->RegA); NEXT;                                // ROL A
+OPCODE(0x26) read_modify_write(cpu, am_zpage(cpu), op_rol); NEXT;                                   // ROL zp
+OPCODE(0x36) read_modify_write(cpu, am_zpage_indexed(cpu, cpu->RegX), op_rol); NEXT;                // ROL zp,X
+OPCODE(0x2e) read_modify_write(cpu, am_abs(cpu), op_rol); NEXT;                                     // ROL abs
+OPCODE(0x3e) read_modify_write(cpu, am_abs_x_shift(cpu), op_rol); NEXT;                             // ROL abs,X
+
+OPCODE(0x6a) implied(cpu); cpu->RegA = op_ror(cpu, cpu->RegA); NEXT;                                // ROR A
+OPCODE(0x66) read_modify_write(cpu, am_zpage(cpu), op_ror); NEXT;                                   // ROR zp
+OPCODE(0x76) read_modify_write(cpu, am_zpage_indexed(cpu, cpu->RegX), op_ror); NEXT;                // ROR zp,X
+OPCODE(0x6e) read_modify_write(cpu, am_abs(cpu), op_ror); NEXT;                                     // ROR abs
+OPCODE(0x7e) read_modify_write(cpu, am_abs_x_shift(cpu), op_ror); NEXT;                             // ROR abs,X
+
+OPCODE(0xe6) read_modify_write(cpu, am_zpage(cpu), op_inc); NEXT;                                   // INC zp
+OPCODE(0xf6) read_modify_write(cpu, am_zpage_indexed(cpu, cpu->RegX), op_inc); NEXT;                // INC zp,X
+OPCODE(0xee) read_modify_write(cpu, am_abs(cpu), op_inc); NEXT;                                     // INC abs
+OPCODE(0xfe) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegX, true), op_inc); NEXT;            // INC abs,X
+
+OPCODE(0xc6) read_modify_write(cpu, am_zpage(cpu), op_dec); NEXT;                                   // DEC zp
+OPCODE(0xd6) read_modify_write(cpu, am_zpage_indexed(cpu, cpu->RegX), op_dec); NEXT;                // DEC zp,X
+OPCODE(0xce) read_modify_write(cpu, am_abs(cpu), op_dec); NEXT;                                     // DEC abs
+OPCODE(0xde) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegX, true), op_dec); NEXT;            // DEC abs,X
+
+OPCODE(0xe8) implied(cpu); set_nz(cpu, ++cpu->RegX); NEXT;                                          // INX
+OPCODE(0xc8) implied(cpu); set_nz(cpu, ++cpu->RegY); NEXT;                                          // INY
+OPCODE(0xca) implied(cpu); set_nz(cpu, --cpu->RegX); NEXT;                                          // DEX
+OPCODE(0x88) implied(cpu); set_nz(cpu, --cpu->RegY); NEXT;                                          // DEY
+
+// Register transfers.
+
+OPCODE(0xaa) implied(cpu); set_nz(cpu, cpu->RegX = cpu->RegA); NEXT;                                // TAX
+OPCODE(0xa8) implied(cpu); set_nz(cpu, cpu->RegY = cpu->RegA); NEXT;                                // TAY
+OPCODE(0x8a) implied(cpu); set_nz(cpu, cpu->RegA = cpu->RegX); NEXT;                                // TXA
+OPCODE(0x98) implied(cpu); set_nz(cpu, cpu->RegA = cpu->RegY); NEXT;                                // TYA
+OPCODE(0xba) implied(cpu); set_nz(cpu, cpu->RegX = cpu->RegS); NEXT;                                // TSX
+OPCODE(0x9a) implied(cpu); cpu->RegS = cpu->RegX; NEXT;                                             // TXS
+
+// Flag instructions.
+
+OPCODE(0x18) implied(cpu); cpu->FlagC = false; NEXT;                                                // CLC
+OPCODE(0x38) implied(cpu); cpu->FlagC = true; NEXT;                                                 // SEC
+OPCODE(0x58) implied(cpu); cpu->FlagI = false; NEXT;                                                // CLI
+OPCODE(0x78) implied(cpu); cpu->FlagI = true; NEXT;                                                 // SEI
+OPCODE(0xb8) implied(cpu); cpu->FlagV = false; NEXT;                                                // CLV
+OPCODE(0xd8) implied(cpu); cpu->FlagD = false; NEXT;                                                // CLD
+OPCODE(0xf8) implied(cpu); cpu->FlagD = true; NEXT;                                                 // SED
+
+// Stack instructions.
+
+OPCODE(0x48) implied(cpu); push(cpu, cpu->RegA); NEXT;                                              // PHA
+OPCODE(0x08) implied(cpu); push(cpu, sim_6502_get_p(cpu)); NEXT;                                    // PHP
+
+OPCODE(0x68)                                                                                        // PLA
+    implied(cpu);
+    bus_read(cpu, 0x100 + cpu->RegS);
+    set_nz(cpu, cpu->RegA = pull(cpu));
+    NEXT;
+
+OPCODE(0x28)                                                                                        // PLP
+    implied(cpu);
+    bus_read(cpu, 0x100 + cpu->RegS);
+    sim_6502_set_p(cpu, pull(cpu));
+    NEXT;
+
+// Branches.
+
+OPCODE(0x10) branch(cpu, !cpu->FlagN); NEXT;                                                        // BPL
+OPCODE(0x30) branch(cpu,  cpu->FlagN); NEXT;                                                        // BMI
+OPCODE(0x50) branch(cpu, !cpu->FlagV); NEXT;                                                        // BVC
+OPCODE(0x70) branch(cpu,  cpu->FlagV); NEXT;                                                        // BVS
+OPCODE(0x90) branch(cpu, !cpu->FlagC); NEXT;                                                        // BCC
+OPCODE(0xb0) branch(cpu,  cpu->FlagC); NEXT;                                                        // BCS
+OPCODE(0xd0) branch(cpu, !cpu->FlagZ); NEXT;                                                        // BNE
+OPCODE(0xf0) branch(cpu,  cpu->FlagZ); NEXT;                                                        // BEQ
+
+// Jumps, subroutines, and interrupts.
+
+OPCODE(0x4c)                                                                                        // JMP abs
+    cpu->PC = am_abs(cpu);
+    NEXT;
+
+OPCODE(0x6c)                                                                                        // JMP (ind)
+    address = am_abs(cpu);
+#if defined(CPU_6502)
+    lo = bus_read(cpu, address);
+    // The 6502 does not carry into the high byte of the pointer address.
+    hi = bus_read(cpu, (address & 0xff00) | ((address + 1) & 0x00ff));
+#elif defined(CPU_65C02)
+    // The 65C02 fixes the page-wrap bug of the 6502, at the cost of an extra clock cycle.
+    bus_read(cpu, cpu->PC - 1);
+    lo = bus_read(cpu, address);
+    hi = bus_read(cpu, address + 1);
+#endif
+    cpu->PC = hi * 0x100 + lo;
+    NEXT;
+
+OPCODE(0x20)                                                                                        // JSR abs
+    lo = fetch(cpu);
+    bus_read(cpu, 0x100 + cpu->RegS);
+    push(cpu, cpu->PC >> 8);
+    push(cpu, cpu->PC & 0xff);
+    hi = fetch(cpu);
+    cpu->PC = hi * 0x100 + lo;
+    NEXT;
+
+OPCODE(0x60)                                                                                        // RTS
+    implied(cpu);
+    bus_read(cpu, 0x100 + cpu->RegS);
+    lo = pull(cpu);
+    hi = pull(cpu);
+    cpu->PC = hi * 0x100 + lo;
+    fetch(cpu);
+    NEXT;
+
+OPCODE(0x00)                                                                                        // BRK
+    fetch(cpu);
+    push(cpu, cpu->PC >> 8);
+    push(cpu, cpu->PC & 0xff);
+    push(cpu, sim_6502_get_p(cpu));
+    cpu->FlagI = true;
+#if defined(CPU_65C02)
+    cpu->FlagD = false;
+#endif
+    lo = bus_read(cpu, 0xfffe);
+    hi = bus_read(cpu, 0xffff);
+    cpu->PC = hi * 0x100 + lo;
+    NEXT;
+
+OPCODE(0x40)                                                                                        // RTI
+    implied(cpu);
+    bus_read(cpu, 0x100 + cpu->RegS);
+    sim_6502_set_p(cpu, pull(cpu));
+    lo = pull(cpu);
+    hi = pull(cpu);
+    cpu->PC = hi * 0x100 + lo;
+    NEXT;
+
+// Documented NOP.
+
+OPCODE(0xea) implied(cpu); NEXT;                                                                    // NOP
+
+#if defined(CPU_6502)
+
+// Undocumented NOPs.
+
+OPCODE(0x1a) OPCODE(0x3a) OPCODE(0x5a) OPCODE(0x7a) OPCODE(0xda) OPCODE(0xfa)                       // NOP
+    implied(cpu);
+    NEXT;
+
+OPCODE(0x80) OPCODE(0x82) OPCODE(0x89) OPCODE(0xc2) OPCODE(0xe2)                                    // NOP #imm
+    fetch(cpu);
+    NEXT;
+
+OPCODE(0x04) OPCODE(0x44) OPCODE(0x64)                                                              // NOP zp
+    bus_read(cpu, am_zpage(cpu));
+    NEXT;
+
+OPCODE(0x14) OPCODE(0x34) OPCODE(0x54) OPCODE(0x74) OPCODE(0xd4) OPCODE(0xf4)                       // NOP zp,X
+    bus_read(cpu, am_zpage_indexed(cpu, cpu->RegX));
+    NEXT;
+
+OPCODE(0x0c)                                                                                        // NOP abs
+    bus_read(cpu, am_abs(cpu));
+    NEXT;
+
+OPCODE(0x1c) OPCODE(0x3c) OPCODE(0x5c) OPCODE(0x7c) OPCODE(0xdc) OPCODE(0xfc)                       // NOP abs,X
+    bus_read(cpu, am_abs_indexed(cpu, cpu->RegX, false));
+    NEXT;
+
+// Undocumented read-modify-write instructions.
+
+OPCODE(0x07) read_modify_write(cpu, am_zpage(cpu), op_slo); NEXT;                                   // SLO zp
+OPCODE(0x17) read_modify_write(cpu, am_zpage_indexed(cpu, cpu->RegX), op_slo); NEXT;                // SLO zp,X
+OPCODE(0x0f) read_modify_write(cpu, am_abs(cpu), op_slo); NEXT;                                     // SLO abs
+OPCODE(0x1f) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegX, true), op_slo); NEXT;            // SLO abs,X
+OPCODE(0x1b) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegY, true), op_slo); NEXT;            // SLO abs,Y
+OPCODE(0x03) read_modify_write(cpu, am_zpage_x_indirect(cpu), op_slo); NEXT;                        // SLO (zp,X)
+OPCODE(0x13) read_modify_write(cpu, am_zpage_indirect_y(cpu, true), op_slo); NEXT;                  // SLO (zp),Y
+
+OPCODE(0x27) read_modify_write(cpu, am_zpage(cpu), op_rla); NEXT;                                   // RLA zp
+OPCODE(0x37) read_modify_write(cpu, am_zpage_indexed(cpu, cpu->RegX), op_rla); NEXT;                // RLA zp,X
+OPCODE(0x2f) read_modify_write(cpu, am_abs(cpu), op_rla); NEXT;                                     // RLA abs
+OPCODE(0x3f) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegX, true), op_rla); NEXT;            // RLA abs,X
+OPCODE(0x3b) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegY, true), op_rla); NEXT;            // RLA abs,Y
+OPCODE(0x23) read_modify_write(cpu, am_zpage_x_indirect(cpu), op_rla); NEXT;                        // RLA (zp,X)
+OPCODE(0x33) read_modify_write(cpu, am_zpage_indirect_y(cpu, true), op_rla); NEXT;                  // RLA (zp),Y
+
+OPCODE(0x47) read_modify_write(cpu, am_zpage(cpu), op_sre); NEXT;                                   // SRE zp
+OPCODE(0x57) read_modify_write(cpu, am_zpage_indexed(cpu, cpu->RegX), op_sre); NEXT;                // SRE zp,X
+OPCODE(0x4f) read_modify_write(cpu, am_abs(cpu), op_sre); NEXT;                                     // SRE abs
+OPCODE(0x5f) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegX, true), op_sre); NEXT;            // SRE abs,X
+OPCODE(0x5b) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegY, true), op_sre); NEXT;            // SRE abs,Y
+OPCODE(0x43) read_modify_write(cpu, am_zpage_x_indirect(cpu), op_sre); NEXT;                        // SRE (zp,X)
+OPCODE(0x53) read_modify_write(cpu, am_zpage_indirect_y(cpu, true), op_sre); NEXT;                  // SRE (zp),Y
+
+OPCODE(0x67) read_modify_write(cpu, am_zpage(cpu), op_rra); NEXT;                                   // RRA zp
+OPCODE(0x77) read_modify_write(cpu, am_zpage_indexed(cpu, cpu->RegX), op_rra); NEXT;                // RRA zp,X
+OPCODE(0x6f) read_modify_write(cpu, am_abs(cpu), op_rra); NEXT;                                     // RRA abs
+OPCODE(0x7f) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegX, true), op_rra); NEXT;            // RRA abs,X
+OPCODE(0x7b) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegY, true), op_rra); NEXT;            // RRA abs,Y
+OPCODE(0x63) read_modify_write(cpu, am_zpage_x_indirect(cpu), op_rra); NEXT;                        // RRA (zp,X)
+OPCODE(0x73) read_modify_write(cpu, am_zpage_indirect_y(cpu, true), op_rra); NEXT;                  // RRA (zp),Y
+
+OPCODE(0xc7) read_modify_write(cpu, am_zpage(cpu), op_dcp); NEXT;                                   // DCP zp
+OPCODE(0xd7) read_modify_write(cpu, am_zpage_indexed(cpu, cpu->RegX), op_dcp); NEXT;                // DCP zp,X
+OPCODE(0xcf) read_modify_write(cpu, am_abs(cpu), op_dcp); NEXT;                                     // DCP abs
+OPCODE(0xdf) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegX, true), op_dcp); NEXT;            // DCP abs,X
+OPCODE(0xdb) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegY, true), op_dcp); NEXT;            // DCP abs,Y
+OPCODE(0xc3) read_modify_write(cpu, am_zpage_x_indirect(cpu), op_dcp); NEXT;                        // DCP (zp,X)
+OPCODE(0xd3) read_modify_write(cpu, am_zpage_indirect_y(cpu, true), op_dcp); NEXT;                  // DCP (zp),Y
+
+OPCODE(0xe7) read_modify_write(cpu, am_zpage(cpu), op_isc); NEXT;                                   // ISC zp
+OPCODE(0xf7) read_modify_write(cpu, am_zpage_indexed(cpu, cpu->RegX), op_isc); NEXT;                // ISC zp,X
+OPCODE(0xef) read_modify_write(cpu, am_abs(cpu), op_isc); NEXT;                                     // ISC abs
+OPCODE(0xff) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegX, true), op_isc); NEXT;            // ISC abs,X
+OPCODE(0xfb) read_modify_write(cpu, am_abs_indexed(cpu, cpu->RegY, true), op_isc); NEXT;            // ISC abs,Y
+OPCODE(0xe3) read_modify_write(cpu, am_zpage_x_indirect(cpu), op_isc); NEXT;                        // ISC (zp,X)
+OPCODE(0xf3) read_modify_write(cpu, am_zpage_indirect_y(cpu, true), op_isc); NEXT;                  // ISC (zp),Y
+
+// Undocumented loads and stores.
+
+OPCODE(0xa7) set_nz(cpu, cpu->RegA = cpu->RegX = bus_read(cpu, am_zpage(cpu))); NEXT;               // LAX zp
+OPCODE(0xb7) set_nz(cpu, cpu->RegA = cpu->RegX = bus_read(cpu, am_zpage_indexed(cpu, cpu->RegY))); NEXT; // LAX zp,Y
+OPCODE(0xaf) set_nz(cpu, cpu->RegA = cpu->RegX = bus_read(cpu, am_abs(cpu))); NEXT;                 // LAX abs
+OPCODE(0xbf) set_nz(cpu, cpu->RegA = cpu->RegX = bus_read(cpu, am_abs_indexed(cpu, cpu->RegY, false))); NEXT; // LAX abs,Y
+OPCODE(0xa3) set_nz(cpu, cpu->RegA = cpu->RegX = bus_read(cpu, am_zpage_x_indirect(cpu))); NEXT;    // LAX (zp,X)
+OPCODE(0xb3) set_nz(cpu, cpu->RegA = cpu->RegX = bus_read(cpu, am_zpage_indirect_y(cpu, false))); NEXT; // LAX (zp),Y
+
+OPCODE(0x87) bus_write(cpu, am_zpage(cpu), cpu->RegA & cpu->RegX); NEXT;                            // SAX zp
+OPCODE(0x97) bus_write(cpu, am_zpage_indexed(cpu, cpu->RegY), cpu->RegA & cpu->RegX); NEXT;         // SAX zp,Y
+OPCODE(0x8f) bus_write(cpu, am_abs(cpu), cpu->RegA & cpu->RegX); NEXT;                              // SAX abs
+OPCODE(0x83) bus_write(cpu, am_zpage_x_indirect(cpu), cpu->RegA & cpu->RegX); NEXT;                 // SAX (zp,X)
+
+OPCODE(0xbb)                                                                                        // LAS abs,Y
+    set_nz(cpu, cpu->RegA = cpu->RegX = cpu->RegS &= bus_read(cpu, am_abs_indexed(cpu, cpu->RegY, false)));
+    NEXT;
+
+OPCODE(0x93) store_and_high_byte(cpu, zpage_pointer(cpu), cpu->RegY, cpu->RegA & cpu->RegX); NEXT;  // SHA (zp),Y
+OPCODE(0x9f) store_and_high_byte(cpu, am_abs(cpu), cpu->RegY, cpu->RegA & cpu->RegX); NEXT;         // SHA abs,Y
+OPCODE(0x9e) store_and_high_byte(cpu, am_abs(cpu), cpu->RegY, cpu->RegX); NEXT;                     // SHX abs,Y
+OPCODE(0x9c) store_and_high_byte(cpu, am_abs(cpu), cpu->RegX, cpu->RegY); NEXT;                     // SHY abs,X
+
+OPCODE(0x9b)                                                                                        // TAS abs,Y
+    cpu->RegS = cpu->RegA & cpu->RegX;
+    store_and_high_byte(cpu, am_abs(cpu), cpu->RegY, cpu->RegS);
+    NEXT;
+
+// Undocumented immediate-mode instructions.
+
+OPCODE(0xeb) op_sbc(cpu, fetch(cpu)); NEXT;                                                         // SBC #imm
+
+OPCODE(0x0b) OPCODE(0x2b)                                                                           // ANC #imm
+    cpu->FlagC = set_nz(cpu, cpu->RegA &= fetch(cpu)) >= 0x80;
+    NEXT;
+
+OPCODE(0x4b)                                                                                        // ALR #imm
+    cpu->RegA = op_lsr(cpu, cpu->RegA & fetch(cpu));
+    NEXT;
+
+OPCODE(0x6b)                                                                                        // ARR #imm
+    op_arr(cpu, fetch(cpu));
+    NEXT;
+
+OPCODE(0xcb)                                                                                        // SBX #imm
+    lo = fetch(cpu);
+    op_compare(cpu, cpu->RegA & cpu->RegX, lo);
+    cpu->RegX = (cpu->RegA & cpu->RegX) - lo;
+    NEXT;
+
+// The ANE and LXA instructions are unstable; their result depends on an analog effect.
+// We use the commonly used "magic constant" of 0xee.
+
+OPCODE(0x8b)                                                                                        // ANE #imm
+    set_nz(cpu, cpu->RegA = (cpu->RegA | 0xee) & cpu->RegX & fetch(cpu));
+    NEXT;
+
+OPCODE(0xab)                                                                                        // LXA #imm
+    set_nz(cpu, cpu->RegA = cpu->RegX = (cpu->RegA | 0xee) & fetch(cpu));
+    NEXT;
+
+// JAM instructions lock up the processor.
+
+OPCODE(0x02) OPCODE(0x12) OPCODE(0x22) OPCODE(0x32) OPCODE(0x42) OPCODE(0x52)
+OPCODE(0x62) OPCODE(0x72) OPCODE(0x92) OPCODE(0xb2) OPCODE(0xd2) OPCODE(0xf2)
+    cpu->Halted = true;
+    NEXT;
+
+#elif defined(CPU_65C02)
+
+// 65C02 instructions.
+
+OPCODE(0x80) branch(cpu, true); NEXT;                                                               // BRA rel
+
+OPCODE(0x1a) implied(cpu); set_nz(cpu, ++cpu->RegA); NEXT;                                          // INC A
+OPCODE(0x3a) implied(cpu); set_nz(cpu, --cpu->RegA); NEXT;                                          // DEC A
+
+OPCODE(0xda) implied(cpu); push(cpu, cpu->RegX); NEXT;                                              // PHX
+OPCODE(0x5a) implied(cpu); push(cpu, cpu->RegY); NEXT;                                              // PHY
+
+OPCODE(0xfa)                                                                                        // PLX
+    implied(cpu);
+    bus_read(cpu, 0x100 + cpu->RegS);
+    set_nz(cpu, cpu->RegX = pull(cpu));
+    NEXT;
+
+OPCODE(0x7a)                                                                                        // PLY
+    implied(cpu);
+    bus_read(cpu, 0x100 + cpu->RegS);
+    set_nz(cpu, cpu->RegY = pull(cpu));
+    NEXT;
+
+OPCODE(0x89) cpu->FlagZ = (cpu->RegA & fetch(cpu)) == 0; NEXT;                                      // BIT #imm
+OPCODE(0x34) op_bit(cpu, bus_read(cpu, am_zpage_indexed(cpu, cpu->RegX))); NEXT;                    // BIT zp,X
+OPCODE(0x3c) op_bit(cpu, bus_read(cpu, am_abs_indexed(cpu, cpu->RegX, false))); NEXT;               // BIT abs,X
+
+OPCODE(0x64) bus_write(cpu, am_zpage(cpu), 0); NEXT;                                                // STZ zp
+OPCODE(0x74) bus_write(cpu, am_zpage_indexed(cpu, cpu->RegX), 0); NEXT;                             // STZ zp,X
+OPCODE(0x9c) bus_write(cpu, am_abs(cpu), 0); NEXT;                                                  // STZ abs
+OPCODE(0x9e) bus_write(cpu, am_abs_indexed(cpu, cpu->RegX, true), 0); NEXT;                         // STZ abs,X
+
+OPCODE(0x04) read_modify_write(cpu, am_zpage(cpu), op_tsb); NEXT;                                   // TSB zp
+OPCODE(0x0c) read_modify_write(cpu, am_abs(cpu), op_tsb); NEXT;                                     // TSB abs
+OPCODE(0x14) read_modify_write(cpu, am_zpage(cpu), op_trb); NEXT;                                   // TRB zp
+OPCODE(0x1c) read_modify_write(cpu, am_abs(cpu), op_trb); NEXT;                                     // TRB abs
+
+OPCODE(0x12) set_nz(cpu, cpu->RegA |= bus_read(cpu, zpage_pointer(cpu))); NEXT;                     // ORA (zp)
+OPCODE(0x32) set_nz(cpu, cpu->RegA &= bus_read(cpu, zpage_pointer(cpu))); NEXT;                     // AND (zp)
+OPCODE(0x52) set_nz(cpu, cpu->RegA ^= bus_read(cpu, zpage_pointer(cpu))); NEXT;                     // EOR (zp)
+OPCODE(0x72) op_adc(cpu, bus_read(cpu, zpage_pointer(cpu))); NEXT;                                  // ADC (zp)
+OPCODE(0x92) bus_write(cpu, zpage_pointer(cpu), cpu->RegA); NEXT;                                   // STA (zp)
+OPCODE(0xb2) set_nz(cpu, cpu->RegA = bus_read(cpu, zpage_pointer(cpu))); NEXT;                      // LDA (zp)
+OPCODE(0xd2) op_compare(cpu, cpu->RegA, bus_read(cpu, zpage_pointer(cpu))); NEXT;                   // CMP (zp)
+OPCODE(0xf2) op_sbc(cpu, bus_read(cpu, zpage_pointer(cpu))); NEXT;                                  // SBC (zp)
+
+OPCODE(0x7c)                                                                                        // JMP (abs,X)
+    address = am_abs(cpu);
+    bus_read(cpu, cpu->PC - 1);
+    address += cpu->RegX;
+    lo = bus_read(cpu, address);
+    hi = bus_read(cpu, address + 1);
+    cpu->PC = hi * 0x100 + lo;
+    NEXT;
+
+OPCODE(0x07) read_modify_write(cpu, am_zpage(cpu), op_rmb0); NEXT;                                  // RMB0 zp
+OPCODE(0x17) read_modify_write(cpu, am_zpage(cpu), op_rmb1); NEXT;                                  // RMB1 zp
+OPCODE(0x27) read_modify_write(cpu, am_zpage(cpu), op_rmb2); NEXT;                                  // RMB2 zp
+OPCODE(0x37) read_modify_write(cpu, am_zpage(cpu), op_rmb3); NEXT;                                  // RMB3 zp
+OPCODE(0x47) read_modify_write(cpu, am_zpage(cpu), op_rmb4); NEXT;                                  // RMB4 zp
+OPCODE(0x57) read_modify_write(cpu, am_zpage(cpu), op_rmb5); NEXT;                                  // RMB5 zp
+OPCODE(0x67) read_modify_write(cpu, am_zpage(cpu), op_rmb6); NEXT;                                  // RMB6 zp
+OPCODE(0x77) read_modify_write(cpu, am_zpage(cpu), op_rmb7); NEXT;                                  // RMB7 zp
+
+OPCODE(0x87) read_modify_write(cpu, am_zpage(cpu), op_smb0); NEXT;                                  // SMB0 zp
+OPCODE(0x97) read_modify_write(cpu, am_zpage(cpu), op_smb1); NEXT;                                  // SMB1 zp
+OPCODE(0xa7) read_modify_write(cpu, am_zpage(cpu), op_smb2); NEXT;                                  // SMB2 zp
+OPCODE(0xb7) read_modify_write(cpu, am_zpage(cpu), op_smb3); NEXT;                                  // SMB3 zp
+OPCODE(0xc7) read_modify_write(cpu, am_zpage(cpu), op_smb4); NEXT;                                  // SMB4 zp
+OPCODE(0xd7) read_modify_write(cpu, am_zpage(cpu), op_smb5); NEXT;                                  // SMB5 zp
+OPCODE(0xe7) read_modify_write(cpu, am_zpage(cpu), op_smb6); NEXT;                                  // SMB6 zp
+OPCODE(0xf7) read_modify_write(cpu, am_zpage(cpu), op_smb7); NEXT;                                  // SMB7 zp
+
+OPCODE(0x0f) bit_branch(cpu, 0x01, false); NEXT;                                                    // BBR0 zp,rel
+OPCODE(0x1f) bit_branch(cpu, 0x02, false); NEXT;                                                    // BBR1 zp,rel
+OPCODE(0x2f) bit_branch(cpu, 0x04, false); NEXT;                                                    // BBR2 zp,rel
+OPCODE(0x3f) bit_branch(cpu, 0x08, false); NEXT;                                                    // BBR3 zp,rel
+OPCODE(0x4f) bit_branch(cpu, 0x10, false); NEXT;                                                    // BBR4 zp,rel
+OPCODE(0x5f) bit_branch(cpu, 0x20, false); NEXT;                                                    // BBR5 zp,rel
+OPCODE(0x6f) bit_branch(cpu, 0x40, false); NEXT;                                                    // BBR6 zp,rel
+OPCODE(0x7f) bit_branch(cpu, 0x80, false); NEXT;                                                    // BBR7 zp,rel
+
+OPCODE(0x8f) bit_branch(cpu, 0x01, true); NEXT;                                                     // BBS0 zp,rel
+OPCODE(0x9f) bit_branch(cpu, 0x02, true); NEXT;                                                     // BBS1 zp,rel
+OPCODE(0xaf) bit_branch(cpu, 0x04, true); NEXT;                                                     // BBS2 zp,rel
+OPCODE(0xbf) bit_branch(cpu, 0x08, true); NEXT;                                                     // BBS3 zp,rel
+OPCODE(0xcf) bit_branch(cpu, 0x10, true); NEXT;                                                     // BBS4 zp,rel
+OPCODE(0xdf) bit_branch(cpu, 0x20, true); NEXT;                                                     // BBS5 zp,rel
+OPCODE(0xef) bit_branch(cpu, 0x40, true); NEXT;                                                     // BBS6 zp,rel
+OPCODE(0xff) bit_branch(cpu, 0x80, true); NEXT;                                                     // BBS7 zp,rel
+
+// The 65C02 NOPs have well-defined lengths and cycle counts.
+
+OPCODE(0x03) OPCODE(0x13) OPCODE(0x23) OPCODE(0x33) OPCODE(0x43) OPCODE(0x53) OPCODE(0x63) OPCODE(0x73) // NOP (1 cycle)
+OPCODE(0x83) OPCODE(0x93) OPCODE(0xa3) OPCODE(0xb3) OPCODE(0xc3) OPCODE(0xd3) OPCODE(0xe3) OPCODE(0xf3)
+OPCODE(0x0b) OPCODE(0x1b) OPCODE(0x2b) OPCODE(0x3b) OPCODE(0x4b) OPCODE(0x5b) OPCODE(0x6b) OPCODE(0x7b)
+OPCODE(0x8b) OPCODE(0x9b) OPCODE(0xab) OPCODE(0xbb) OPCODE(0xeb) OPCODE(0xfb)
+    NEXT;
+
+OPCODE(0x02) OPCODE(0x22) OPCODE(0x42) OPCODE(0x62) OPCODE(0x82) OPCODE(0xc2) OPCODE(0xe2)          // NOP #imm
+    fetch(cpu);
+    NEXT;
+
+OPCODE(0x44)                                                                                        // NOP zp
+    bus_read(cpu, am_zpage(cpu));
+    NEXT;
+
+OPCODE(0x54) OPCODE(0xd4) OPCODE(0xf4)                                                              // NOP zp,X
+    bus_read(cpu, am_zpage_indexed(cpu, cpu->RegX));
+    NEXT;
+
+OPCODE(0xdc) OPCODE(0xfc)                                                                           // NOP abs
+    bus_read(cpu, am_abs(cpu));
+    NEXT;
+
+OPCODE(0x5c)                                                                                        // NOP abs (8 cycles)
+    address = am_abs(cpu);
+    for (lo = 0; lo < 5; ++lo)
+    {
+        bus_read(cpu, 0xff00 | (address & 0x00ff));
+    }
+    NEXT;
+
+// WAI and STP stop the processor until an interrupt or a reset occurs, which the simulator does not model.
+
+OPCODE(0xcb)                                                                                        // WAI
+OPCODE(0xdb)                                                                                        // STP
+    cpu->Halted = true;
+    NEXT;
+
+#endif
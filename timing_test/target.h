@@ -41,12 +41,13 @@ void FASTCALL post_big_measurement_block_hook(void);
 // This is called before testing a specific opcode.
 void FASTCALL pre_opcode_hook(const char * opcode_description, bool skip_flag);
 
-// The 'post_measure_cycles_hook' routine is called immediately following each call to 'measure_cycles'
-// or 'measure_cycles_zp_safe'. It reports success, and the test_count and error_count values updated
-// for the timing measurement that was executed just before.
+// The 'post_every_measurement_hook' routine is called following a measurement. To keep the overhead
+// low, it is not called after every measurement, but once every 'measurement_hook_interval'
+// measurements, and after every failed measurement. It reports success, and the test_count and
+// error_count values updated for the timing measurement that was executed just before.
 //
 // If this function returns false, execution will be terminated gracefully.
-// This feature can be used to stop a test run in progress.
+// This feature can be used to stop a test run in progress; platforms should poll for a user abort here.
 bool FASTCALL post_every_measurement_hook(bool success, unsigned opcode_count, unsigned long measurement_count, unsigned long error_count);
 
 // Enable/disable DMA and interrupts, to create a situation where the 6502 timing behaves in a way that
@@ -67,6 +68,17 @@ int16_t FASTCALL measure_cycles(uint8_t * code);
 // addresses that the test touches.
 int16_t FASTCALL measure_cycles_wrapper(uint8_t * code);
 
+// Specialized versions of 'measure_cycles_wrapper' for tests that preserve exactly 0, 1, or 2 zero page
+// addresses. These do not need to look at 'num_zpage_preserve'; the zp0 version goes straight to 'measure_cycles'.
+int16_t FASTCALL measure_cycles_wrapper_zp0(uint8_t * code);
+int16_t FASTCALL measure_cycles_wrapper_zp1(uint8_t * code);
+int16_t FASTCALL measure_cycles_wrapper_zp2(uint8_t * code);
+
+// Measure all code fragments in 'measurement_batch' back-to-back, and record for each of them if the
+// number of cycles is as expected. Zero page addresses are saved and restored once for the entire batch.
+// This is a platform-independent routine.
+void FASTCALL measure_cycles_batch(void);
+
 // Code and constants to implement the BRK timing test.
 //
 // The BRK instruction will vector thr__fastcall__ough the IRQ vector at (0xfffe, 0xffff).
@@ -93,6 +105,34 @@ uint8_t * FASTCALL set_irq_vector_address(uint8_t * newvec);
 
 uint8_t FASTCALL get_cpu_signature(void);
 
+#if defined(TIC_PLATFORM_GCC)
+// Select the instruction dispatch method of the host simulator (threaded or switch-based).
+void set_simulator_dispatch(bool threaded);
+
+// Enable or disable recording of the bus cycles of each measurement.
+void set_bus_trace(bool enabled);
+
+// Print the bus cycles of the last measurement made by the current thread, if enabled.
+// Cycles beyond the expected cycle count are marked.
+void print_bus_trace(const char * prefix, unsigned expected_cycles, unsigned actual_cycles);
+
+// Select the number of threads used by 'run_tests_in_parallel' (0: one per available processor).
+void set_simulator_threads(unsigned num_threads);
+
+// Run the tests in a number of threads, each with its own guest memory, simulated processor, and
+// measurement context. The opcode tests, split up by their values of par1, are handed out to the
+// threads dynamically; when all threads are done, their test counts are added to those of the
+// calling thread.
+bool run_tests_in_parallel(bool (*run_tests)(void));
+
+// Returns true while 'run_tests_in_parallel' is running the tests in worker threads.
+bool in_parallel_run(void);
+
+// Called before each value of par1 of an opcode test, and once for a skipped opcode. During a
+// parallel run, this returns false if another thread takes care of that part of the test.
+bool claim_test_item(void);
+#endif
+
 ////////////////////////////////////////////////////////////
 //                                                        //
 //  CONSTANTS THAT ARE SPECIFIC TO EACH SUPPORTED TARGET  //
@@ -115,4 +155,13 @@ uint8_t FASTCALL get_cpu_signature(void);
 #     error "No valid platform specified."
 # endif
 
+// On the host, tests can run in multiple threads. The variables that make up the measurement
+// context are then declared THREAD_LOCAL, so each thread has its own copy.
+
+# if defined(TIC_PLATFORM_GCC)
+#     define THREAD_LOCAL _Thread_local
+# else
+#     define THREAD_LOCAL
+# endif
+
 #endif
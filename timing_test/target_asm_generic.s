@@ -5,9 +5,17 @@
 ; and restoring them afterwards. This is needed in case the test code to be executed clobbers zero page addresses;
 ; the operation system (if any) and the C runtime depend on certain zero page addresses to be untouched by
 ; user code.
+;
+; The '_measure_cycles_batch' entry point measures a batch of code fragments back-to-back, recording for each
+; of them the measured number of cycles, and whether it was as expected. Each measurement in the batch has its
+; own zero page addresses to preserve.
 
                 .import _measure_cycles
                 .export _measure_cycles_wrapper
+                .export _measure_cycles_wrapper_zp0
+                .export _measure_cycles_wrapper_zp1
+                .export _measure_cycles_wrapper_zp2
+                .export _measure_cycles_batch
 
                 .export _get_cpu_signature
 
@@ -19,9 +27,38 @@
                 .import _num_zpage_preserve     ; Number of zero page addresses to be preserved. Should be 0, 1, or 2.
                 .import _zpage_preserve         ; Two bytes that can hold the zpage addreses to be preserved.
 
+                ; The batch of measurements to be executed by _measure_cycles_batch.
+                ;
+                ; This variable is defined in 'timing_test_measurement.c'. The layout of the MeasurementBatch
+                ; structure is declared in 'timing_test_measurement.h'; the offsets below must match it.
+
+                .import _measurement_batch
+
+                ; The specialized wrappers and _measure_cycles_batch count down the number of measurements
+                ; until the next call to 'post_every_measurement_hook'; the batch stops counting at zero.
+                ;
+                ; This variable is defined in 'timing_test_measurement.c'.
+
+                .import _measurement_hook_countdown
+
+MEASUREMENT_BATCH_SIZE = 16
+
+BATCH_COUNT               = _measurement_batch
+BATCH_ENTRYPOINT_LSB      = BATCH_COUNT               + 1
+BATCH_ENTRYPOINT_MSB      = BATCH_ENTRYPOINT_LSB      + MEASUREMENT_BATCH_SIZE
+BATCH_EXPECTED_CYCLES_LSB = BATCH_ENTRYPOINT_MSB      + MEASUREMENT_BATCH_SIZE
+BATCH_EXPECTED_CYCLES_MSB = BATCH_EXPECTED_CYCLES_LSB + MEASUREMENT_BATCH_SIZE
+BATCH_NUM_ZPAGE_PRESERVE  = BATCH_EXPECTED_CYCLES_MSB + MEASUREMENT_BATCH_SIZE
+BATCH_ZPAGE_PRESERVE_0    = BATCH_NUM_ZPAGE_PRESERVE  + MEASUREMENT_BATCH_SIZE
+BATCH_ZPAGE_PRESERVE_1    = BATCH_ZPAGE_PRESERVE_0    + MEASUREMENT_BATCH_SIZE
+BATCH_ACTUAL_CYCLES_LSB   = BATCH_ZPAGE_PRESERVE_1    + MEASUREMENT_BATCH_SIZE
+BATCH_ACTUAL_CYCLES_MSB   = BATCH_ACTUAL_CYCLES_LSB   + MEASUREMENT_BATCH_SIZE
+BATCH_SUCCESS             = BATCH_ACTUAL_CYCLES_MSB   + MEASUREMENT_BATCH_SIZE
+
                 .bss
 
 zpage_copy:     .res 2          ; Save any zero-page values (up to two) that need preserving here.
+batch_index:    .res 1          ; Index of the batch measurement in progress.
 
                 .code
 
@@ -35,16 +72,9 @@ _measure_cycles_wrapper:
 
                 ; Save zero-page addresses that need saving.
 
-                ldy     #0
-@save_loop:     cpy     _num_zpage_preserve
-                beq     @done_save
-                ldx     _zpage_preserve,y
-                lda     0,x
-                sta     zpage_copy,y
-                iny
-                bne     @save_loop
+                jsr     save_zpage
 
-@done_save:     ; Restore pointer to test-code.
+                ; Restore pointer to test-code.
 
                 pla
                 tax
@@ -62,16 +92,9 @@ _measure_cycles_wrapper:
 
                 ; Restore zero-page addresses that need restoring.
 
-                ldy     #0
-@restore_loop:  cpy     _num_zpage_preserve
-                beq     @done_restore
-                ldx     _zpage_preserve,y
-                lda     zpage_copy,y
-                sta     0,x
-                iny
-                bne     @restore_loop
+                jsr     restore_zpage
 
-@done_restore:  ; Restore result (test-code clock cycles).
+                ; Restore result (test-code clock cycles).
 
                 pla
                 tax
@@ -81,6 +104,162 @@ _measure_cycles_wrapper:
 
                 rts
 
+                ; Specialized wrappers for tests that preserve exactly 0, 1, or 2 zero page addresses.
+                ; The test routines select one of these once per opcode, so the per-measurement path
+                ; does not need to loop over _num_zpage_preserve, nor save the pointer to the test-code.
+
+_measure_cycles_wrapper_zp0:
+
+                ; Nothing to preserve.
+
+                dec     _measurement_hook_countdown
+                jmp     _measure_cycles
+
+_measure_cycles_wrapper_zp1:
+
+                ; Save the zero-page address; A and X (the pointer to the test-code) are kept.
+                ; Note: LDA/STA have no zero page,Y addressing mode; we use absolute,Y.
+
+                dec     _measurement_hook_countdown
+                ldy     _zpage_preserve
+                pha
+                lda     a:0,y
+                sta     zpage_copy
+                pla
+
+                jsr     _measure_cycles
+
+                ; Restore the zero-page address; A and X (the result) are kept.
+
+                ldy     _zpage_preserve
+                pha
+                lda     zpage_copy
+                sta     a:0,y
+                pla
+                rts
+
+_measure_cycles_wrapper_zp2:
+
+                ; Save the zero-page addresses; A and X (the pointer to the test-code) are kept.
+
+                dec     _measurement_hook_countdown
+                pha
+                ldy     _zpage_preserve
+                lda     a:0,y
+                sta     zpage_copy
+                ldy     _zpage_preserve+1
+                lda     a:0,y
+                sta     zpage_copy+1
+                pla
+
+                jsr     _measure_cycles
+
+                ; Restore the zero-page addresses; A and X (the result) are kept.
+
+                pha
+                ldy     _zpage_preserve
+                lda     zpage_copy
+                sta     a:0,y
+                ldy     _zpage_preserve+1
+                lda     zpage_copy+1
+                sta     a:0,y
+                pla
+                rts
+
+_measure_cycles_batch:
+
+                ; Measure the code fragments one after the other.
+
+                ldy     #0
+@measure_loop:  sty     batch_index
+                cpy     BATCH_COUNT
+                beq     @done
+
+                ; Save the zero-page addresses of this measurement. For a single address, both
+                ; BATCH_ZPAGE_PRESERVE_0 and BATCH_ZPAGE_PRESERVE_1 hold it.
+
+                lda     BATCH_NUM_ZPAGE_PRESERVE,y
+                beq     @measure
+                ldx     BATCH_ZPAGE_PRESERVE_0,y
+                lda     0,x
+                sta     zpage_copy
+                ldx     BATCH_ZPAGE_PRESERVE_1,y
+                lda     0,x
+                sta     zpage_copy+1
+
+@measure:       lda     BATCH_ENTRYPOINT_LSB,y
+                ldx     BATCH_ENTRYPOINT_MSB,y
+
+                jsr     _measure_cycles
+
+                ; Record the measured number of cycles (in A and X).
+
+                ldy     batch_index
+                sta     BATCH_ACTUAL_CYCLES_LSB,y
+                txa
+                sta     BATCH_ACTUAL_CYCLES_MSB,y
+
+                ; Restore the zero-page addresses, in reverse order.
+
+                lda     BATCH_NUM_ZPAGE_PRESERVE,y
+                beq     @compare
+                ldx     BATCH_ZPAGE_PRESERVE_1,y
+                lda     zpage_copy+1
+                sta     0,x
+                ldx     BATCH_ZPAGE_PRESERVE_0,y
+                lda     zpage_copy
+                sta     0,x
+
+                ; Compare the measured number of cycles to the expected number of cycles.
+
+@compare:       lda     BATCH_ACTUAL_CYCLES_LSB,y
+                cmp     BATCH_EXPECTED_CYCLES_LSB,y
+                bne     @fail
+                lda     BATCH_ACTUAL_CYCLES_MSB,y
+                cmp     BATCH_EXPECTED_CYCLES_MSB,y
+                bne     @fail
+                lda     #1
+                bne     @store_result
+@fail:          lda     #0
+@store_result:  sta     BATCH_SUCCESS,y
+
+                lda     _measurement_hook_countdown
+                beq     @next
+                dec     _measurement_hook_countdown
+
+@next:          iny
+                bne     @measure_loop   ; Always taken; the batch size is less than 256.
+
+@done:          rts
+
+save_zpage:
+
+                ; Save the zero-page addresses that need saving.
+
+                ldy     #0
+@save_loop:     cpy     _num_zpage_preserve
+                beq     @done_save
+                ldx     _zpage_preserve,y
+                lda     0,x
+                sta     zpage_copy,y
+                iny
+                bne     @save_loop
+@done_save:     rts
+
+restore_zpage:
+
+                ; Restore the zero-page addresses that need restoring.
+
+                ldy     #0
+@restore_loop:  cpy     _num_zpage_preserve
+                beq     @done_restore
+                ldx     _zpage_preserve,y
+                lda     zpage_copy,y
+                sta     0,x
+                iny
+                bne     @restore_loop
+@done_restore:  rts
+
                 .code
 
                 ; This cute little routine distinguishes between different 6502 variants:
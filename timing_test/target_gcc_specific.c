@@ -4,11 +4,75 @@
 ///////////////////////////
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
 
 #include "target.h"
 #include "timing_test_measurement.h"
+#include "timing_test_memory.h"
+#include "sim_6502.h"
+
+// The test code is executed by a simulated 6502 that operates on the guest memory image
+// that holds the TESTCODE block. Each thread has its own simulated 6502 and guest memory image.
+
+#define MAX_MEASUREMENT_CYCLES 1000
+
+static THREAD_LOCAL Sim6502 cpu;
+
+static Sim6502Dispatch simulator_dispatch = DispatchThreaded;
+static unsigned        simulator_threads = 0;
+
+static THREAD_LOCAL uint8_t * irq_vector_address = NULL;
+
+// When enabled, the bus cycles of each measurement are recorded, so they can be shown when
+// the measurement fails.
+
+static bool bus_trace_enabled = false;
+
+static THREAD_LOCAL Sim6502Trace  bus_trace;
+static THREAD_LOCAL unsigned long bus_trace_start_cycle_count;
+
+// Used to report the simulator speed after each big measurement block.
+
+static struct timespec block_start_time;
+static unsigned long   block_start_instruction_count;
+static unsigned long   block_start_measurement_count;
+static unsigned        block_threads;
+
+// The number of instructions simulated by worker threads that have finished.
+
+static unsigned long worker_instruction_count = 0;
+
+static Sim6502 * get_cpu(void)
+{
+    if (cpu.Memory != GUEST_MEMORY)
+    {
+        sim_6502_reset(&cpu, GUEST_MEMORY);
+    }
+    cpu.Dispatch = simulator_dispatch;
+    cpu.Trace = bus_trace_enabled ? &bus_trace : NULL;
+    return &cpu;
+}
+
+static int16_t run_guest_subroutine(uint16_t entry)
+{
+    Sim6502 * cpu = get_cpu();
+
+    // Start each run from a well-defined stack pointer and mode.
+
+    cpu->RegS  = 0xff;
+    cpu->FlagD = false;
+    cpu->FlagI = true;
+
+    bus_trace_start_cycle_count = cpu->CycleCount;
+
+    return sim_6502_run_subroutine(cpu, entry, MAX_MEASUREMENT_CYCLES);
+}
 
 void program_start_hook(void)
 {
@@ -20,10 +84,272 @@ void program_end_hook(void)
 
 void pre_big_measurement_block_hook(void)
 {
+    block_start_instruction_count = cpu.InstructionCount + worker_instruction_count;
+    block_start_measurement_count = measurement_count;
+    block_threads = 1;
+    clock_gettime(CLOCK_MONOTONIC, &block_start_time);
 }
 
 void post_big_measurement_block_hook(void)
 {
+    struct timespec block_end_time;
+    unsigned long instruction_count;
+    unsigned long block_measurement_count;
+    double duration;
+
+    clock_gettime(CLOCK_MONOTONIC, &block_end_time);
+
+    duration = (block_end_time.tv_sec - block_start_time.tv_sec) + 1e-9 * (block_end_time.tv_nsec - block_start_time.tv_nsec);
+    instruction_count = cpu.InstructionCount + worker_instruction_count - block_start_instruction_count;
+    block_measurement_count = measurement_count - block_start_measurement_count;
+
+    printf("\n");
+    printf("Simulator dispatch ....... : %s\n", simulator_dispatch == DispatchThreaded ? "threaded" : "switch");
+    printf("Simulator threads ........ : %u\n", block_threads);
+    printf("Simulated instructions ... : %lu\n", instruction_count);
+    printf("Duration ................. : %.3f s\n", duration);
+    if (duration > 0.0)
+    {
+        printf("Instructions per second .. : %.0f\n", instruction_count / duration);
+        printf("Measurements per second .. : %.0f\n", block_measurement_count / duration);
+    }
+}
+
+void set_simulator_dispatch(bool threaded)
+{
+    simulator_dispatch = threaded ? DispatchThreaded : DispatchSwitch;
+}
+
+void set_simulator_threads(unsigned num_threads)
+{
+    simulator_threads = num_threads;
+}
+
+void set_bus_trace(bool enabled)
+{
+    bus_trace_enabled = enabled;
+}
+
+void print_bus_trace(const char * prefix, unsigned expected_cycles, unsigned actual_cycles)
+{
+    unsigned long first_cycle_count, end_cycle_count, cycle_count;
+
+    if (!bus_trace_enabled)
+    {
+        return;
+    }
+
+    // Show the bus cycles of the last measurement; if there are more than fit in the trace
+    // buffer, only the most recent ones are available.
+
+    end_cycle_count = cpu.CycleCount;
+    first_cycle_count = bus_trace_start_cycle_count;
+    if (end_cycle_count - first_cycle_count > SIM_6502_TRACE_SIZE)
+    {
+        first_cycle_count = end_cycle_count - SIM_6502_TRACE_SIZE;
+    }
+
+    printf("%sbus trace:\n", prefix);
+
+    for (cycle_count = first_cycle_count; cycle_count != end_cycle_count; ++cycle_count)
+    {
+        const Sim6502BusCycle * cycle = &bus_trace.Cycles[cycle_count % SIM_6502_TRACE_SIZE];
+        unsigned cycle_number = cycle_count - bus_trace_start_cycle_count + 1;
+        const char * remark;
+
+        if (cycle_number <= expected_cycles)
+        {
+            remark = "";
+        }
+        else if (cycle_number <= actual_cycles)
+        {
+            remark = " <-- unexpected";
+        }
+        else
+        {
+            remark = " (final RTS)";
+        }
+
+        printf("%s  cycle %3u : %c 0x%04x 0x%02x%s\n", prefix, cycle_number, cycle->Write ? 'W' : 'R', cycle->Address, cycle->Data, remark);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                   //
+//                                            RUNNING TESTS IN PARALLEL                                              //
+//                                                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// During a parallel run, every worker thread walks through the full sequence of opcode tests.
+// The work is divided into items: one item for each value of par1 of a tested opcode, and one item
+// for a skipped opcode. The items are handed out in order of a shared ticket counter: a thread that
+// needs work draws the next ticket, skips the items before it, and runs the item that has the
+// ticket's sequence number. This way, each item is done by exactly one thread, and a thread that
+// finishes early simply picks up more work; the opcodes with the most measurements are shared
+// between all threads, instead of leaving a single thread to finish them at the end of the run.
+
+static bool parallel_run_active = false;
+
+static atomic_uint next_item_ticket;
+static atomic_bool stop_requested;
+
+static THREAD_LOCAL unsigned item_sequence_number;
+static THREAD_LOCAL unsigned claimed_item_ticket;
+
+typedef struct {
+    pthread_t     thread;
+    bool          (*run_tests)(void);
+    unsigned      testcode_size;
+    unsigned      testcode_page;
+    bool          result;
+    unsigned      opcode_count;
+    unsigned      opcode_skip_count;
+    unsigned long measurement_count;
+    unsigned long error_count;
+    unsigned long instruction_count;
+} WorkerThread;
+
+bool in_parallel_run(void)
+{
+    return parallel_run_active;
+}
+
+bool claim_test_item(void)
+{
+    if (!parallel_run_active)
+    {
+        return true;
+    }
+
+    if (atomic_load_explicit(&stop_requested, memory_order_relaxed))
+    {
+        // Another thread ran into an error; skip all remaining items.
+        return false;
+    }
+
+    if (item_sequence_number > claimed_item_ticket)
+    {
+        claimed_item_ticket = atomic_fetch_add(&next_item_ticket, 1);
+    }
+
+    return item_sequence_number++ == claimed_item_ticket;
+}
+
+static void * worker_thread_main(void * arg)
+{
+    WorkerThread * worker = arg;
+
+    item_sequence_number = 0;
+    claimed_item_ticket = atomic_fetch_add(&next_item_ticket, 1);
+
+    reset_test_counts();
+
+    if (allocate_testcode_block_at_guest_page(worker->testcode_size, worker->testcode_page) != 0)
+    {
+        printf("Unable to allocate TESTCODE block in worker thread.\n");
+        worker->result = false;
+    }
+    else
+    {
+        worker->result = worker->run_tests();
+        worker->instruction_count = get_cpu()->InstructionCount;
+        free_testcode_block();
+    }
+
+    free_guest_memory();
+
+    if (!worker->result)
+    {
+        atomic_store(&stop_requested, true);
+    }
+
+    worker->opcode_count      = opcode_count;
+    worker->opcode_skip_count = opcode_skip_count;
+    worker->measurement_count = measurement_count;
+    worker->error_count       = error_count;
+
+    return NULL;
+}
+
+bool run_tests_in_parallel(bool (*run_tests)(void))
+{
+    WorkerThread * workers;
+    unsigned num_threads;
+    unsigned started;
+    unsigned k;
+    bool result;
+
+    num_threads = simulator_threads;
+    if (num_threads == 0)
+    {
+        long num_processors = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = (num_processors > 0) ? num_processors : 1;
+    }
+
+    if (num_threads == 1)
+    {
+        return run_tests();
+    }
+
+    workers = calloc(num_threads, sizeof(WorkerThread));
+    if (workers == NULL)
+    {
+        return run_tests();
+    }
+
+    atomic_store(&next_item_ticket, 0);
+    atomic_store(&stop_requested, false);
+    parallel_run_active = true;
+
+    // The workers place their TESTCODE blocks at the same guest address as the calling thread.
+
+    for (started = 0; started < num_threads; ++started)
+    {
+        WorkerThread * worker = &workers[started];
+
+        worker->run_tests     = run_tests;
+        worker->testcode_size = 2 * (TESTCODE_ANCHOR - TESTCODE_BASE);
+        worker->testcode_page = GUEST_ADDRESS(TESTCODE_BASE) / 256;
+
+        if (pthread_create(&worker->thread, NULL, worker_thread_main, worker) != 0)
+        {
+            break;
+        }
+    }
+
+    if (started == 0)
+    {
+        // Unable to start any worker thread; run the tests in the calling thread.
+        parallel_run_active = false;
+        block_threads = 1;
+        free(workers);
+        return run_tests();
+    }
+
+    result = true;
+
+    for (k = 0; k < started; ++k)
+    {
+        WorkerThread * worker = &workers[k];
+
+        pthread_join(worker->thread, NULL);
+
+        result = result && worker->result;
+
+        opcode_count      += worker->opcode_count;
+        opcode_skip_count += worker->opcode_skip_count;
+        measurement_count += worker->measurement_count;
+        error_count       += worker->error_count;
+
+        worker_instruction_count += worker->instruction_count;
+    }
+
+    parallel_run_active = false;
+    block_threads = started;
+
+    free(workers);
+
+    return result;
 }
 
 void pre_opcode_hook(const char * opcode_description, bool skip_flag)
@@ -44,13 +370,22 @@ bool post_every_measurement_hook(bool success, unsigned opcode_count, unsigned l
     (void)opcode_count;
     (void)measurement_count;
     (void)error_count;
-    return true; // Proceed.
+
+    // Stop when another thread of a parallel run has stopped.
+    return !atomic_load_explicit(&stop_requested, memory_order_relaxed);
 }
 
 
 uint8_t * set_irq_vector_address(uint8_t * newvec)
 {
-    return newvec;
+    uint8_t * oldvec = irq_vector_address;
+
+    irq_vector_address = newvec;
+
+    GUEST_MEMORY[0xfffe] = GUEST_ADDRESS(newvec) & 0xff;
+    GUEST_MEMORY[0xffff] = GUEST_ADDRESS(newvec) >> 8;
+
+    return oldvec;
 }
 
 bool zp_address_is_safe_for_read(uint8_t zp_address)
@@ -67,11 +402,82 @@ bool zp_address_is_safe_for_write(uint8_t zp_address)
 
 int16_t measure_cycles_wrapper(uint8_t * code)
 {
-    (void)code;
-    return m_test_overhead_cycles + m_instruction_cycles;
+    // There is no need to preserve zero page addresses; the simulated processor has its own zero page.
+    return run_guest_subroutine(GUEST_ADDRESS(code));
+}
+
+int16_t measure_cycles_wrapper_zp0(uint8_t * code)
+{
+    --measurement_hook_countdown;
+    return measure_cycles_wrapper(code);
+}
+
+int16_t measure_cycles_wrapper_zp1(uint8_t * code)
+{
+    --measurement_hook_countdown;
+    return measure_cycles_wrapper(code);
+}
+
+int16_t measure_cycles_wrapper_zp2(uint8_t * code)
+{
+    --measurement_hook_countdown;
+    return measure_cycles_wrapper(code);
+}
+
+void measure_cycles_batch(void)
+{
+    uint8_t index;
+
+    for (index = 0; index != measurement_batch.count; ++index)
+    {
+        uint16_t entry    = measurement_batch.entrypoint_msb[index] * 256 + measurement_batch.entrypoint_lsb[index];
+        uint16_t expected = measurement_batch.expected_cycles_msb[index] * 256 + measurement_batch.expected_cycles_lsb[index];
+        uint16_t actual   = run_guest_subroutine(entry);
+
+        measurement_batch.actual_cycles_lsb[index] = actual & 0xff;
+        measurement_batch.actual_cycles_msb[index] = actual >> 8;
+        measurement_batch.success[index] = (actual == expected);
+
+        if (measurement_hook_countdown != 0)
+        {
+            --measurement_hook_countdown;
+        }
+    }
 }
 
 uint8_t get_cpu_signature(void)
 {
-    return 3;
+    // Run the same code as the 'get_cpu_signature' routine in 'target_asm_generic.s'.
+
+    static const uint8_t signature_code[] = {
+        0xf8,       // SED
+        0xa9, 0x00, // LDA #0
+        0xe9, 0x1c, // SBC #28
+        0x4a,       // LSR
+        0xe9, 0x1c, // SBC #28
+        0x29, 0x03, // AND #3
+        0xd8,       // CLD
+        0x60        // RTS
+    };
+
+    const uint16_t signature_code_address = 0x0200;
+
+    unsigned k;
+
+    if (allocate_guest_memory() != 0)
+    {
+        return 3;
+    }
+
+    for (k = 0; k < sizeof(signature_code); ++k)
+    {
+        GUEST_MEMORY[signature_code_address + k] = signature_code[k];
+    }
+
+    if (run_guest_subroutine(signature_code_address) < 0)
+    {
+        return 3;
+    }
+
+    return get_cpu()->RegA;
 }
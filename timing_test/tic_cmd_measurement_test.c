@@ -12,10 +12,11 @@
 #include "timing_test_memory.h"
 #include "target.h"
 
-static void generate_code(uint8_t * code, unsigned cycles)
+static uint8_t * generate_code(uint8_t * code, unsigned cycles)
 {
     // Generate simple code starting at the pointer 'code' that will
     // burn 'cycles' clock cycles, then perform an RTS.
+    // Returns the address following the generated code.
 
     assert(cycles != 1);
 
@@ -42,6 +43,8 @@ static void generate_code(uint8_t * code, unsigned cycles)
         }
     }
     *code++ = 0x60;                 // RTS             [-]
+
+    return code;
 }
 
 static bool run_measurement_tests(unsigned repeats, unsigned min_cycle_count, unsigned max_cycle_count)
@@ -49,12 +52,22 @@ static bool run_measurement_tests(unsigned repeats, unsigned min_cycle_count, un
     // Generate straightforward 6502 code to burn a desired number of instruction cycles, then
     // execute the 'measure_cycles' routine on the genrated code to verify that the number of cycles
     // measured is equal to the number of cycles the code was expected to take.
+    //
+    // The code fragments for consecutive cycle counts are placed one after the other in the TESTCODE
+    // block, and measured in batches.
 
+    uint8_t * testcode_end = TESTCODE_BASE + 2 * (TESTCODE_ANCHOR - TESTCODE_BASE);
+    uint8_t * code;
+    uint8_t * entrypoint;
     unsigned repeat_index;
     unsigned cycle_count;
 
     prepare_opcode_tests("SLEEP", Par1234_Generic);
 
+    select_zpage_preserve(0); // The generated code only reads from the zero page.
+
+    code = TESTCODE_BASE;
+
     for (repeat_index = 1; repeat_index <= repeats; ++repeat_index)
     {
         par1 = repeat_index % 256;
@@ -71,17 +84,34 @@ static bool run_measurement_tests(unsigned repeats, unsigned min_cycle_count, un
             par3 = cycle_count % 256;
             par4 = cycle_count / 256;
 
-            generate_code(TESTCODE_BASE, cycle_count);
+            // Place the code after the code of the previous measurement in the batch. The generated code
+            // takes at most (cycle_count / 2 + 2) bytes; if it doesn't fit in the TESTCODE block, first
+            // measure the batch so far.
+
+            if (measurement_batch.count == 0)
+            {
+                code = TESTCODE_BASE;
+            }
+            else if (code + cycle_count / 2 + 2 > testcode_end)
+            {
+                if (!execute_batch_opcode_tests(F_NONE))
+                    return false;
+                code = TESTCODE_BASE;
+            }
+
+            entrypoint = code;
+            code = generate_code(code, cycle_count);
 
             m_test_overhead_cycles = 0;
             m_instruction_cycles = cycle_count;
 
             // Note that we do not bail out in case of errors.
-            if (!execute_single_opcode_test(TESTCODE_BASE, F_NONE))
+            if (!add_batch_opcode_test(entrypoint, F_NONE))
                 return false;
         }
     }
-    return true;
+
+    return execute_batch_opcode_tests(F_NONE);
 }
 
 void tic_cmd_measurement_test(unsigned repeats, unsigned min_cycle_count, unsigned max_cycle_count)
@@ -10,6 +10,7 @@
 #include <string.h>
 
 #include "timing_test_memory.h"
+#include "timing_test_measurement.h"
 #include "tic_cmd_measurement_test.h"
 #include "tic_cmd_cpu_test.h"
 #include "target.h"
@@ -28,6 +29,33 @@ void tic_cmd_help(void)
     printf("\n");
     printf("  * level: 0 (fast) to 7 (slow)\n");
     printf("\n");
+    printf("> hook <interval>\n");
+    printf("\n");
+    printf("  Report progress (and check for abort) every\n");
+    printf("  <interval> measurements, and on failure.\n");
+    printf("\n");
+    printf("  * interval: 1 to 255 (default: %u)\n", DEFAULT_MEASUREMENT_HOOK_INTERVAL);
+    printf("\n");
+#if defined(TIC_PLATFORM_GCC)
+    printf("> page <page>\n");
+    printf("\n");
+    printf("  Move the TESTCODE block to the given guest page.\n");
+    printf("\n");
+    printf("> dispatch <threaded|switch>\n");
+    printf("\n");
+    printf("  Select the instruction dispatch method of the simulator.\n");
+    printf("\n");
+    printf("> trace <on|off>\n");
+    printf("\n");
+    printf("  Show the bus cycles of failed measurements.\n");
+    printf("\n");
+    printf("> threads <count>\n");
+    printf("\n");
+    printf("  Set the number of threads used by the 'cpu' command.\n");
+    printf("\n");
+    printf("  * count: 0 (one per processor, the default) or more\n");
+    printf("\n");
+#endif
     printf("> quit\n");
     printf("\n");
     printf("  Quit the program.\n");
@@ -38,7 +66,7 @@ int command_line_loop(void)
 {
     int result;
 
-    result = allocate_testcode_block(2048);
+    result = allocate_testcode_block(TESTCODE_BLOCK_SIZE);
     if (result != 0)
     {
         puts("Unable to allocate TESTCODE block.");
@@ -49,6 +77,9 @@ int command_line_loop(void)
     {
         char command[80];
         unsigned par1, par2, par3;
+#if defined(TIC_PLATFORM_GCC)
+        int page;
+#endif
 
         printf("Enter command (or ENTER for help):\n");
         printf("\n");
@@ -89,6 +120,52 @@ int command_line_loop(void)
         {
             tic_cmd_cpu_test(par1);
         }
+        else if (sscanf(command, "hook %u", &par1) == 1 && par1 >= 1 && par1 <= 255)
+        {
+            measurement_hook_interval = par1;
+        }
+#if defined(TIC_PLATFORM_GCC)
+        else if (sscanf(command, "page %i", &page) == 1)
+        {
+            if (page < 0 || page > 255)
+            {
+                printf("Invalid guest page: %d.\n\n", page);
+            }
+            else
+            {
+                free_testcode_block();
+                if (allocate_testcode_block_at_guest_page(TESTCODE_BLOCK_SIZE, page) == 0)
+                {
+                    printf("TESTCODE block moved to guest address 0x%04x.\n\n", GUEST_ADDRESS(TESTCODE_BASE));
+                }
+                else
+                {
+                    printf("Unable to place TESTCODE block at guest page 0x%02x.\n\n", page);
+                    allocate_testcode_block(TESTCODE_BLOCK_SIZE);
+                }
+            }
+        }
+        else if (strcmp(command, "dispatch threaded") == 0)
+        {
+            set_simulator_dispatch(true);
+        }
+        else if (strcmp(command, "dispatch switch") == 0)
+        {
+            set_simulator_dispatch(false);
+        }
+        else if (strcmp(command, "trace on") == 0)
+        {
+            set_bus_trace(true);
+        }
+        else if (strcmp(command, "trace off") == 0)
+        {
+            set_bus_trace(false);
+        }
+        else if (sscanf(command, "threads %u", &par1) == 1)
+        {
+            set_simulator_threads(par1);
+        }
+#endif
         else
         {
             // No valid command found, show help.
@@ -4,33 +4,46 @@
 ///////////////////////////////
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
 #include <assert.h>
 
 #include "target.h"
 #include "timing_test_measurement.h"
+#include "timing_test_memory.h"
 
 // Interface from higher-level routines, via global variables.
 
-uint8_t num_zpage_preserve; // How many zero-pages addresses should the test preserve?
-uint8_t zpage_preserve[2];  // Zero page addresses to preserve while the test executes (0, 1, or 2 values).
+THREAD_LOCAL uint8_t num_zpage_preserve; // How many zero-pages addresses should the test preserve?
+THREAD_LOCAL uint8_t zpage_preserve[2];  // Zero page addresses to preserve while the test executes (0, 1, or 2 values).
 
-static const char * m_opcode_description;
-static ParSpec      m_parspec;
+// The measurement wrapper that preserves 'num_zpage_preserve' zero page addresses.
 
-uint8_t par1;
-uint8_t par2;
-uint8_t par3;
-uint8_t par4;
+typedef int16_t (FASTCALL * MeasureCyclesFunction)(uint8_t * code);
 
-unsigned m_test_overhead_cycles;
-unsigned m_instruction_cycles;
+static THREAD_LOCAL MeasureCyclesFunction measure_cycles_function = measure_cycles_wrapper_zp0;
 
-unsigned opcode_count;
-unsigned opcode_skip_count;
-unsigned long measurement_count;
-unsigned long error_count;
+static THREAD_LOCAL const char * m_opcode_description;
+static THREAD_LOCAL ParSpec      m_parspec;
+
+THREAD_LOCAL uint8_t par1;
+THREAD_LOCAL uint8_t par2;
+THREAD_LOCAL uint8_t par3;
+THREAD_LOCAL uint8_t par4;
+
+THREAD_LOCAL MeasurementBatch measurement_batch;
+
+THREAD_LOCAL unsigned m_test_overhead_cycles;
+THREAD_LOCAL unsigned m_instruction_cycles;
+
+uint8_t measurement_hook_interval = DEFAULT_MEASUREMENT_HOOK_INTERVAL;
+THREAD_LOCAL uint8_t measurement_hook_countdown;
+
+THREAD_LOCAL unsigned opcode_count;
+THREAD_LOCAL unsigned opcode_skip_count;
+THREAD_LOCAL unsigned long measurement_count;
+THREAD_LOCAL unsigned long error_count;
 
 void reset_test_counts(void)
 {
@@ -38,6 +51,7 @@ void reset_test_counts(void)
     opcode_skip_count = 0;
     measurement_count = 0;
     error_count = 0;
+    measurement_hook_countdown = measurement_hook_interval;
 }
 
 void report_test_counts(void)
@@ -49,21 +63,74 @@ void report_test_counts(void)
     printf("\n");
 }
 
-void prepare_opcode_tests(const char * opcode_description, ParSpec parspec)
+bool prepare_opcode_tests(const char * opcode_description, ParSpec parspec)
 {
     m_opcode_description = opcode_description;
     m_parspec = parspec;
+#if defined(TIC_PLATFORM_GCC)
+    // During a parallel run, the opcode is counted and announced in prepare_par1_tests().
+    if (in_parallel_run())
+        return true;
+#endif
     ++opcode_count;
     pre_opcode_hook(opcode_description, false);
+    return true;
+}
+
+bool prepare_par1_tests(void)
+{
+#if defined(TIC_PLATFORM_GCC)
+    // During a parallel run, the values of par1 are distributed over the threads. The opcode is
+    // counted and announced by the thread that runs its first value of par1.
+    if (!in_parallel_run())
+        return true;
+    if (!claim_test_item())
+        return false;
+    if (par1 == 0)
+    {
+        ++opcode_count;
+        pre_opcode_hook(m_opcode_description, false);
+    }
+#endif
+    return true;
 }
 
 void prepare_opcode_tests_skip(const char * opcode_description)
 {
+#if defined(TIC_PLATFORM_GCC)
+    if (!claim_test_item())
+        return;
+#endif
     m_opcode_description = opcode_description;
     ++opcode_skip_count;
     pre_opcode_hook(opcode_description, true);
 }
 
+void select_zpage_preserve(uint8_t count)
+{
+    // Select the measurement wrapper once, rather than have a generic wrapper look at
+    // the number of zero page addresses to preserve for every measurement.
+
+    num_zpage_preserve = count;
+
+    switch (count)
+    {
+        case 0:
+            measure_cycles_function = measure_cycles_wrapper_zp0;
+            break;
+        case 1:
+            measure_cycles_function = measure_cycles_wrapper_zp1;
+            break;
+        case 2:
+            measure_cycles_function = measure_cycles_wrapper_zp2;
+            break;
+        default:
+            // There is no wrapper for this; carrying on would leave zero page addresses unprotected.
+            printf("Cannot preserve %u zero page addresses.\n", count);
+            exit(EXIT_FAILURE);
+    }
+}
+
 void print_label_value_pair(const char * prefix, const char * label, unsigned long value, unsigned max_label_length)
 {   unsigned k;
     printf("%s", prefix);
@@ -139,6 +206,10 @@ static void print_test_report(unsigned actual_cycles)
         print_label_hex_value_pair("  ", "par4", par4, 20);
     }
 
+#if defined(TIC_PLATFORM_GCC)
+    print_bus_trace("  ", m_test_overhead_cycles + m_instruction_cycles, actual_cycles);
+#endif
+
     printf("END OF ERROR REPORT\n\n");
 }
 
@@ -149,7 +220,7 @@ bool execute_single_opcode_test(uint8_t * entrypoint, uint8_t flags)
     bool success, hook_result;
 
     ++measurement_count;
-    actual_cycles = measure_cycles_wrapper(entrypoint);
+    actual_cycles = measure_cycles_function(entrypoint);
     success = (actual_cycles == m_test_overhead_cycles + m_instruction_cycles);
 
     if (!success)
@@ -157,12 +228,29 @@ bool execute_single_opcode_test(uint8_t * entrypoint, uint8_t flags)
         ++error_count;
     }
 
+    // Fast path: the hook is only called every 'measurement_hook_interval' measurements, or on failure.
+    // The measurement wrapper has already counted down 'measurement_hook_countdown'.
+
+    if (success && measurement_hook_countdown != 0)
+    {
+        return true;
+    }
+
+    measurement_hook_countdown = measurement_hook_interval;
+
     // If hook_result is false, the hook requests termination.
     hook_result = post_every_measurement_hook(success, opcode_count, measurement_count, error_count);
 
     if (!success)
     {
+#if defined(TIC_PLATFORM_GCC)
+        // Keep the report in one piece when tests run in multiple threads.
+        flockfile(stdout);
+        print_test_report(actual_cycles);
+        funlockfile(stdout);
+#else
         print_test_report(actual_cycles);
+#endif
 
         if (flags & F_STOP_ON_ERROR)
         {
@@ -172,3 +260,138 @@ bool execute_single_opcode_test(uint8_t * entrypoint, uint8_t flags)
 
     return hook_result;
 }
+
+bool add_batch_opcode_test(uint8_t * entrypoint, uint8_t flags)
+{
+    // Add a measurement to the batch, using the current parameters and expected cycle count.
+    // The code fragment at the entry point must stay unchanged until the batch is executed.
+
+    uint8_t index = measurement_batch.count;
+    unsigned expected_cycles = m_test_overhead_cycles + m_instruction_cycles;
+
+    measurement_batch.entrypoint_lsb[index]       = GUEST_ADDRESS(entrypoint) & 0xff;
+    measurement_batch.entrypoint_msb[index]       = GUEST_ADDRESS(entrypoint) >> 8;
+    measurement_batch.expected_cycles_lsb[index]  = expected_cycles & 0xff;
+    measurement_batch.expected_cycles_msb[index]  = expected_cycles >> 8;
+    measurement_batch.num_zpage_preserve[index]   = num_zpage_preserve;
+    measurement_batch.zpage_preserve_0[index]     = zpage_preserve[0];
+    measurement_batch.zpage_preserve_1[index]     = (num_zpage_preserve == 2) ? zpage_preserve[1] : zpage_preserve[0];
+    measurement_batch.entrypoint[index]           = entrypoint;
+    measurement_batch.par[0][index]               = par1;
+    measurement_batch.par[1][index]               = par2;
+    measurement_batch.par[2][index]               = par3;
+    measurement_batch.par[3][index]               = par4;
+    measurement_batch.test_overhead_cycles[index] = m_test_overhead_cycles;
+
+    measurement_batch.count = index + 1;
+
+    if (measurement_batch.count == MEASUREMENT_BATCH_SIZE)
+    {
+        return execute_batch_opcode_tests(flags);
+    }
+
+    return true;
+}
+
+bool execute_batch_opcode_tests(uint8_t flags)
+{
+    uint8_t count, index;
+    uint8_t saved_par1, saved_par2, saved_par3, saved_par4;
+    unsigned saved_test_overhead_cycles, saved_instruction_cycles;
+    unsigned expected_cycles;
+    unsigned actual_cycles;
+    bool success, hook_result;
+
+    count = measurement_batch.count;
+    if (count == 0)
+    {
+        return true;
+    }
+
+    measure_cycles_batch();
+
+    measurement_batch.count = 0;
+
+    success = true;
+    for (index = 0; index != count; ++index)
+    {
+        if (!measurement_batch.success[index])
+        {
+            ++error_count;
+            success = false;
+        }
+    }
+
+    measurement_count += count;
+
+    // 'measure_cycles_batch' has counted down 'measurement_hook_countdown' for each measurement.
+
+    if (success && measurement_hook_countdown != 0)
+    {
+        return true;
+    }
+
+    measurement_hook_countdown = measurement_hook_interval;
+
+    hook_result = post_every_measurement_hook(success, opcode_count, measurement_count, error_count);
+
+    if (!success)
+    {
+        // The reports use the parameters and cycle counts of the failed measurements.
+        // Save those of the caller, to restore them afterwards.
+
+        saved_par1 = par1;
+        saved_par2 = par2;
+        saved_par3 = par3;
+        saved_par4 = par4;
+        saved_test_overhead_cycles = m_test_overhead_cycles;
+        saved_instruction_cycles = m_instruction_cycles;
+
+        for (index = 0; index != count; ++index)
+        {
+            if (measurement_batch.success[index])
+                continue;
+
+            // Restore the context of the failed measurement, and report the number of cycles
+            // it actually took.
+
+            par1 = measurement_batch.par[0][index];
+            par2 = measurement_batch.par[1][index];
+            par3 = measurement_batch.par[2][index];
+            par4 = measurement_batch.par[3][index];
+
+            expected_cycles = measurement_batch.expected_cycles_msb[index] * 256 + measurement_batch.expected_cycles_lsb[index];
+            m_test_overhead_cycles = measurement_batch.test_overhead_cycles[index];
+            m_instruction_cycles = expected_cycles - m_test_overhead_cycles;
+
+            actual_cycles = measurement_batch.actual_cycles_msb[index] * 256 + measurement_batch.actual_cycles_lsb[index];
+
+#if defined(TIC_PLATFORM_GCC)
+            // The bus trace only holds the last measurement of the batch. The simulator is deterministic,
+            // so running the failed measurement again reproduces its bus cycles for the report.
+            measure_cycles_wrapper(measurement_batch.entrypoint[index]);
+
+            flockfile(stdout);
+            print_test_report(actual_cycles);
+            funlockfile(stdout);
+#else
+            print_test_report(actual_cycles);
+#endif
+
+            if (flags & F_STOP_ON_ERROR)
+            {
+                hook_result = false;
+                break;
+            }
+        }
+
+        par1 = saved_par1;
+        par2 = saved_par2;
+        par3 = saved_par3;
+        par4 = saved_par4;
+        m_test_overhead_cycles = saved_test_overhead_cycles;
+        m_instruction_cycles = saved_instruction_cycles;
+    }
+
+    return hook_result;
+}
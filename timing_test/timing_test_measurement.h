@@ -9,6 +9,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "target.h"
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                                                                                                   //
 //                                       INTERFACE TO LOW-LEVEL MEASUREMENT ROUTINE                                  //
@@ -36,28 +38,72 @@ typedef enum {
     Par1234_OpcodeOffset_ZPage_BranchDisplacement_TakenNotTaken
 } ParSpec;
 
-extern uint8_t par1;
-extern uint8_t par2;
-extern uint8_t par3;
-extern uint8_t par4;
+extern THREAD_LOCAL uint8_t par1;
+extern THREAD_LOCAL uint8_t par2;
+extern THREAD_LOCAL uint8_t par3;
+extern THREAD_LOCAL uint8_t par4;
+
+extern THREAD_LOCAL uint8_t num_zpage_preserve; // How many zero-pages addresses should the test preserve?
+extern THREAD_LOCAL uint8_t zpage_preserve[2];  // Zero page addresses to preserve while the test executes (0, 1, or 2 values).
+
+// A batch of measurements that is executed back-to-back by 'measure_cycles_batch', without returning to C
+// in between. The first part of the structure is accessed from assembly; its layout must match the
+// offsets used in 'target_asm_generic.s'. Entry points are stored as guest addresses.
+//
+// Each measurement has its own zero page addresses to preserve (0, 1, or 2). For a single address,
+// 'zpage_preserve_1' repeats 'zpage_preserve_0', so the assembly code can always handle two of them.
+
+#define MEASUREMENT_BATCH_SIZE 16
+
+typedef struct {
+    // Accessed from assembly.
+    uint8_t   count;                                        // Number of measurements in the batch.
+    uint8_t   entrypoint_lsb[MEASUREMENT_BATCH_SIZE];
+    uint8_t   entrypoint_msb[MEASUREMENT_BATCH_SIZE];
+    uint8_t   expected_cycles_lsb[MEASUREMENT_BATCH_SIZE];
+    uint8_t   expected_cycles_msb[MEASUREMENT_BATCH_SIZE];
+    uint8_t   num_zpage_preserve[MEASUREMENT_BATCH_SIZE];
+    uint8_t   zpage_preserve_0[MEASUREMENT_BATCH_SIZE];
+    uint8_t   zpage_preserve_1[MEASUREMENT_BATCH_SIZE];
+    uint8_t   actual_cycles_lsb[MEASUREMENT_BATCH_SIZE];    // Written by 'measure_cycles_batch'.
+    uint8_t   actual_cycles_msb[MEASUREMENT_BATCH_SIZE];    // Written by 'measure_cycles_batch'.
+    uint8_t   success[MEASUREMENT_BATCH_SIZE];              // Written by 'measure_cycles_batch': 1 (pass) or 0 (fail).
+    // Only used from C, to report failed measurements.
+    uint8_t * entrypoint[MEASUREMENT_BATCH_SIZE];
+    uint8_t   par[4][MEASUREMENT_BATCH_SIZE];
+    unsigned  test_overhead_cycles[MEASUREMENT_BATCH_SIZE];
+} MeasurementBatch;
+
+extern THREAD_LOCAL MeasurementBatch measurement_batch;
+
+extern THREAD_LOCAL unsigned m_test_overhead_cycles;
+extern THREAD_LOCAL unsigned m_instruction_cycles;
+
+// The 'post_every_measurement_hook' is called once every 'measurement_hook_interval' measurements,
+// and after every failed measurement. The countdown is decremented by the measurement wrappers and by
+// 'measure_cycles_batch', and reset by 'reset_test_counts' and after each call to the hook.
 
-extern uint8_t num_zpage_preserve; // How many zero-pages addresses should the test preserve?
-extern uint8_t zpage_preserve[2];  // Zero page addresses to preserve while the test executes (0, 1, or 2 values).
+#define DEFAULT_MEASUREMENT_HOOK_INTERVAL 16
 
-extern unsigned m_test_overhead_cycles;
-extern unsigned m_instruction_cycles;
+extern uint8_t measurement_hook_interval;
+extern THREAD_LOCAL uint8_t measurement_hook_countdown;
 
-extern unsigned long test_count;
-extern unsigned long msm_count;
-extern unsigned long error_count;
+extern THREAD_LOCAL unsigned opcode_count;
+extern THREAD_LOCAL unsigned opcode_skip_count;
+extern THREAD_LOCAL unsigned long measurement_count;
+extern THREAD_LOCAL unsigned long error_count;
 
 #define F_NONE             0
 #define F_STOP_ON_ERROR    0x01
 
 void reset_test_counts(void);
 void prepare_opcode_tests_skip(const char * test_description);
-void prepare_opcode_tests(const char * test_description, ParSpec parspec);
+bool prepare_opcode_tests(const char * test_description, ParSpec parspec); // Returns false if the opcode is to be skipped.
+bool prepare_par1_tests(void); // Returns false if the current value of par1 is to be skipped.
+void select_zpage_preserve(uint8_t count);                          // Set num_zpage_preserve, once per opcode.
 bool execute_single_opcode_test(uint8_t * entrypoint, uint8_t flags);
+bool add_batch_opcode_test(uint8_t * entrypoint, uint8_t flags);    // Executes the batch when it is full.
+bool execute_batch_opcode_tests(uint8_t flags);                     // Executes the measurements in the batch, if any.
 void report_test_counts(void);
 
 #endif
@@ -8,9 +8,77 @@
 
 #include "timing_test_memory.h"
 
-uint8_t * TESTCODE_PTR    = NULL; // The pointer to the full test area, allocated using malloc().
-uint8_t * TESTCODE_BASE   = NULL; // The first address in the TESTCODE range that is on a page boundary.
-uint8_t * TESTCODE_ANCHOR = NULL; // The halfway point in the TESTCODE range, also on a page boundary. Put test code here.
+THREAD_LOCAL uint8_t * TESTCODE_PTR    = NULL; // The pointer to the full test area, allocated using malloc().
+THREAD_LOCAL uint8_t * TESTCODE_BASE   = NULL; // The first address in the TESTCODE range that is on a page boundary.
+THREAD_LOCAL uint8_t * TESTCODE_ANCHOR = NULL; // The halfway point in the TESTCODE range, also on a page boundary. Put test code here.
+
+#if defined(TIC_PLATFORM_GCC)
+
+THREAD_LOCAL uint8_t * GUEST_MEMORY = NULL;
+
+int allocate_guest_memory(void)
+{
+    if (GUEST_MEMORY == NULL)
+    {
+        GUEST_MEMORY = calloc(0x10000, 1);
+        if (GUEST_MEMORY == NULL)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+void free_guest_memory(void)
+{
+    free(GUEST_MEMORY);
+    GUEST_MEMORY = NULL;
+}
+
+int allocate_testcode_block_at_guest_page(unsigned size, unsigned page)
+{
+    if (allocate_guest_memory() != 0)
+    {
+        // Unable to allocate the guest memory image; report failure.
+        return -1;
+    }
+
+    if (size % 512 != 0)
+    {
+        // We are only willing to allocate an even number of pages; report failure.
+        return -1;
+    }
+
+    // Stay clear of the zero page, the stack, and the top page that holds the interrupt vectors.
+
+    if (page < 0x02 || page * 256 + size > 0xff00)
+    {
+        return -1;
+    }
+
+    // Initialize the important variables.
+
+    TESTCODE_PTR    = GUEST_MEMORY + page * 256;
+    TESTCODE_BASE   = TESTCODE_PTR;
+    TESTCODE_ANCHOR = TESTCODE_BASE + size / 2;
+
+    return 0;
+}
+
+int allocate_testcode_block(unsigned size)
+{
+    return allocate_testcode_block_at_guest_page(size, TESTCODE_GUEST_PAGE_DEFAULT);
+}
+
+void free_testcode_block(void)
+{
+    TESTCODE_PTR    = NULL;
+    TESTCODE_BASE   = NULL;
+    TESTCODE_ANCHOR = NULL;
+}
+
+#else
 
 int allocate_testcode_block(unsigned size)
 {
@@ -50,3 +118,5 @@ void free_testcode_block(void)
 {
     free(TESTCODE_PTR);
 }
+
+#endif
@@ -1,4 +1,3 @@
-
 //////////////////////////
 // timing_test_memory.h //
 //////////////////////////
@@ -8,9 +7,37 @@
 
 #include <stdint.h>
 
-extern uint8_t * TESTCODE_PTR;    // The pointer to the full test area, as allocated using malloc().
-extern uint8_t * TESTCODE_BASE;   // The first address in the TESTCODE range that is on a page boundary.
-extern uint8_t * TESTCODE_ANCHOR; // The halfway point in the TESTCODE range, also on a page boundary. Put test code here.
+#include "target.h"
+
+// The size of the TESTCODE block allocated by the program.
+
+#define TESTCODE_BLOCK_SIZE 2048
+
+extern THREAD_LOCAL uint8_t * TESTCODE_PTR;    // The pointer to the full test area, as allocated using malloc().
+extern THREAD_LOCAL uint8_t * TESTCODE_BASE;   // The first address in the TESTCODE range that is on a page boundary.
+extern THREAD_LOCAL uint8_t * TESTCODE_ANCHOR; // The halfway point in the TESTCODE range, also on a page boundary. Put test code here.
+
+#if defined(TIC_PLATFORM_GCC)
+
+// On the host, the TESTCODE block lives in a flat 64 KB image of the guest address space.
+// Its placement in guest memory can be chosen freely. Each thread has its own guest memory image.
+
+#define TESTCODE_GUEST_PAGE_DEFAULT 0x30
+
+extern THREAD_LOCAL uint8_t * GUEST_MEMORY; // The 64 KB guest memory image.
+
+#define GUEST_ADDRESS(ptr) ((uint16_t)((ptr) - GUEST_MEMORY))
+
+int allocate_guest_memory(void);
+void free_guest_memory(void);
+
+int allocate_testcode_block_at_guest_page(unsigned size, unsigned page);
+
+#else
+
+#define GUEST_ADDRESS(ptr) ((uint16_t)(ptr))
+
+#endif
 
 int allocate_testcode_block(unsigned size);
 void free_testcode_block(void);
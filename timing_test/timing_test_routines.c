@@ -3,6 +3,8 @@
 // timing_test_routines.c //
 ////////////////////////////
 
+#include <stddef.h>
+
 #include "timing_test_memory.h"
 #include "timing_test_measurement.h"
 #include "timing_test_routines.h"
@@ -21,12 +23,12 @@ unsigned LAST = 255;
 
 static uint8_t lsb(uint8_t * ptr)
 {
-    return (uint16_t)ptr & 0xff;
+    return GUEST_ADDRESS(ptr) & 0xff;
 }
 
 static uint8_t msb(uint8_t * ptr)
 {
-    return (uint16_t)ptr >> 8;
+    return GUEST_ADDRESS(ptr) >> 8;
 }
 
 static bool different_pages(uint8_t * u1, uint8_t * u2)
@@ -40,19 +42,15 @@ static bool different_pages(uint8_t * u1, uint8_t * u2)
 //                                                                                                                   //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#define OPC_BRK        0x00
 #define OPC_PHP        0x08
 #define OPC_ORA_IMM    0x09
-#define OPC_JSR_ABS    0x20
 #define OPC_PLP        0x28
 #define OPC_AND_IMM    0x29
-#define OPC_RTI        0x40
 #define OPC_PHA        0x48
 #define OPC_JMP_ABS    0x4c
+#define OPC_PHY        0x5a
 #define OPC_RTS        0x60
 #define OPC_PLA        0x68
-#define OPC_JMP_IND    0x6c
-#define OPC_JMP_IND_X  0x7c
 #define OPC_STY_ZP     0x84
 #define OPC_STA_ZP     0x85
 #define OPC_STX_ZP     0x86
@@ -64,1888 +62,478 @@ static bool different_pages(uint8_t * u1, uint8_t * u2)
 #define OPC_TAX        0xaa
 #define OPC_LDX_ABS    0xae
 #define OPC_TSX        0xba
+#define OPC_CLD        0xd8
+#define OPC_PHX        0xda
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                                                                                                   //
-//                                           HANDLE SKIPPED INSTRUCTIONS                                             //
-//                                                                                                                   //
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-bool timing_test_skip_instruction (const char * opcode_description, uint8_t opcode)
-{
-    (void)opcode;
-    prepare_opcode_tests_skip(opcode_description);
-    return true;
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//                                                                                                                   //
-//                           TIMING TESTS FOR SINGLE, DOUBLE, AND TRIPLE BYTE INSTRUCTION SEQUENCES                  //
+//                                              TEST FRAGMENT TEMPLATES                                              //
 //                                                                                                                   //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool timing_test_single_byte_instruction_sequence(const char * opcode_description, uint8_t opc, unsigned instruction_cycles)
-{
-    uint8_t * opcode_address;
+// A test fragment template is an array of uint16_t values, one for each byte of the fragment. Values 0x00..0xff
+// are literal bytes. The symbols below stand for bytes that depend on the opcode under test, on the placement of
+// the fragment (par1), or on the parameters par2..par4. Their meaning is given by the test's ParSpec.
 
-    prepare_opcode_tests(opcode_description, Par1_OpcodeOffset);
+#define T_OPCODE          0x100          // The opcode under test.
+#define T_PAR2            0x101          // The value of par2.
+#define T_PAR3            0x102          // The value of par3.
+#define T_PAR4            0x103          // The value of par4.
+#define T_ZPAGE_LO        0x104          // The zero page address of the pointer used for indirection.
+#define T_ZPAGE_HI        0x105          // The zero page address that follows it.
+#define T_ABS_LO          0x106          // The low byte of the absolute address (TESTCODE_BASE + offset parameter).
+#define T_ABS_HI          0x107          // The high byte of the absolute address.
+#define T_FRAGMENT_LO(k)  (0x200 | (k))  // The low byte of the address of byte k of the fragment.
+#define T_FRAGMENT_HI(k)  (0x300 | (k))  // The high byte of the address of byte k of the fragment.
 
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
+#define NUM_SYMBOL_VALUES 8 // Symbols 0x100 .. 0x107 take their value from the 'symbol_value' array.
+#define MAX_PATCHES       8 // The maximum number of fragment bytes that depend on par2..par4.
 
-    m_test_overhead_cycles = 0;
-    m_instruction_cycles = instruction_cycles;
+// Test flags.
 
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
+#define TF_ZPAGE_WRITE        0x01 // The instruction writes to its (direct) zero page address.
+#define TF_BRANCH_WHEN_SET    0x02 // The branch is taken when the flag or bit is set.
 
-        opcode_address[0] = opc;     // OPC
-        opcode_address[1] = OPC_RTS; // RTS [-]
+// The roles that the parameters par2..par4 can play, as determined by the ParSpec.
 
-        if (!execute_single_opcode_test(opcode_address, DEFAULT_RUN_FLAGS))
-            return false;
+#define ROLE_NONE        0 // The parameter is not used.
+#define ROLE_IMMEDIATE   1 // An immediate value.
+#define ROLE_ZPAGE       2 // A zero page address.
+#define ROLE_INDEX       3 // The value of the X or Y register, used for indexing.
+#define ROLE_ABS_OFFSET  4 // An offset in the TESTCODE area, used as an absolute address.
 
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                   //
+//                                            GENERIC FRAGMENT TEST ENGINE                                           //
+//                                                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool timing_test_two_byte_instruction_sequence(const char * opcode_description, uint8_t test_opcode_offset, uint8_t opc1, uint8_t opc2, unsigned test_overhead_cycles, unsigned instruction_cycles)
+// The engine writes the bytes of a test fragment that do not depend on par2..par4 only once for each placement
+// of the fragment (par1), and only patches the bytes that change in the inner loops. On the target, every store
+// to the fragment is a handful of 6502 instructions of compiled C, executed for every single measurement; this
+// bookkeeping is a large part of the time spent in a full test.
+
+// The innermost level adds its measurements to the measurement batch. Every measurement in the batch needs
+// its own copy of the fragment, as the copies are patched differently. The copies are a whole number of pages
+// apart, so they have the same timing. They stay clear of the data at TESTCODE_BASE .. TESTCODE_BASE + 510
+// that absolute addressing (with indexing) may touch.
+
+#define NUM_FRAGMENT_COPIES 4
+
+static const int16_t fragment_copy_offset[NUM_FRAGMENT_COPIES] = { 0, -256, 256, 512 };
+
+static THREAD_LOCAL uint8_t   num_levels;                    // The number of parameters used by the test (1..4).
+static THREAD_LOCAL uint8_t   role[6];                       // The roles of par2..par4 (indices 2..4; 5 is a sentinel).
+static THREAD_LOCAL uint8_t   zpage_level;                   // The level at which the zero page address is known; 0 if none.
+static THREAD_LOCAL uint8_t   instruction_cycles;            // The instruction cycles without page crossing.
+static THREAD_LOCAL uint8_t   page_cross_cycles;             // The extra cycles in case of a page crossing.
+static THREAD_LOCAL uint8_t   zpage_base;                    // The zero page address before indexing.
+static THREAD_LOCAL uint8_t * abs_address;                   // The absolute address before indexing.
+static THREAD_LOCAL uint8_t * fragment;                      // The first byte (and entry point) of the fragment.
+static THREAD_LOCAL uint8_t * fragment_copy[NUM_FRAGMENT_COPIES];
+static THREAD_LOCAL uint8_t   symbol_value[NUM_SYMBOL_VALUES];
+static THREAD_LOCAL uint8_t   patch_offset[MAX_PATCHES];     // Fragment bytes that depend on par2..par4, ordered by level.
+static THREAD_LOCAL uint8_t   patch_symbol[MAX_PATCHES];     // The symbol value index for each of these bytes.
+static THREAD_LOCAL uint8_t   level_patch_end[5];            // The patches for level L are [level_patch_end[L - 1], level_patch_end[L]).
+static THREAD_LOCAL uint8_t * inner_par;                     // The parameter (par2..par4) of the innermost level.
+static THREAD_LOCAL uint8_t   inner_offset;                  // The fragment byte patched by the innermost level.
+static THREAD_LOCAL uint8_t   inner_offset_hi;               // The second byte, for an absolute address (T_ABS_HI).
+
+static void set_parameter_roles(ParSpec parspec)
 {
-    uint8_t * opcode_address;
-
-    prepare_opcode_tests(opcode_description, Par1_OpcodeOffset);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
+    role[1] = ROLE_NONE;
+    role[2] = ROLE_NONE;
+    role[3] = ROLE_NONE;
+    role[4] = ROLE_NONE;
+    role[5] = ROLE_NONE;
 
-    m_test_overhead_cycles = test_overhead_cycles;
-    m_instruction_cycles   = instruction_cycles;
-
-    for (par1 = 0;;par1 += STEP_SIZE)
+    switch (parspec)
     {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        opcode_address[0 - (int)test_opcode_offset] = opc1;    // OPC
-        opcode_address[1 - (int)test_opcode_offset] = opc2;    // OPC
-        opcode_address[2 - (int)test_opcode_offset] = OPC_RTS; // RTS [-]
-
-        if (!execute_single_opcode_test(opcode_address - test_opcode_offset, DEFAULT_RUN_FLAGS))
-            return false;
-
-        if (par1 == LAST)
+        case Par12_OpcodeOffset_Immediate:
+            role[2] = ROLE_IMMEDIATE;
+            break;
+        case Par12_OpcodeOffset_ZPage:
+            role[2] = ROLE_ZPAGE;
+            break;
+        case Par12_OpcodeOffset_AbsOffset:
+            role[2] = ROLE_ABS_OFFSET;
+            break;
+        case Par123_OpcodeOffset_ZPage_XReg:
+        case Par123_OpcodeOffset_ZPage_YReg:
+            role[2] = ROLE_ZPAGE;
+            role[3] = ROLE_INDEX;
+            break;
+        case Par123_OpcodeOffset_AbsOffset_XReg:
+        case Par123_OpcodeOffset_AbsOffset_YReg:
+            role[2] = ROLE_ABS_OFFSET;
+            role[3] = ROLE_INDEX;
+            break;
+        case Par123_OpcodeOffset_ZPage_AbsOffset:
+            role[2] = ROLE_ZPAGE;
+            role[3] = ROLE_ABS_OFFSET;
+            break;
+        case Par1234_OpcodeOffset_ZPage_XReg_AbsOffset:
+            role[2] = ROLE_ZPAGE;
+            role[3] = ROLE_INDEX;
+            role[4] = ROLE_ABS_OFFSET;
+            break;
+        case Par1234_OpcodeOffset_ZPage_AbsOffset_YReg:
+            role[2] = ROLE_ZPAGE;
+            role[3] = ROLE_ABS_OFFSET;
+            role[4] = ROLE_INDEX;
+            break;
+        default:
             break;
     }
-    return true;
+
+    num_levels = 1;
+    while (num_levels < 4 && role[num_levels + 1] != ROLE_NONE)
+        ++num_levels;
 }
 
-bool timing_test_three_byte_instruction_sequence(const char * opcode_description, uint8_t test_opcode_offset, uint8_t opc1, uint8_t opc2, uint8_t opc3, unsigned test_overhead_cycles, unsigned instruction_cycles)
+static uint8_t symbol_level(uint16_t symbol, uint8_t abs_level)
 {
-    uint8_t * opcode_address;
-
-    prepare_opcode_tests(opcode_description, Par1_OpcodeOffset);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    m_test_overhead_cycles = test_overhead_cycles;
-    m_instruction_cycles   = instruction_cycles;
-
-    for (par1 = 0;;par1 += STEP_SIZE)
+    switch (symbol)
     {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        opcode_address[0 - (int)test_opcode_offset] = opc1;    // OPC
-        opcode_address[1 - (int)test_opcode_offset] = opc2;    // OPC
-        opcode_address[2 - (int)test_opcode_offset] = opc3;    // OPC
-        opcode_address[3 - (int)test_opcode_offset] = OPC_RTS; // RTS [-]
-
-        if (!execute_single_opcode_test(opcode_address - test_opcode_offset, DEFAULT_RUN_FLAGS))
-            return false;
-
-        if (par1 == LAST)
-            break;
+        case T_PAR2     : return 2;
+        case T_PAR3     : return 3;
+        case T_PAR4     : return 4;
+        case T_ZPAGE_LO :
+        case T_ZPAGE_HI : return zpage_level;
+        case T_ABS_LO   :
+        case T_ABS_HI   : return abs_level;
     }
-    return true;
+    return 1; // Literal bytes, the opcode, and fragment addresses only depend on the placement of the fragment.
 }
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//                                                                                                                   //
-//                                         TIMING TESTS FOR READ INSTRUCTIONS                                        //
-//                                                                                                                   //
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-bool timing_test_read_immediate_instruction(const char * opcode_description, uint8_t opcode)
+static uint8_t setup_fragment_test(const TimingTest * test)
 {
-    uint8_t * opcode_address;
+    // Prepare the engine state for the test. Returns the offset of the opcode under test in the fragment.
 
-    prepare_opcode_tests(opcode_description, Par12_OpcodeOffset_Immediate);
+    uint8_t level;
+    uint8_t abs_level;
+    uint8_t opcode_offset;
+    uint8_t k;
 
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
+    set_parameter_roles(test->parspec);
 
-    for (par1 = 0;;par1 += STEP_SIZE)
+    zpage_level = 0;
+    abs_level = 0;
+    zpage_base = 0; // An innermost zero page parameter is not indexed.
+
+    for (level = 2; level <= num_levels; ++level)
     {
-        opcode_address = TESTCODE_ANCHOR + par1;
+        if (role[level] == ROLE_ZPAGE)
+            zpage_level = (role[level + 1] == ROLE_INDEX) ? level + 1 : level;
+        else if (role[level] == ROLE_ABS_OFFSET)
+            abs_level = level;
+    }
 
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            opcode_address[0] = opcode;  // OPC #par2 [2]
-            opcode_address[1] = par2;    //
-            opcode_address[2] = OPC_RTS; // RTS       [-]
+    // Instructions with both a zero page address and an absolute address access memory via a pointer
+    // in the zero page, which the test code writes. Other instructions that access the zero page only
+    // need preservation if they write to it.
 
-            m_test_overhead_cycles = 0;
-            m_instruction_cycles = 2;
+    if (zpage_level != 0 && abs_level != 0)
+        select_zpage_preserve(2);
+    else if (zpage_level != 0 && (test->flags & TF_ZPAGE_WRITE) != 0)
+        select_zpage_preserve(1);
+    else
+        select_zpage_preserve(0);
 
-            if (!execute_single_opcode_test(opcode_address, DEFAULT_RUN_FLAGS))
-                return false;
+    m_test_overhead_cycles = test->test_overhead_cycles;
+    m_instruction_cycles = test->instruction_cycles;
 
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
+    instruction_cycles = test->instruction_cycles;
+    page_cross_cycles = test->page_cross_cycles;
 
-bool timing_test_read_zpage_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
+    // Make the list of fragment bytes to patch for each of the levels 2..4.
 
-    prepare_opcode_tests(opcode_description, Par12_OpcodeOffset_ZPage);
+    level_patch_end[0] = 0;
+    level_patch_end[1] = 0;
 
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
+    opcode_offset = 0;
 
-    for (par1 = 0;;par1 += STEP_SIZE)
+    for (level = 2; level <= 4; ++level)
     {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
+        level_patch_end[level] = level_patch_end[level - 1];
+        for (k = 0; k < test->fragment_size; ++k)
         {
-            if (zp_address_is_safe_for_read(par2))
+            if (test->fragment_template[k] == T_OPCODE)
+                opcode_offset = k;
+            if (symbol_level(test->fragment_template[k], abs_level) == level)
             {
-                opcode_address[0] = opcode;     // OPC par2        [3]
-                opcode_address[1] = par2;       //
-                opcode_address[2] = OPC_RTS;    // RTS             [-]
-
-                m_test_overhead_cycles = 0;
-                m_instruction_cycles = 3;
-
-                if (!execute_single_opcode_test(opcode_address, DEFAULT_RUN_FLAGS))
-                    return false;
+                patch_offset[level_patch_end[level]] = k;
+                patch_symbol[level_patch_end[level]] = test->fragment_template[k] - T_OPCODE;
+                ++level_patch_end[level];
             }
-            if (par2 == LAST)
-                break;
         }
-        if (par1 == LAST)
-            break;
     }
-    return true;
-}
-
-bool timing_test_read_zpage_x_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
 
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_ZPage_XReg);
+    // The innermost level patches one byte (T_PAR2..T_PAR4), or the two bytes of an absolute
+    // address (T_ABS_LO, T_ABS_HI); see 'run_innermost_level'.
 
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
+    inner_par = (num_levels == 2) ? &par2 : (num_levels == 3) ? &par3 : &par4;
 
-    for (par1 = 0;;par1 += STEP_SIZE)
+    for (k = level_patch_end[num_levels - 1]; k != level_patch_end[num_levels]; ++k)
     {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                if (zp_address_is_safe_for_read(par2 + par3))
-                {
-                    opcode_address[-2] = OPC_LDX_IMM; // LDX #par3        [2]
-                    opcode_address[-1] = par3;        //
-                    opcode_address[ 0] = opcode;      // OPC par2,X       [4]
-                    opcode_address[ 1] = par2;        //
-                    opcode_address[ 2] = OPC_RTS;     // RTS              [-]
-
-                    m_test_overhead_cycles = 2;
-                    m_instruction_cycles = 4;
-
-                    if (!execute_single_opcode_test(opcode_address - 2, DEFAULT_RUN_FLAGS))
-                        return false;
-                }
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
+        if (patch_symbol[k] == T_ABS_HI - T_OPCODE)
+            inner_offset_hi = patch_offset[k];
+        else
+            inner_offset = patch_offset[k];
     }
-    return true;
+
+    return opcode_offset;
 }
 
-bool timing_test_read_zpage_y_instruction(const char * opcode_description, uint8_t opcode)
+static void write_fragment(const TimingTest * test, uint8_t opcode)
 {
-    uint8_t * opcode_address;
+    // Write the bytes of the fragment copies that only depend on their placement.
 
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_ZPage_YReg);
+    uint8_t   c;
+    uint8_t   k;
+    uint8_t * copy;
+    uint16_t  symbol;
 
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
+    for (c = 0; c < NUM_FRAGMENT_COPIES; ++c)
     {
-        opcode_address = TESTCODE_ANCHOR + par1;
+        copy = fragment + fragment_copy_offset[c];
+        fragment_copy[c] = copy;
 
-        for (par2 = 0;;par2 += STEP_SIZE)
+        for (k = 0; k < test->fragment_size; ++k)
         {
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                if (zp_address_is_safe_for_read(par2 + par3))
-                {
-                    opcode_address[-2] = OPC_LDY_IMM;  // LDY #par3          [2]
-                    opcode_address[-1] = par3;         //
-                    opcode_address[ 0] = opcode;       // OPC par2,Y         [4]
-                    opcode_address[ 1] = par2;         //
-                    opcode_address[ 2] = OPC_RTS;      // RTS                [-]
-
-                    m_test_overhead_cycles = 2;
-                    m_instruction_cycles = 4;
-
-                    if (!execute_single_opcode_test(opcode_address - 2, DEFAULT_RUN_FLAGS))
-                        return false;
-                }
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
+            symbol = test->fragment_template[k];
+
+            if (symbol < 0x100)
+                copy[k] = symbol;
+            else if (symbol == T_OPCODE)
+                copy[k] = opcode;
+            else if ((symbol & 0xff00) == T_FRAGMENT_LO(0))
+                copy[k] = lsb(copy + (symbol & 0xff));
+            else if ((symbol & 0xff00) == T_FRAGMENT_HI(0))
+                copy[k] = msb(copy + (symbol & 0xff));
         }
-        if (par1 == LAST)
-            break;
     }
-    return true;
 }
 
-bool timing_test_read_abs_instruction(const char * opcode_description, uint8_t opcode)
+static bool enter_parameter_level(uint8_t level, uint8_t value)
 {
-    uint8_t * opcode_address;
+    // Process a new value of the parameter at the given level (2..4), and patch the fragment accordingly.
+    // Returns false if the parameter combination must be skipped because the zero page address is not safe.
 
-    prepare_opcode_tests(opcode_description, Par12_OpcodeOffset_AbsOffset);
+    uint8_t zpage_address;
+    uint8_t c;
+    uint8_t k;
 
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
+    symbol_value[level - 1] = value; // The T_PAR2 .. T_PAR4 values.
 
-    for (par1 = 0;;par1 += STEP_SIZE)
+    switch (role[level])
     {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            uint8_t * read_address = TESTCODE_BASE + par2;
-
-            opcode_address[0] = opcode;            // OPC read_address   [4]
-            opcode_address[1] = lsb(read_address); //
-            opcode_address[2] = msb(read_address); //
-            opcode_address[3] = OPC_RTS;           // RTS                [-]
-
-            m_test_overhead_cycles = 0;
-            m_instruction_cycles = 4;
-
-            if (!execute_single_opcode_test(opcode_address, DEFAULT_RUN_FLAGS))
-                return false;
-
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
+        case ROLE_ZPAGE:
+            zpage_base = value;
+            break;
+        case ROLE_INDEX:
+            if (role[level - 1] == ROLE_ABS_OFFSET && page_cross_cycles != 0)
+                m_instruction_cycles = instruction_cycles + (different_pages(abs_address, abs_address + value) ? page_cross_cycles : 0);
+            break;
+        case ROLE_ABS_OFFSET:
+            abs_address = TESTCODE_BASE + value;
+            symbol_value[T_ABS_LO - T_OPCODE] = lsb(abs_address);
+            symbol_value[T_ABS_HI - T_OPCODE] = msb(abs_address);
             break;
     }
-    return true;
-}
-
-#if defined(CPU_65C02)
-bool timing_test_read_abs_instruction_slow(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-
-    prepare_opcode_tests(opcode_description, Par12_OpcodeOffset_AbsOffset);
 
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
+    if (level == zpage_level)
     {
-        opcode_address = TESTCODE_ANCHOR + par1;
+        // Zero page indexing wraps around within the zero page.
+        zpage_address = (role[level] == ROLE_INDEX) ? zpage_base + value : zpage_base;
 
-        for (par2 = 0;;par2 += STEP_SIZE)
+        if (num_zpage_preserve == 2)
         {
-            uint8_t * read_address = TESTCODE_BASE + par2;
-
-            opcode_address[0] = opcode;            // OPC read_address   [4]
-            opcode_address[1] = lsb(read_address); //
-            opcode_address[2] = msb(read_address); //
-            opcode_address[3] = OPC_RTS;           // RTS                [-]
-
-            m_test_overhead_cycles = 0;
-            m_instruction_cycles = 8; // Unique for instruction 0x5C on the 65C02.
-
-            if (!execute_single_opcode_test(opcode_address, DEFAULT_RUN_FLAGS))
+            if (!(zp_address_is_safe_for_write(zpage_address) && zp_address_is_safe_for_write(zpage_address + 1)))
                 return false;
 
-            if (par2 == LAST)
-                break;
+            zpage_preserve[0] = zpage_address;
+            zpage_preserve[1] = zpage_address + 1;
         }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-#endif
-
-bool timing_test_read_abs_x_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_XReg);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
+        else if (num_zpage_preserve == 1)
         {
-            uint8_t * base_address = TESTCODE_BASE + par2;
+            if (!zp_address_is_safe_for_write(zpage_address))
+                return false;
 
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                opcode_address[-2] = OPC_LDX_IMM;       // LDX #par3            [2]
-                opcode_address[-1] = par3;              //
-                opcode_address[ 0] = opcode;            // OPC base_address,X   [4 or 5]
-                opcode_address[ 1] = lsb(base_address); //
-                opcode_address[ 2] = msb(base_address); //
-                opcode_address[ 3] = OPC_RTS;           // RTS                  [-]
+            zpage_preserve[0] = zpage_address;
+        }
+        else if (!zp_address_is_safe_for_read(zpage_address))
+            return false;
 
-                m_test_overhead_cycles = 2;
-                m_instruction_cycles = 4 + different_pages(base_address, base_address + par3);
+        symbol_value[T_ZPAGE_LO - T_OPCODE] = zpage_address;
+        symbol_value[T_ZPAGE_HI - T_OPCODE] = zpage_address + 1;
+    }
 
-                if (!execute_single_opcode_test(opcode_address - 2, DEFAULT_RUN_FLAGS))
-                    return false;
+    for (c = 0; c < NUM_FRAGMENT_COPIES; ++c)
+        for (k = level_patch_end[level - 1]; k != level_patch_end[level]; ++k)
+            fragment_copy[c][patch_offset[k]] = symbol_value[patch_symbol[k]];
 
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
     return true;
 }
 
-bool timing_test_read_abs_y_instruction(const char * opcode_description, uint8_t opcode)
+static bool add_fragment_measurement(uint8_t * copy)
 {
-    uint8_t * opcode_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_YReg);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            uint8_t * base_address = TESTCODE_BASE + par2;
-
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                opcode_address[-2] = OPC_LDY_IMM;        // LDY #par3            [2]
-                opcode_address[-1] = par3;               //
-                opcode_address[ 0] = opcode;             // OPC base_address,Y   [4 or 5]
-                opcode_address[ 1] = lsb(base_address);  //
-                opcode_address[ 2] = msb(base_address);  //
-                opcode_address[ 3] = OPC_RTS;            // RTS                  [-]
+    // Add a measurement of a fragment copy to the batch. The batch is executed when all copies are in use.
 
-                m_test_overhead_cycles = 2;
-                m_instruction_cycles = 4 + different_pages(base_address, base_address + par3);
+    if (!add_batch_opcode_test(copy, DEFAULT_RUN_FLAGS))
+        return false;
 
-                if (!execute_single_opcode_test(opcode_address - 2, DEFAULT_RUN_FLAGS))
-                    return false;
+    if (measurement_batch.count == NUM_FRAGMENT_COPIES)
+        return execute_batch_opcode_tests(DEFAULT_RUN_FLAGS);
 
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
     return true;
 }
 
-
-bool timing_test_read_abs_y_instruction_save_sp(const char * opcode_description, uint8_t opcode)
+static bool run_innermost_level(void)
 {
-    uint8_t * opcode_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_YReg);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            uint8_t * base_address = TESTCODE_BASE + par2;
-
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                opcode_address[-6] = OPC_TSX;                  // TSX          [2]
-                opcode_address[-5] = OPC_STX_ABS;              // STX save_sp  [4]
-                opcode_address[-4] = lsb(opcode_address + 8);  //
-                opcode_address[-3] = msb(opcode_address + 8);  //
-                opcode_address[-2] = OPC_LDY_IMM;              // LDY #par3     2]
-                opcode_address[-1] = par3;                     //
-                opcode_address[ 0] = opcode;                   // OPC base_address,Y   [4 or 5]
-                opcode_address[ 1] = lsb(base_address);        //
-                opcode_address[ 2] = msb(base_address);        //
-                opcode_address[ 3] = OPC_LDX_ABS;              // LDX save_sp  [4]
-                opcode_address[ 4] = lsb(opcode_address + 8);  //
-                opcode_address[ 5] = msb(opcode_address + 8);  //
-                opcode_address[ 6] = OPC_TXS;                  // TXS          [2]
-                opcode_address[ 7] = OPC_RTS;                  // RTS          [-]
-
-                m_test_overhead_cycles = 2 + 4 + 2 + 4 + 2;
-                m_instruction_cycles = 4 + different_pages(base_address, base_address + par3);
-
-                if (!execute_single_opcode_test(opcode_address - 6, DEFAULT_RUN_FLAGS))
-                    return false;
-
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_read_zpage_x_indirect_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t   zp_ptr_lo;
-    uint8_t   zp_ptr_hi;
-    uint8_t * abs_address;
-
-    prepare_opcode_tests(opcode_description, Par1234_OpcodeOffset_ZPage_XReg_AbsOffset);
-
-    num_zpage_preserve = 2; // This test *DOES* require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                // (zp_ptr_lo, zp_ptr_hi) will be the actual pointer used for indirection.
-                zp_ptr_lo = par2 + par3;
-                zp_ptr_hi = zp_ptr_lo + 1;
-
-                if (zp_address_is_safe_for_write(zp_ptr_lo) && zp_address_is_safe_for_write(zp_ptr_hi))
-                {
-                    zpage_preserve[0] = zp_ptr_lo;
-                    zpage_preserve[1] = zp_ptr_hi;
-
-                    for (par4 = 0;;par4 += STEP_SIZE)
-                    {
-                        abs_address = TESTCODE_BASE + par4;
-
-                        opcode_address[-10] = OPC_LDX_IMM;       // LDX #<abs_address     [2]
-                        opcode_address[ -9] = lsb(abs_address);  //
-                        opcode_address[ -8] = OPC_STX_ZP;        // STX zp_ptr_lo         [3]
-                        opcode_address[ -7] = zp_ptr_lo;         //
-                        opcode_address[ -6] = OPC_LDX_IMM;       // LDX #>abs_address     [2]
-                        opcode_address[ -5] = msb(abs_address);  //
-                        opcode_address[ -4] = OPC_STX_ZP;        // STX zp_ptr_lo         [3]
-                        opcode_address[ -3] = zp_ptr_lo;         //
-                        opcode_address[ -2] = OPC_LDX_IMM;       // LDX #par3             [2]
-                        opcode_address[ -1] = par3;              //
-                        opcode_address[  0] = opcode;            // OPC (zpage, X)        [6]
-                        opcode_address[  1] = par2;              //
-                        opcode_address[  2] = OPC_RTS;           // RTS                   [-]
-
-                        m_test_overhead_cycles = 2 + 3 + 2 + 3 + 2;
-                        m_instruction_cycles = 6;
-
-                        if (!execute_single_opcode_test(opcode_address - 10, DEFAULT_RUN_FLAGS))
-                            return false;
-
-                        if (par4 == LAST)
-                            break;
-                    }
-                }
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_read_zpage_indirect_y_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t   zp_ptr_lo;
-    uint8_t   zp_ptr_hi;
-    uint8_t * base_address;
-
-    prepare_opcode_tests(opcode_description, Par1234_OpcodeOffset_ZPage_AbsOffset_YReg);
-
-    num_zpage_preserve = 2; // This test *DOES* require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            zp_ptr_lo = par2;
-            zp_ptr_hi = zp_ptr_lo + 1;
-
-            if (zp_address_is_safe_for_write(zp_ptr_lo) && zp_address_is_safe_for_write(zp_ptr_hi))
-            {
-                zpage_preserve[0] = zp_ptr_lo;
-                zpage_preserve[1] = zp_ptr_hi;
-
-                for (par3 = 0;;par3 += STEP_SIZE)
-                {
-                    base_address = TESTCODE_BASE + par3;
-
-                    for (par4 = 0;;par4 += STEP_SIZE)
-                    {
-                        opcode_address[-10] = OPC_LDY_IMM;        // LDY #<base_address    [2]
-                        opcode_address[ -9] = lsb(base_address);  //
-                        opcode_address[ -8] = OPC_STY_ZP;         // STY zp_ptr_lo         [3]
-                        opcode_address[ -7] = zp_ptr_lo;          //
-                        opcode_address[ -6] = OPC_LDY_IMM;        // LDY #>base_address    [2]
-                        opcode_address[ -5] = msb(base_address);  //
-                        opcode_address[ -4] = OPC_STY_ZP;         // STY zp_ptr_hi         [3]
-                        opcode_address[ -3] = zp_ptr_hi;          //
-                        opcode_address[ -2] = OPC_LDY_IMM;        // LDY #par4             [2]
-                        opcode_address[ -1] = par4;               //
-                        opcode_address[  0] = opcode;             // OPC (zpage), Y        [5 or 6]
-                        opcode_address[  1] = zp_ptr_lo;          //
-                        opcode_address[  2] = OPC_RTS;            // RTS                   [-]
-
-                        m_test_overhead_cycles = 2 + 3 + 2 + 3 + 2;
-                        m_instruction_cycles = 5 + different_pages(base_address, base_address + par4);
-
-                        if (!execute_single_opcode_test(opcode_address - 10, DEFAULT_RUN_FLAGS))
-                            return false;
-
-                        if (par4 == LAST)
-                            break;
-                    }
-                    if (par3 == LAST)
-                        break;
-                }
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-#if defined(CPU_65C02)
-bool timing_test_read_zpage_indirect_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t   zp_ptr_lo;
-    uint8_t   zp_ptr_hi;
-    uint8_t * effective_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_ZPage_AbsOffset);
-
-    num_zpage_preserve = 2; // This test *DOES* require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            zp_ptr_lo = par2;
-            zp_ptr_hi = zp_ptr_lo + 1;
-
-            if (zp_address_is_safe_for_write(zp_ptr_lo) && zp_address_is_safe_for_write(zp_ptr_hi))
-            {
-                zpage_preserve[0] = zp_ptr_lo;
-                zpage_preserve[1] = zp_ptr_hi;
-
-                for (par3 = 0;;par3 += STEP_SIZE)
-                {
-                    effective_address = TESTCODE_BASE + par3;
-
-                    opcode_address[-8] = OPC_LDA_IMM;             // LDA #<base_address    [2]
-                    opcode_address[-7] = lsb(effective_address);  //
-                    opcode_address[-6] = OPC_STA_ZP;              // STA zp_ptr_lo         [3]
-                    opcode_address[-5] = zp_ptr_lo;               //
-                    opcode_address[-4] = OPC_LDA_IMM;             // LDA #>base_address    [2]
-                    opcode_address[-3] = msb(effective_address);  //
-                    opcode_address[-2] = OPC_STA_ZP;              // STA zp_ptr_hi         [3]
-                    opcode_address[-1] = zp_ptr_hi;               //
-                    opcode_address[ 0] = opcode;                  // OPC (zpage)           [5]
-                    opcode_address[ 1] = zp_ptr_lo;               //
-                    opcode_address[ 2] = OPC_RTS;                 // RTS                   [-]
-
-                    m_test_overhead_cycles = 2 + 3 + 2 + 3;
-                    m_instruction_cycles = 5;
-
-                    if (!execute_single_opcode_test(opcode_address - 8, DEFAULT_RUN_FLAGS))
-                        return false;
-
-                    if (par3 == LAST)
-                        break;
-                }
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-#endif
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//                                                                                                                   //
-//                                        TIMING TESTS FOR WRITE INSTRUCTIONS                                        //
-//                                                                                                                   //
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-bool timing_test_write_zpage_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-
-    prepare_opcode_tests(opcode_description, Par12_OpcodeOffset_ZPage);
-
-    num_zpage_preserve = 1; // This test *DOES* require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            if (zp_address_is_safe_for_write(par2))
-            {
-                zpage_preserve[0] = par2;
-
-                opcode_address[0] = opcode;  // OPC par2   [3]
-                opcode_address[1] = par2;    //
-                opcode_address[2] = OPC_RTS; // RTS        [-]
-
-                m_test_overhead_cycles = 0;
-                m_instruction_cycles = 3;
-
-                if (!execute_single_opcode_test(opcode_address, DEFAULT_RUN_FLAGS))
-                    return false;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_write_zpage_x_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_ZPage_XReg);
-
-    num_zpage_preserve = 1; // This test *DOES* require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                if (zp_address_is_safe_for_write(par2 + par3))
-                {
-                    zpage_preserve[0] = par2 + par3;
-
-                    opcode_address[-2] = OPC_LDX_IMM;  // LDX #imm       [2]
-                    opcode_address[-1] = par3;         //
-                    opcode_address[ 0] = opcode;       // OPC par2,X     [4]
-                    opcode_address[ 1] = par2;         //
-                    opcode_address[ 2] = OPC_RTS;      // RTS            [1]
-
-                    m_test_overhead_cycles = 2;
-                    m_instruction_cycles = 4;
-
-                    if (!execute_single_opcode_test(opcode_address - 2, DEFAULT_RUN_FLAGS))
-                        return false;
-                }
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_write_zpage_y_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_ZPage_YReg);
-
-    num_zpage_preserve = 1; // This test *DOES* require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                if (zp_address_is_safe_for_write(par2 + par3))
-                {
-                    zpage_preserve[0] = par2 + par3;
-
-                    opcode_address[-2] = OPC_LDY_IMM;  // LDY #imm    [2]
-                    opcode_address[-1] = par3;         //
-                    opcode_address[ 0] = opcode;       // OPC par2,Y  [4]
-                    opcode_address[ 1] = par2;         //
-                    opcode_address[ 2] = OPC_RTS;      // RTS         [-]
-
-                    m_test_overhead_cycles = 2;
-                    m_instruction_cycles = 4;
-
-                    if (!execute_single_opcode_test(opcode_address - 2, DEFAULT_RUN_FLAGS))
-                        return false;
-                }
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_write_abs_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t * write_address;
-
-    prepare_opcode_tests(opcode_description, Par12_OpcodeOffset_AbsOffset);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            write_address = TESTCODE_BASE + par2;
-
-            opcode_address[0] = opcode;              // OPC write_address   [4]
-            opcode_address[1] = lsb(write_address);  //
-            opcode_address[2] = msb(write_address);  //
-            opcode_address[3] = OPC_RTS;             // RTS                 [-]
-
-            m_test_overhead_cycles = 0;
-            m_instruction_cycles = 4;
-
-            if (!execute_single_opcode_test(opcode_address, DEFAULT_RUN_FLAGS))
-                return false;
-
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_write_abs_x_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t * base_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_XReg);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            base_address = TESTCODE_BASE + par2;
-
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                opcode_address[-2] = OPC_LDX_IMM;        // LDX #par3            [2]
-                opcode_address[-1] = par3;               //
-                opcode_address[ 0] = opcode;             // OPC base_address,X   [5]
-                opcode_address[ 1] = lsb(base_address);  //
-                opcode_address[ 2] = msb(base_address);  //
-                opcode_address[ 3] = OPC_RTS;            // RTS                  [-]
-
-                m_test_overhead_cycles = 2;
-                m_instruction_cycles = 5;
-
-                if (!execute_single_opcode_test(opcode_address - 2, DEFAULT_RUN_FLAGS))
-                    return false;
-
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-#if defined (CPU_6502)
-bool timing_test_write_abs_x_instruction_shy_absx(const char * opcode_description, uint8_t opcode)
-{
-    // This is a special variant of the 'timing_test_write_abs_x_instruction' function, to test
-    // illegal opcode 0x9c: SHY abs,x.
-    //
-    // The difficulty with this opcode is that in case of a page crossing due to the X indexing, the high
-    // byte of the effective address is (base_addr_hi + 1), but ANDed with register Y (!?!).
-    //
-    // We deal with this by making sure Y is 0xff when the instruction is executed.
-
-    uint8_t * opcode_address;
-    uint8_t * base_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_YReg);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            base_address = TESTCODE_BASE + par2;
-
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                opcode_address[-4] = OPC_LDY_IMM;        // LDY #$ff             [2]
-                opcode_address[-3] = 0xff;               //
-                opcode_address[-2] = OPC_LDX_IMM;        // LDX #par3            [2]
-                opcode_address[-1] = par3;               //
-                opcode_address[ 0] = opcode;             // OPC base_address,X   [5]
-                opcode_address[ 1] = lsb(base_address);  //
-                opcode_address[ 2] = msb(base_address);  //
-                opcode_address[ 3] = OPC_RTS;            // RTS                  [-]
-
-                m_test_overhead_cycles = 2 + 2;
-                m_instruction_cycles = 5;
-
-                if (!execute_single_opcode_test(opcode_address - 4, DEFAULT_RUN_FLAGS))
-                    return false;
-
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-#endif
-
-bool timing_test_write_abs_y_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t * base_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_YReg);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            base_address = TESTCODE_BASE + par2;
-
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                opcode_address[-2] = OPC_LDY_IMM;        // LDY #par3            [2]
-                opcode_address[-1] = par3;               //
-                opcode_address[ 0] = opcode;             // OPC base_address,Y   [5]
-                opcode_address[ 1] = lsb(base_address);  //
-                opcode_address[ 2] = msb(base_address);  //
-                opcode_address[ 3] = OPC_RTS;            // RTS                  [-]
-
-                m_test_overhead_cycles = 2;
-                m_instruction_cycles = 5;
-
-                if (!execute_single_opcode_test(opcode_address - 2, DEFAULT_RUN_FLAGS))
-                    return false;
-
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-#if defined (CPU_6502)
-bool timing_test_write_abs_y_instruction_shx_absy(const char * opcode_description, uint8_t opcode)
-{
-    // This is a special variant of the 'timing_test_write_abs_y_instruction' function, to test
-    // illegal opcode 0x9d: SHX abs,y.
-    //
-    // The difficulty with this opcode is that in case of a page crossing due to the Y indexing, the high
-    // byte of the effective address is (base_addr_hi + 1), but ANDed with register X (!?!).
-    //
-    // We deal with this by making sure X is 0xff when the instruction is executed.
-
-    uint8_t * opcode_address;
-    uint8_t * base_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_YReg);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            base_address = TESTCODE_BASE + par2;
-
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                opcode_address[-4] = OPC_LDX_IMM;        // LDX #$ff             [2]
-                opcode_address[-3] = 0xff;               //
-                opcode_address[-2] = OPC_LDY_IMM;        // LDY #par3            [2]
-                opcode_address[-1] = par3;               //
-                opcode_address[ 0] = opcode;             // OPC base_address,Y   [5]
-                opcode_address[ 1] = lsb(base_address);  //
-                opcode_address[ 2] = msb(base_address);  //
-                opcode_address[ 3] = OPC_RTS;            // RTS                  [-]
-
-                m_test_overhead_cycles = 2 + 2;
-                m_instruction_cycles = 5;
-
-                if (!execute_single_opcode_test(opcode_address - 4, DEFAULT_RUN_FLAGS))
-                    return false;
-
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-#endif
-
-#if defined (CPU_6502)
-bool timing_test_write_abs_y_instruction_sha_absy(const char * opcode_description, uint8_t opcode)
-{
-    // This is a special variant of the 'timing_test_write_abs_y_instruction' function, to test
-    // illegal opcode 0x9f: SHA abs,y.
-    //
-    // The difficulty with this opcode is that in case of a page crossing due to the Y indexing, the high
-    // byte of the effective address is (base_addr_hi + 1), but ANDed with registers A and X (!?!).
-    //
-    // We deal with this by making sure A and X are both 0xff when the instruction is executed.
-
-    uint8_t * opcode_address;
-    uint8_t * base_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_YReg);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            base_address = TESTCODE_BASE + par2;
-
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                opcode_address[-5] = OPC_LDA_IMM;        // LDA #$ff             [2]
-                opcode_address[-4] = 0xff;               //
-                opcode_address[-3] = OPC_TAX;            // TAX                  [2]
-                opcode_address[-2] = OPC_LDY_IMM;        // LDY #par3            [2]
-                opcode_address[-1] = par3;               //
-                opcode_address[ 0] = opcode;             // OPC base_address,Y   [5]
-                opcode_address[ 1] = lsb(base_address);  //
-                opcode_address[ 2] = msb(base_address);  //
-                opcode_address[ 3] = OPC_RTS;            // RTS                  [-]
-
-                m_test_overhead_cycles = 2 + 2 + 2;
-                m_instruction_cycles = 5;
-
-                if (!execute_single_opcode_test(opcode_address - 5, DEFAULT_RUN_FLAGS))
-                    return false;
-
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-#endif
-
-#if defined (CPU_6502)
-bool timing_test_write_abs_y_instruction_tas_absy(const char * opcode_description, uint8_t opcode)
-{
-    // This is a special variant of the 'timing_test_write_abs_y_instruction_tas_absy' function, to test
-    // illegal opcode 0x9f: TAS abs,y.
-    //
-    // The difficulty with this opcode is that in case of a page crossing due to the Y indexing, the high
-    // byte of the effective address is (base_addr_hi + 1), but ANDed with registers A and X (!?!).
-    //
-    // We deal with this by making sure A and X are both 0xff when the instruction is executed.
-    //
-    // Furthermore, this instruction changes the S register. To deal with that, we save its initial
-    // value and restore it afterwards.
-
-    uint8_t * opcode_address;
-    uint8_t * base_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_YReg);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            base_address = TESTCODE_BASE + par2;
-
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                opcode_address[-9] = OPC_TSX;            // TSX                  [2]
-                opcode_address[-8] = OPC_STX_ABS;        // STX save_sp          [4]
-                opcode_address[-7] = lsb(opcode_address + 8);
-                opcode_address[-6] = msb(opcode_address + 8);
-                opcode_address[-5] = OPC_LDA_IMM;        // LDA #$ff             [2]
-                opcode_address[-4] = 0xff;               //
-                opcode_address[-3] = OPC_TAX;            // TAX                  [2]
-                opcode_address[-2] = OPC_LDY_IMM;        // LDY #par3            [2]
-                opcode_address[-1] = par3;               //
-                opcode_address[ 0] = opcode;             // OPC base_address,Y   [5]
-                opcode_address[ 1] = lsb(base_address);  //
-                opcode_address[ 2] = msb(base_address);  //
-                opcode_address[ 3] = OPC_LDX_ABS;        // LDX save_sp          [4]
-                opcode_address[ 4] = lsb(opcode_address + 8);
-                opcode_address[ 5] = msb(opcode_address + 8);
-                opcode_address[ 6] = OPC_TXS;            // TXS                  [2]
-                opcode_address[ 7] = OPC_RTS;            // RTS                  [-]
-
-                m_test_overhead_cycles = 2 + 4 + 2 + 2 + 2 + 4 + 2;
-                m_instruction_cycles = 5;
-
-                if (!execute_single_opcode_test(opcode_address - 9, DEFAULT_RUN_FLAGS))
-                    return false;
-
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-#endif
-
-bool timing_test_write_abs_y_instruction_save_sp(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t * base_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_YReg);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            base_address = TESTCODE_BASE + par2;
-
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                opcode_address[-6] = OPC_TSX;                  // TSX          [2]
-                opcode_address[-5] = OPC_STX_ABS;              // STX save_sp  [4]
-                opcode_address[-4] = lsb(opcode_address + 8);  //
-                opcode_address[-3] = msb(opcode_address + 8);  //
-                opcode_address[-2] = OPC_LDY_IMM;              // LDY #imm     [2]
-                opcode_address[-1] = par3;                     //
-                opcode_address[ 0] = opcode;                   // OPC base_address,Y   [5]
-                opcode_address[ 1] = lsb(base_address);        //
-                opcode_address[ 2] = msb(base_address);        //
-                opcode_address[ 3] = OPC_LDX_ABS;              // LDX save_sp  [4]
-                opcode_address[ 4] = lsb(opcode_address + 8);  //
-                opcode_address[ 5] = msb(opcode_address + 8);  //
-                opcode_address[ 6] = OPC_TXS;                  // TXS          [2]
-                opcode_address[ 7] = OPC_RTS;                  // RTS          [-]
-
-                m_test_overhead_cycles = 2 + 4 + 2 + 4 + 2;
-                m_instruction_cycles = 5;
-
-                if (!execute_single_opcode_test(opcode_address - 6, DEFAULT_RUN_FLAGS))
-                    return false;
-
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_write_zpage_x_indirect_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t   zp_ptr_lo;
-    uint8_t   zp_ptr_hi;
-    uint8_t * abs_address;
-
-    prepare_opcode_tests(opcode_description, Par1234_OpcodeOffset_ZPage_XReg_AbsOffset);
-
-    num_zpage_preserve = 2; // This test *DOES* require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                // (zp_ptr_lo, zp_ptr_hi) will be the actual pointer used for indirection.
-                zp_ptr_lo = par2 + par3;
-                zp_ptr_hi = zp_ptr_lo + 1;
-
-                if (zp_address_is_safe_for_write(zp_ptr_lo) && zp_address_is_safe_for_write(zp_ptr_hi))
-                {
-                    zpage_preserve[0] = zp_ptr_lo;
-                    zpage_preserve[1] = zp_ptr_hi;
-
-                    for (par4 = 0;;par4 += STEP_SIZE)
-                    {
-                        abs_address = TESTCODE_BASE + par4;
-
-                        opcode_address[-10] = OPC_LDX_IMM;       // LDX #<abs_address     [2]
-                        opcode_address[ -9] = lsb(abs_address);  //
-                        opcode_address[ -8] = OPC_STX_ZP;        // STX zp_ptr_lo [3]
-                        opcode_address[ -7] = zp_ptr_lo;         //
-                        opcode_address[ -6] = OPC_LDX_IMM;       // LDX #>abs_address     [2]
-                        opcode_address[ -5] = msb(abs_address);  //
-                        opcode_address[ -4] = OPC_STX_ZP;        // STX zp_ptr_hi [3]
-                        opcode_address[ -3] = zp_ptr_hi;         //
-                        opcode_address[ -2] = OPC_LDX_IMM;       // LDX #par3             [2]
-                        opcode_address[ -1] = par3;              //
-                        opcode_address[  0] = opcode;            // OPC (zpage, X)        [6]
-                        opcode_address[  1] = par2;              //
-                        opcode_address[  2] = OPC_RTS;           // RTS                   [-]
-
-                        m_test_overhead_cycles = 2 + 3 + 2 + 3 + 2;
-                        m_instruction_cycles = 6;
-
-                        if (!execute_single_opcode_test(opcode_address - 10, DEFAULT_RUN_FLAGS))
-                            return false;
-
-                        if (par4 == LAST)
-                            break;
-                    }
-                }
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_write_zpage_indirect_y_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t   zp_ptr_lo;
-    uint8_t   zp_ptr_hi;
-
-    prepare_opcode_tests(opcode_description, Par1234_OpcodeOffset_ZPage_AbsOffset_YReg);
-
-    num_zpage_preserve = 2; // This test *DOES* require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            zp_ptr_lo = par2;
-            zp_ptr_hi = zp_ptr_lo + 1;
-
-            if (zp_address_is_safe_for_write(zp_ptr_lo) && zp_address_is_safe_for_write(zp_ptr_hi))
-            {
-                zpage_preserve[0] = zp_ptr_lo;
-                zpage_preserve[1] = zp_ptr_hi;
-
-                for (par3 = 0;;par3 += STEP_SIZE)
-                {
-                    uint8_t * base_address = TESTCODE_BASE + par3;
-
-                    for (par4 = 0;;par4 += STEP_SIZE)
-                    {
-                        opcode_address[-10] = OPC_LDY_IMM;        // LDY #<base_address    [2]
-                        opcode_address[ -9] = lsb(base_address);  //
-                        opcode_address[ -8] = OPC_STY_ZP;         // STY zp_ptr_lo         [3]
-                        opcode_address[ -7] = zp_ptr_lo;          //
-                        opcode_address[ -6] = OPC_LDY_IMM;        // LDY #>base_address    [2]
-                        opcode_address[ -5] = msb(base_address);  //
-                        opcode_address[ -4] = OPC_STY_ZP;         // STY zp_ptr_hi         [3]
-                        opcode_address[ -3] = zp_ptr_hi;          //
-                        opcode_address[ -2] = OPC_LDY_IMM;        // LDY #par4             [2]
-                        opcode_address[ -1] = par4;               //
-                        opcode_address[  0] = opcode;             // OPC (zpage), Y        [6]
-                        opcode_address[  1] = zp_ptr_lo;          //
-                        opcode_address[  2] = OPC_RTS;            // RTS                   [-]
-
-                        m_test_overhead_cycles = 2 + 3 + 2 + 3 + 2;
-                        m_instruction_cycles = 6;
-
-                        if (!execute_single_opcode_test(opcode_address - 10, DEFAULT_RUN_FLAGS))
-                            return false;
-
-                        if (par4 == LAST)
-                            break;
-                    }
-                    if (par3 == LAST)
-                        break;
-                }
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-#if defined(CPU_6502)
-bool timing_test_write_zpage_indirect_y_instruction_sha_zpy(const char * opcode_description, uint8_t opcode)
-{
-    // This is a special variant of the 'timing_test_write_zpage_indirect_y_instruction' function, to test
-    // illegal opcode 0x93: SHA (zp),y.
-    //
-    // The difficulty with this opcode is that in case of a page crossing due to the Y indexing, the high
-    // byte of the effective address is (base_addr_hi + 1), but ANDed with registers A and X (!?!).
+    // Run the measurements for all values of the innermost parameter.
     //
-    // We deal with this by making sure A and X are both 0xff when the instruction is executed.
-
-    uint8_t * opcode_address;
-    uint8_t   zp_ptr_lo;
-    uint8_t   zp_ptr_hi;
-
-    prepare_opcode_tests(opcode_description, Par1234_OpcodeOffset_ZPage_AbsOffset_YReg);
-
-    num_zpage_preserve = 2; // This test *DOES* require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            zp_ptr_lo = par2;
-            zp_ptr_hi = zp_ptr_lo + 1;
-
-            if (zp_address_is_safe_for_write(zp_ptr_lo) && zp_address_is_safe_for_write(zp_ptr_hi))
-            {
-                zpage_preserve[0] = zp_ptr_lo;
-                zpage_preserve[1] = zp_ptr_hi;
-
-                for (par3 = 0;;par3 += STEP_SIZE)
-                {
-                    uint8_t * base_address = TESTCODE_BASE + par3;
-
-                    for (par4 = 0;;par4 += STEP_SIZE)
-                    {
-                        opcode_address[-13] = OPC_LDA_IMM;        // LDA #$ff              [2]
-                        opcode_address[-12] = 0xff;               //
-                        opcode_address[-11] = OPC_TAX;            // TAX                   [2]
-                        opcode_address[-10] = OPC_LDY_IMM;        // LDY #<base_address    [2]
-                        opcode_address[ -9] = lsb(base_address);  //
-                        opcode_address[ -8] = OPC_STY_ZP;         // STY zp_ptr_lo         [3]
-                        opcode_address[ -7] = zp_ptr_lo;          //
-                        opcode_address[ -6] = OPC_LDY_IMM;        // LDY #>base_address    [2]
-                        opcode_address[ -5] = msb(base_address);  //
-                        opcode_address[ -4] = OPC_STY_ZP;         // STY zp_ptr_hi         [3]
-                        opcode_address[ -3] = zp_ptr_hi;          //
-                        opcode_address[ -2] = OPC_LDY_IMM;        // LDY #par4             [2]
-                        opcode_address[ -1] = par4;               //
-
-                        opcode_address[  0] = opcode;             // OPC (zpage), Y        [6]
-                        opcode_address[  1] = zp_ptr_lo;          //
-                        opcode_address[  2] = OPC_RTS;            // RTS                   [-]
-
-                        m_test_overhead_cycles = 2 + 2 + 2 + 3 + 2 + 3 + 2;
-                        m_instruction_cycles = 6;
-
-                        if (!execute_single_opcode_test(opcode_address - 13, DEFAULT_RUN_FLAGS))
-                            return false;
-
-                        if (par4 == LAST)
-                            break;
-                    }
-                    if (par3 == LAST)
-                        break;
-                }
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-#endif
-
-
-#if defined(CPU_65C02)
-bool timing_test_write_zpage_indirect_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t   zp_ptr_lo;
-    uint8_t   zp_ptr_hi;
-    uint8_t * effective_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_ZPage_AbsOffset);
-
-    num_zpage_preserve = 2; // This test *DOES* require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            zp_ptr_lo = par2;
-            zp_ptr_hi = zp_ptr_lo + 1;
-
-            if (zp_address_is_safe_for_write(zp_ptr_lo) && zp_address_is_safe_for_write(zp_ptr_hi))
-            {
-                zpage_preserve[0] = zp_ptr_lo;
-                zpage_preserve[1] = zp_ptr_hi;
-
-                for (par3 = 0;;par3 += STEP_SIZE)
-                {
-                    effective_address = TESTCODE_BASE + par3;
-
-                    opcode_address[-8] = OPC_LDA_IMM;             // LDA #<base_address    [2]
-                    opcode_address[-7] = lsb(effective_address);  //
-                    opcode_address[-6] = OPC_STA_ZP;              // STA zp_ptr_lo         [3]
-                    opcode_address[-5] = zp_ptr_lo;               //
-                    opcode_address[-4] = OPC_LDA_IMM;             // LDA #>base_address    [2]
-                    opcode_address[-3] = msb(effective_address);  //
-                    opcode_address[-2] = OPC_STA_ZP;              // STA zp_ptr_hi         [3]
-                    opcode_address[-1] = zp_ptr_hi;               //
-                    opcode_address[ 0] = opcode;                  // OPC (zpage)           [5]
-                    opcode_address[ 1] = zp_ptr_lo;               //
-                    opcode_address[ 2] = OPC_RTS;                 // RTS                   [-]
-
-                    m_test_overhead_cycles = 2 + 3 + 2 + 3;
-                    m_instruction_cycles = 5;
-
-                    if (!execute_single_opcode_test(opcode_address - 8, DEFAULT_RUN_FLAGS))
-                        return false;
-
-                    if (par3 == LAST)
-                        break;
-                }
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-#endif
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//                                                                                                                   //
-//                                    TIMING TESTS FOR READ-MODIFY-WRITE INSTRUCTIONS                                //
-//                                                                                                                   //
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-bool timing_test_read_modify_write_zpage_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-
-    prepare_opcode_tests(opcode_description, Par12_OpcodeOffset_ZPage);
-
-    num_zpage_preserve = 1; // This test *DOES* require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            if (zp_address_is_safe_for_write(par2))
-            {
-                zpage_preserve[0] = par2;
-
-                opcode_address[0] = opcode;   // OPC par2    [5]
-                opcode_address[1] = par2;     //
-                opcode_address[2] = OPC_RTS;  // RTS         [-]
-
-                m_test_overhead_cycles = 0;
-                m_instruction_cycles = 5;
-
-                if (!execute_single_opcode_test(opcode_address, DEFAULT_RUN_FLAGS))
-                    return false;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_read_modify_write_zpage_x_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_ZPage_XReg);
-
-    num_zpage_preserve = 1; // This test *DOES* require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                if (zp_address_is_safe_for_write(par2 + par3))
-                {
-                    zpage_preserve[0] = par2 + par3;
-
-                    opcode_address[-2] = OPC_LDX_IMM;  // LDX #par3     [2]
-                    opcode_address[-1] = par3;         //
-                    opcode_address[ 0] = opcode;       // OPC par2,X    [6]
-                    opcode_address[ 1] = par2;         //
-                    opcode_address[ 2] = OPC_RTS;      // RTS           [-]
-
-                    m_test_overhead_cycles = 2;
-                    m_instruction_cycles = 6;
-
-                    if (!execute_single_opcode_test(opcode_address - 2, DEFAULT_RUN_FLAGS))
-                        return false;
-                }
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_read_modify_write_abs_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t * abs_address;
-
-    prepare_opcode_tests(opcode_description, Par12_OpcodeOffset_AbsOffset);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            abs_address = TESTCODE_BASE + par2;
-
-            opcode_address[0] = opcode;            // OPC abs_address    [6]
-            opcode_address[1] = lsb(abs_address);  //
-            opcode_address[2] = msb(abs_address);  //
-            opcode_address[3] = OPC_RTS;           // RTS                [-]
-
-            m_test_overhead_cycles = 0;
-            m_instruction_cycles = 6;
-
-            if (!execute_single_opcode_test(opcode_address, DEFAULT_RUN_FLAGS))
-                return false;
-
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_read_modify_write_abs_x_instruction_v1(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t * base_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_XReg);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            base_address = TESTCODE_BASE + par2;
-
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                opcode_address[-2] = OPC_LDX_IMM;        // LDX #par3            [2]
-                opcode_address[-1] = par3;               //
-                opcode_address[ 0] = opcode;             // OPC base_address,X   [7]
-                opcode_address[ 1] = lsb(base_address);  //
-                opcode_address[ 2] = msb(base_address);  //
-                opcode_address[ 3] = OPC_RTS;            // RTS                  [-]
-
-                m_test_overhead_cycles = 2;
-                m_instruction_cycles = 7;
-
-                if (!execute_single_opcode_test(opcode_address - 2, DEFAULT_RUN_FLAGS))
-                    return false;
-
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-#if defined(CPU_65C02)
-// Note: this code is only ever useful on a 65C02 processor.
-bool timing_test_read_modify_write_abs_x_instruction_v2(const char * opcode_description, uint8_t opcode)
-{
-    // The ASL/ROL/ROR/LSR instructions with absolute-x addressing have different timing on the 65C02 compared to the 6502.
-    // Note: the DEC/INC with absolute-x indexing on the 65C02 have the same timing as their 6502 counterparts. Go figure.
-
-    uint8_t * opcode_address;
-    uint8_t * base_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_XReg);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            base_address = TESTCODE_BASE + par2;
-
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                opcode_address[-2] = OPC_LDX_IMM;        // LDX #par3            [2]
-                opcode_address[-1] = par3;               //
-                opcode_address[ 0] = opcode;             // OPC base_address,X   [7]
-                opcode_address[ 1] = lsb(base_address);  //
-                opcode_address[ 2] = msb(base_address);  //
-                opcode_address[ 3] = OPC_RTS;            // RTS                  [-]
-
-                m_test_overhead_cycles = 2;
-                m_instruction_cycles = 6 + different_pages(base_address, base_address + par3);
-
-                if (!execute_single_opcode_test(opcode_address - 2, DEFAULT_RUN_FLAGS))
-                    return false;
-
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
-                break;
-        }
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-#endif
-
-bool timing_test_read_modify_write_abs_y_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t * base_address;
-
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_YReg);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
+    // This level is entered for every single measurement. Rather than going through the generic
+    // 'enter_parameter_level', each kind of innermost parameter has its own loop that patches the
+    // fragment copy of the next batch entry directly. The batch is executed before returning, so
+    // the outer levels can patch all copies.
 
-        for (par2 = 0;;par2 += STEP_SIZE)
-        {
-            base_address = TESTCODE_BASE + par2;
+    uint8_t   value;
+    uint8_t   zpage_address;
+    uint8_t * copy;
+    unsigned  page_cross_value;
 
-            for (par3 = 0;;par3 += STEP_SIZE)
-            {
-                opcode_address[-2] = OPC_LDY_IMM;        // LDY #par3            [2]
-                opcode_address[-1] = par3;               //
-                opcode_address[ 0] = opcode;             // OPC base_address,Y   [7]
-                opcode_address[ 1] = lsb(base_address);  //
-                opcode_address[ 2] = msb(base_address);  //
-                opcode_address[ 3] = OPC_RTS;            // RTS                  [-]
+    if (num_levels == 1)
+        return execute_single_opcode_test(fragment, DEFAULT_RUN_FLAGS);
 
-                m_test_overhead_cycles = 2;
-                m_instruction_cycles = 7;
+    if (role[num_levels] == ROLE_ABS_OFFSET)
+    {
+        for (value = 0;;value += STEP_SIZE)
+        {
+            *inner_par = value;
+            abs_address = TESTCODE_BASE + value;
+            copy = fragment_copy[measurement_batch.count];
+            copy[inner_offset] = lsb(abs_address);
+            copy[inner_offset_hi] = msb(abs_address);
 
-                if (!execute_single_opcode_test(opcode_address - 2, DEFAULT_RUN_FLAGS))
-                    return false;
+            if (!add_fragment_measurement(copy))
+                return false;
 
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
+            if (value == LAST)
                 break;
         }
-        if (par1 == LAST)
-            break;
     }
-    return true;
-}
+    else if (role[num_levels] == ROLE_INDEX && role[num_levels - 1] == ROLE_ABS_OFFSET && page_cross_cycles != 0)
+    {
+        // Indexing crosses a page boundary for index values of 'page_cross_value' and up.
 
-bool timing_test_read_modify_write_zpage_x_indirect_instruction(const char * opcode_description, uint8_t opcode)
-{
-    uint8_t * opcode_address;
-    uint8_t   zp_ptr_lo;
-    uint8_t   zp_ptr_hi;
-    uint8_t * abs_address;
+        page_cross_value = 0x100 - lsb(abs_address);
 
-    prepare_opcode_tests(opcode_description, Par1234_OpcodeOffset_ZPage_XReg_AbsOffset);
+        for (value = 0;;value += STEP_SIZE)
+        {
+            *inner_par = value;
+            copy = fragment_copy[measurement_batch.count];
+            copy[inner_offset] = value;
+            m_instruction_cycles = (value >= page_cross_value) ? instruction_cycles + page_cross_cycles : instruction_cycles;
 
-    num_zpage_preserve = 2; // This test *DOES* require zero page address preservation.
+            if (!add_fragment_measurement(copy))
+                return false;
 
-    for (par1 = 0;;par1 += STEP_SIZE)
+            if (value == LAST)
+                break;
+        }
+    }
+    else if (zpage_level == num_levels)
     {
-        opcode_address = TESTCODE_ANCHOR + par1;
+        // The zero page address is the parameter itself, or the parameter used as an index.
+        // Zero page indexing wraps around within the zero page. An innermost zero page address
+        // is never used as a pointer, so at most one address is preserved.
 
-        for (par2 = 0;;par2 += STEP_SIZE)
+        for (value = 0;;value += STEP_SIZE)
         {
-            for (par3 = 0;;par3 += STEP_SIZE)
+            zpage_address = zpage_base + value;
+
+            if (num_zpage_preserve != 0 ? zp_address_is_safe_for_write(zpage_address) : zp_address_is_safe_for_read(zpage_address))
             {
-                // (zp_ptr_lo, zp_ptr_hi) will be the actual pointer used for indirection.
-                zp_ptr_lo = par2 + par3;
-                zp_ptr_hi = zp_ptr_lo + 1;
+                *inner_par = value;
+                zpage_preserve[0] = zpage_address;
+                copy = fragment_copy[measurement_batch.count];
+                copy[inner_offset] = value;
+
+                if (!add_fragment_measurement(copy))
+                    return false;
+            }
 
-                zpage_preserve[0] = zp_ptr_lo;
-                zpage_preserve[1] = zp_ptr_hi;
+            if (value == LAST)
+                break;
+        }
+    }
+    else
+    {
+        for (value = 0;;value += STEP_SIZE)
+        {
+            *inner_par = value;
+            copy = fragment_copy[measurement_batch.count];
+            copy[inner_offset] = value;
 
-                if (zp_address_is_safe_for_write(zp_ptr_lo) && zp_address_is_safe_for_write(zp_ptr_hi))
-                {
-                    for (par4 = 0;;par4 += STEP_SIZE)
-                    {
-                        abs_address = TESTCODE_BASE + par4;
-
-                        opcode_address[-10] = OPC_LDX_IMM;       // LDX #<abs_address     [2]
-                        opcode_address[ -9] = lsb(abs_address);  //
-                        opcode_address[ -8] = OPC_STX_ZP;        // STX zp_ptr_lo [3]
-                        opcode_address[ -7] = zp_ptr_lo;         //
-                        opcode_address[ -6] = OPC_LDX_IMM;       // LDX #>abs_address     [2]
-                        opcode_address[ -5] = msb(abs_address);  //
-                        opcode_address[ -4] = OPC_STX_ZP;        // STX zp_ptr_hi [3]
-                        opcode_address[ -3] = zp_ptr_hi;         //
-                        opcode_address[ -2] = OPC_LDX_IMM;       // LDX #par3             [2]
-                        opcode_address[ -1] = par3;              //
-                        opcode_address[  0] = opcode;            // OPC (zpage, X)        [6]
-                        opcode_address[  1] = par2;              //
-                        opcode_address[  2] = OPC_RTS;           // RTS                   [-]
-
-                        m_test_overhead_cycles = 2 + 3 + 2 + 3 + 2;
-                        m_instruction_cycles = 8;
-
-                        if (!execute_single_opcode_test(opcode_address - 10, DEFAULT_RUN_FLAGS))
-                            return false;
+            if (!add_fragment_measurement(copy))
+                return false;
 
-                        if (par4 == LAST)
-                            break;
-                    }
-                }
-                if (par3 == LAST)
-                    break;
-            }
-            if (par2 == LAST)
+            if (value == LAST)
                 break;
         }
-        if (par1 == LAST)
-            break;
     }
-    return true;
+    return execute_batch_opcode_tests(DEFAULT_RUN_FLAGS);
 }
 
-bool timing_test_read_modify_write_zpage_indirect_y_instruction(const char * opcode_description, uint8_t opcode)
+static bool run_fragment_test(const TimingTest * test, const char * opcode_description, uint8_t opcode)
 {
-    uint8_t * opcode_address;
-    uint8_t   zp_ptr_lo;
-    uint8_t   zp_ptr_hi;
-    uint8_t * base_address;
+    // Run a test fragment for all combinations of the parameters par1..par4 that the test uses.
+    // The loops over par2 and par3 below are only taken for levels that are entered via
+    // 'enter_parameter_level'; the innermost level is run by 'run_innermost_level'. Parameters
+    // beyond the number of parameters used are zero.
 
-    prepare_opcode_tests(opcode_description, Par1234_OpcodeOffset_ZPage_AbsOffset_YReg);
+    uint8_t opcode_offset;
 
-    num_zpage_preserve = 2; // This test *DOES* require zero page address preservation.
+    if (!prepare_opcode_tests(opcode_description, test->parspec))
+        return true;
+
+    opcode_offset = setup_fragment_test(test);
+
+    par2 = 0;
+    par3 = 0;
+    par4 = 0;
 
     for (par1 = 0;;par1 += STEP_SIZE)
     {
-        opcode_address = TESTCODE_ANCHOR + par1;
+        if (!prepare_par1_tests())
+        {
+            // Another thread takes care of this value of par1.
+            if (par1 == LAST)
+                break;
+            continue;
+        }
+
+        fragment = TESTCODE_ANCHOR + par1 - opcode_offset;
+
+        write_fragment(test, opcode);
 
         for (par2 = 0;;par2 += STEP_SIZE)
         {
-            zp_ptr_lo = par2;
-            zp_ptr_hi = zp_ptr_lo + 1;
-
-            if (zp_address_is_safe_for_write(zp_ptr_lo) && zp_address_is_safe_for_write(zp_ptr_hi))
+            if (num_levels < 3 || enter_parameter_level(2, par2))
             {
-                zpage_preserve[0] = zp_ptr_lo;
-                zpage_preserve[1] = zp_ptr_hi;
-
                 for (par3 = 0;;par3 += STEP_SIZE)
                 {
-                    base_address = TESTCODE_BASE + par3;
-
-                    for (par4 = 0;;par4 += STEP_SIZE)
+                    if (num_levels < 4 || enter_parameter_level(3, par3))
                     {
-                        opcode_address[-10] = OPC_LDY_IMM;        // LDY #<base_address    [2]
-                        opcode_address[ -9] = lsb(base_address);  //
-                        opcode_address[ -8] = OPC_STY_ZP;         // STY zp_ptr_lo [3]
-                        opcode_address[ -7] = zp_ptr_lo;          //
-                        opcode_address[ -6] = OPC_LDY_IMM;        // LDY #>base_address    [2]
-                        opcode_address[ -5] = msb(base_address);  //
-                        opcode_address[ -4] = OPC_STY_ZP;         // STY zp_ptr_hi [3]
-                        opcode_address[ -3] = zp_ptr_hi;          //
-                        opcode_address[ -2] = OPC_LDY_IMM;        // LDY #reg_y            [2]
-                        opcode_address[ -1] = par4;               //
-                        opcode_address[  0] = opcode;             // OPC (zpage), Y        [5 or 6]
-                        opcode_address[  1] = zp_ptr_lo;          //
-                        opcode_address[  2] = OPC_RTS;            // RTS                   [-]
-
-                        m_test_overhead_cycles = 2 + 3 + 2 + 3 + 2;
-                        m_instruction_cycles = 8;
-
-                        if (!execute_single_opcode_test(opcode_address - 10, DEFAULT_RUN_FLAGS))
+                        if (!run_innermost_level())
                             return false;
-
-                        if (par4 == LAST)
-                            break;
                     }
-                    if (par3 == LAST)
+                    if (num_levels < 4 || par3 == LAST)
                         break;
                 }
             }
-            if (par2 == LAST)
+            if (num_levels < 3 || par2 == LAST)
                 break;
         }
         if (par1 == LAST)
@@ -1954,65 +542,101 @@ bool timing_test_read_modify_write_zpage_indirect_y_instruction(const char * opc
     return true;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                   //
+//                                           HANDLE SKIPPED INSTRUCTIONS                                             //
+//                                                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool skip_test(const TimingTest * test, const char * opcode_description, uint8_t opcode)
+{
+    (void)test;
+    (void)opcode;
+    prepare_opcode_tests_skip(opcode_description);
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                                                                                                   //
 //                            TIMING TESTS FOR BRANCH, JUMP, and INTERRUPT-RELATED INSTRUCTIONS                      //
 //                                                                                                                   //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool timing_test_branch_instruction(const char * opcode_description, uint8_t opcode, bool branch_when_flag_set)
+// These tests need more than a single code fragment (branches, indirect jumps), or need to change the
+// IRQ vector (BRK). They have their own test routines.
+
+static bool timing_test_branch_instruction(const TimingTest * test, const char * opcode_description, uint8_t opcode)
 {
     // This function tests any of the "branch" instructions, testing both the "branch taken" and "branch not taken"
     // scenarios.
     //
-    // The 'flag_value' parameter determines whether "branch taken" happens when the associated flag is High or Low.
-    // The instructions BMI, BCS, BVS, and BEQ jump when N/C/V/Z are 1; BPL, BCC, BVC and BNE jump when N/C/V/Z are 0.
+    // The TF_BRANCH_WHEN_SET flag of the test descriptor determines whether the branch is taken when the associated
+    // flag is set or clear. The instructions BMI, BCS, BVS, and BEQ jump when N/C/V/Z are 1; BPL, BCC, BVC and BNE
+    // jump when N/C/V/Z are 0. Before executing the branch instruction, the test code sets the N/V/Z/C flags all to
+    // the value that leads to the branch being (not) taken.
     //
     // Branch instructions, when not taken, take 2 clock cycles. When taken, they take 3 or 4 clock cycles:
     //
     // * 3 clock cycles if the address following the branch instruction is on the same memory page as the destination address;
     // * 4 clock cycles if the address following the branch instruction is *not* on the same memory page as the destination address.
 
-    // This function tests any of the "branch" instructions, assuming the flag associated with the instruction
-    // is in a state that lead to the branch *NOT* being taken.
-    //
-    // The flag value (true or false) that leads to the branch being not taken is passed in the 'flag_value' parameter.
-    // Before executing the branch instructions, the CPU flags that can be used for branching (N, V, Z, C) are all
-    // set to this value.
-    //
-    // Branch instructions, when not taken, always take 2 clock cycles.
-
+    bool      branch_when_flag_set = (test->flags & TF_BRANCH_WHEN_SET) != 0;
     uint8_t * opcode_address;
     uint8_t * entry_address  = TESTCODE_BASE;
+    uint8_t * rts_address;
+    uint8_t   saved_byte;
     int       displacement;
 
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_BranchDisplacement_TakenNotTaken);
+    if (!prepare_opcode_tests(opcode_description, test->parspec))
+        return true;
 
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
+    select_zpage_preserve(0); // This test does not require zero page address preservation.
 
     for (par1 = 0;;par1 += STEP_SIZE)
     {
+        if (!prepare_par1_tests())
+        {
+            // Another thread takes care of this value of par1.
+            if (par1 == LAST)
+                break;
+            continue;
+        }
+
         opcode_address = TESTCODE_ANCHOR + par1;
 
+        // If 'branch_when_flag_set' is true, the test code sets the N/V/C/Z flags all to zero.
+        // If 'branch_when_flag_set' is false, the test code sets the N/V/C/Z flags all to one.
+
+        opcode_address[-6] = OPC_PHP;                                           // PHP                  [3]
+        opcode_address[-5] = OPC_PLA;                                           // PLA                  [4]
+        opcode_address[-4] = branch_when_flag_set ? OPC_AND_IMM : OPC_ORA_IMM;  // AND #$3C / ORA #$C3  [2]
+        opcode_address[-3] = branch_when_flag_set ?     0x3c    :     0xc3;     //
+        opcode_address[-2] = OPC_PHA;                                           // PHA                  [3]
+        opcode_address[-1] = OPC_PLP;                                           // PLP                  [4]
+        opcode_address[ 0] = opcode;                                            // Bxx operand          [2]
+        opcode_address[ 2] = OPC_RTS;                                           // RTS                  [-]
+
+        // If 'branch_when_flag_set' is true, the entry code sets the N/V/C/Z flags all to one.
+        // If 'branch_when_flag_set' is false, the entry code sets the N/V/C/Z flags all to zero.
+
+        entry_address[0] = OPC_PHP;                                           // PHP                  [3]
+        entry_address[1] = OPC_PLA;                                           // PLA                  [4]
+        entry_address[2] = branch_when_flag_set ? OPC_ORA_IMM : OPC_AND_IMM;  // ORA #$C3 / AND #$3C  [2]
+        entry_address[3] = branch_when_flag_set ?     0xc3    :     0x3c;     //
+        entry_address[4] = OPC_PHA;                                           // PHA                  [3]
+        entry_address[5] = OPC_PLP;                                           // PLP                  [4]
+        entry_address[6] = OPC_JMP_ABS;                                       // JMP opcode_address   [3]
+        entry_address[7] = lsb(opcode_address);                               //
+        entry_address[8] = msb(opcode_address);                               //
+
         for (par2 = 0;;par2 += STEP_SIZE)
         {
+            opcode_address[1] = par2;
+
             // Branch Not Taken measurement.
 
             par3 = 0;
 
-            // If 'branch_when_flag_set' is true, set the N/V/C/Z flags all to zero.
-            // If 'branch_when_flag_set' is false, set the N/V/C/Z flags all to one.
-
-            opcode_address[-6] = OPC_PHP;                                           // PHP                  [3]
-            opcode_address[-5] = OPC_PLA;                                           // PLA                  [4]
-            opcode_address[-4] = branch_when_flag_set ? OPC_AND_IMM : OPC_ORA_IMM;  // AND #$3C / ORA #$C3  [2]
-            opcode_address[-3] = branch_when_flag_set ?     0x3c    :     0xc3;     //
-            opcode_address[-2] = OPC_PHA;                                           // PHA                  [3]
-            opcode_address[-1] = OPC_PLP;                                           // PLP                  [4]
-            opcode_address[ 0] = opcode;                                            // Bxx operand          [2]
-            opcode_address[ 1] = par2;                                              //
-            opcode_address[ 2] = OPC_RTS;                                           // RTS                  [-]
-
             m_test_overhead_cycles = 3 + 4 + 2 + 3 + 4;
             m_instruction_cycles = 2;
 
@@ -2034,29 +658,20 @@ bool timing_test_branch_instruction(const char * opcode_description, uint8_t opc
 
                 par3 = 1;
 
-                // If 'branch_when_flag_set' is true,set the N/V/C/Z flags all to one.
-                // If 'branch_when_flag_set' is false, set the N/V/C/Z flags all to zero.
+                // The RTS may land in the Branch Not Taken test code; the byte it replaces is restored afterwards.
 
-                entry_address[0] = OPC_PHP;                                           // PHP                  [3]
-                entry_address[1] = OPC_PLA;                                           // PLA                  [4]
-                entry_address[2] = branch_when_flag_set ? OPC_ORA_IMM : OPC_AND_IMM;  // ORA #$C3 / AND #$3C  [2]
-                entry_address[3] = branch_when_flag_set ?     0xc3    :     0x3c;     //
-                entry_address[4] = OPC_PHA;                                           // PHA                  [3]
-                entry_address[5] = OPC_PLP;                                           // PLP                  [4]
-                entry_address[6] = OPC_JMP_ABS;                                       // JMP opcode_address   [3]
-                entry_address[7] = lsb(opcode_address);                               //
-                entry_address[8] = msb(opcode_address);                               //
+                rts_address = opcode_address + 2 + displacement;
+                saved_byte = *rts_address;
 
-                opcode_address[0] = opcode;                                           // Bxx operand          [2]
-                opcode_address[1] = par2;                                             //
-
-                opcode_address[2 + displacement] = OPC_RTS;                           // RTS                  [-]
+                *rts_address = OPC_RTS;                                               // RTS                  [-]
 
                 m_test_overhead_cycles = 3 + 4 + 2 + 3 + 4 + 3;
-                m_instruction_cycles = 3 + different_pages(opcode_address + 2, opcode_address + 2 + displacement);
+                m_instruction_cycles = 3 + different_pages(opcode_address + 2, rts_address);
 
                 if (!execute_single_opcode_test(entry_address, DEFAULT_RUN_FLAGS))
                     return false;
+
+                *rts_address = saved_byte;
             } // displacement acceptable?
 
             if (par2 == LAST)
@@ -2065,68 +680,86 @@ bool timing_test_branch_instruction(const char * opcode_description, uint8_t opc
         if (par1 == LAST)
             break;
     }
-    return true; // displacement acceptable?
+    return true;
 }
 
 #if defined(CPU_65C02)
-bool timing_test_bit_branch_instruction(const char * opcode_description, uint8_t opcode, bool branch_when_bit_set)
+static bool timing_test_bit_branch_instruction(const TimingTest * test, const char * opcode_description, uint8_t opcode)
 {
     // This function tests any of the 65C02 "zero-page bit branch" instructions, testing both the "branch taken"
     // and "branch not taken" scenarios.
     //
-    // The 'flag_value' parameter determines whether "branch taken" happens when the associated flag is High or Low.
-    // The instructions BMI, BCS, BVS, and BEQ jump when N/C/V/Z are 1; BPL, BCC, BVC and BNE jump when N/C/V/Z are 0.
-    //
-    // Branch instructions, when not taken, take 2 clock cycles. When taken, they take 3 or 4 clock cycles:
-    //
-    // * 3 clock cycles if the address following the branch instruction is on the same memory page as the destination address;
-    // * 4 clock cycles if the address following the branch instruction is *not* on the same memory page as the destination address.
-
-    // This function tests any of the "branch" instructions, assuming the flag associated with the instruction
-    // is in a state that lead to the branch *NOT* being taken.
+    // The TF_BRANCH_WHEN_SET flag of the test descriptor determines whether the branch is taken when the tested
+    // bit of the zero page address is set (BBS0..BBS7) or clear (BBR0..BBR7). Before executing the branch
+    // instruction, the test code sets all bits of the zero page address to the value that leads to the branch
+    // being (not) taken.
     //
-    // The flag value (true or false) that leads to the branch being not taken is passed in the 'flag_value' parameter.
-    // Before executing the branch instructions, the CPU flags that can be used for branching (N, V, Z, C) are all
-    // set to this value.
+    // Bit branch instructions, when not taken, take 5 clock cycles. When taken, they take 6 or 7 clock cycles:
     //
-    // Branch instructions, when not taken, always take 2 clock cycles.
+    // * 6 clock cycles if the address following the branch instruction is on the same memory page as the destination address;
+    // * 7 clock cycles if the address following the branch instruction is *not* on the same memory page as the destination address.
 
+    bool      branch_when_bit_set = (test->flags & TF_BRANCH_WHEN_SET) != 0;
     uint8_t * opcode_address;
     uint8_t * entry_address  = TESTCODE_BASE;
+    uint8_t * rts_address;
+    uint8_t   saved_byte;
     int       displacement;
 
-    prepare_opcode_tests(opcode_description, Par1234_OpcodeOffset_ZPage_BranchDisplacement_TakenNotTaken);
+    if (!prepare_opcode_tests(opcode_description, test->parspec))
+        return true;
 
-    num_zpage_preserve = 1; // This test requires zero page address preservation.
+    select_zpage_preserve(1); // This test requires zero page address preservation.
 
     for (par1 = 0;;par1 += STEP_SIZE)
     {
+        if (!prepare_par1_tests())
+        {
+            // Another thread takes care of this value of par1.
+            if (par1 == LAST)
+                break;
+            continue;
+        }
+
         opcode_address = TESTCODE_ANCHOR + par1;
 
+        // If 'branch_when_bit_set' is true, the test code sets the zpage address bits all to zero.
+        // If 'branch_when_bit_set' is false, the test code sets the zpage address bits all to one.
+
+        opcode_address[-4] = OPC_LDA_IMM;                          // LDA #value             [2]
+        opcode_address[-3] = branch_when_bit_set ?   0x00 : 0xff;  //
+        opcode_address[-2] = OPC_STA_ZP;                           // STA par2               [3]
+        opcode_address[ 0] = opcode;                               // BBxy zp,distplacement  [5]
+        opcode_address[ 3] = OPC_RTS;                              // RTS                    [-]
+
+        // If 'branch_when_bit_set' is true, the entry code sets the zpage address bits all to one.
+        // If 'branch_when_bit_set' is false, the entry code sets the zpage address bits all to zero.
+
+        entry_address[0] = OPC_LDA_IMM;                          // LDA #value             [2]
+        entry_address[1] = branch_when_bit_set ?   0xff : 0x00;  //
+        entry_address[2] = OPC_STA_ZP;                           // STA par2               [3]
+        entry_address[4] = OPC_JMP_ABS;                          // JMP opcode_address     [3]
+        entry_address[5] = lsb(opcode_address);                  //
+        entry_address[6] = msb(opcode_address);                  //
+
         for (par2 = 0;;par2 += STEP_SIZE)
         {
             if (zp_address_is_safe_for_write(par2))
             {
                 zpage_preserve[0] = par2;
 
+                opcode_address[-1] = par2;
+                opcode_address[ 1] = par2;
+                entry_address[3] = par2;
+
                 for (par3 = 0;;par3 += STEP_SIZE)
                 {
+                    opcode_address[2] = par3;
+
                     // Branch Not Taken measurement.
 
                     par4 = 0;
 
-                    // If 'branch_when_bit_set' is true, set the zpage address bits all to zero.
-                    // If 'branch_when_bit_set' is false, set the zpage address bits all to one.
-
-                    opcode_address[-4] = OPC_LDA_IMM;                          // LDA #value             [2]
-                    opcode_address[-3] = branch_when_bit_set ?   0x00 : 0xff;  //
-                    opcode_address[-2] = OPC_STA_ZP;                           // STA par2               [3]
-                    opcode_address[-1] = par2;                                 //
-                    opcode_address[ 0] = opcode;                               // BBxy zp,distplacement  [5]
-                    opcode_address[ 1] = par2;                                 // (zpage)
-                    opcode_address[ 2] = par3;                                 // (displacement)         [-]
-                    opcode_address[ 3] = OPC_RTS;                              // RTS                    [-]
-
                     m_test_overhead_cycles = 2 + 3;
                     m_instruction_cycles = 5;
 
@@ -2135,10 +768,11 @@ bool timing_test_bit_branch_instruction(const char * opcode_description, uint8_t
 
                     // Branch Taken measurement.
                     //
-                    // For a Branch Taken instruction, the target address should hold an RTS, bit
-                    // this RTS cannot overlap with the branch opcode itself, or its operand (the displacement).
+                    // For a Branch Taken instruction, the target address should hold an RTS, but
+                    // this RTS cannot overlap with the branch opcode itself, or its operands (the zero page
+                    // address and the displacement).
                     //
-                    // So the par2 values 0xff (displacement -1) and 0xfe (displacement - 2) must be skipped.
+                    // So the par3 values 0xff, 0xfe, and 0xfd (displacements -1, -2, and -3) must be skipped.
                     //
                     // To maximize the range that we can cover, we jump to the test code from an 'entry point'
                     // region.
@@ -2148,28 +782,20 @@ bool timing_test_bit_branch_instruction(const char * opcode_description, uint8_t
 
                         displacement = (par3 <= 0x7f) ? par3 : par3 - 0x100;
 
-                        // If 'branch_when_bit_set' is true, set the zpage address bits all to one.
-                        // If 'branch_when_bit_set' is false, set the zpage address bits all to zero.
+                        // The RTS may land in the Branch Not Taken test code; the byte it replaces is restored afterwards.
 
-                        entry_address[0] = OPC_LDA_IMM;                          // LDA #value             [2]
-                        entry_address[1] = branch_when_bit_set ?   0xff : 0x00;  //
-                        entry_address[2] = OPC_STA_ZP;                           // STA par2               [3]
-                        entry_address[3] = par2;                                 //
-                        entry_address[4] = OPC_JMP_ABS;                          // JMP opcode_address     [3]
-                        entry_address[5] = lsb(opcode_address);                  //
-                        entry_address[6] = msb(opcode_address);                  //
+                        rts_address = opcode_address + 3 + displacement;
+                        saved_byte = *rts_address;
 
-                        opcode_address[0] = opcode;                              // BBxy operand           [6/7]
-                        opcode_address[1] = par2;                                //
-                        opcode_address[2] = par3;                                //
-
-                        opcode_address[3 + displacement] = OPC_RTS;              // RTS                    [-]
+                        *rts_address = OPC_RTS;                                  // RTS                    [-]
 
                         m_test_overhead_cycles = 2 + 3 + 3;
-                        m_instruction_cycles = 6 + different_pages(opcode_address + 3, opcode_address + 3 + displacement);
+                        m_instruction_cycles = 6 + different_pages(opcode_address + 3, rts_address);
 
                         if (!execute_single_opcode_test(entry_address, DEFAULT_RUN_FLAGS))
                             return false;
+
+                        *rts_address = saved_byte;
                     } // displacement acceptable?
 
                     if (par3 == LAST)
@@ -2187,20 +813,37 @@ bool timing_test_bit_branch_instruction(const char * opcode_description, uint8_t
 #endif
 
 #if defined(CPU_65C02)
-bool timing_test_branch_always_instruction(const char * opcode_description, uint8_t opcode)
+static bool timing_test_branch_always_instruction(const TimingTest * test, const char * opcode_description, uint8_t opcode)
 {
     uint8_t * opcode_address;
     uint8_t * entry_address  = TESTCODE_BASE;
     int       displacement;
 
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_BranchDisplacement_TakenNotTaken);
+    if (!prepare_opcode_tests(opcode_description, test->parspec))
+        return true;
 
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
+    select_zpage_preserve(0); // This test does not require zero page address preservation.
+
+    m_test_overhead_cycles = 3;
 
     for (par1 = 0;;par1 += STEP_SIZE)
     {
+        if (!prepare_par1_tests())
+        {
+            // Another thread takes care of this value of par1.
+            if (par1 == LAST)
+                break;
+            continue;
+        }
+
         opcode_address = TESTCODE_ANCHOR + par1;
 
+        entry_address[0] = OPC_JMP_ABS;              // JMP opcode_address   [3]
+        entry_address[1] = lsb(opcode_address);      //
+        entry_address[2] = msb(opcode_address);      //
+
+        opcode_address[0] = opcode;                  // Bxx operand          [3 or 4]
+
         for (par2 = 0;;par2 += STEP_SIZE)
         {
             if ((par2 & 0xfe) != 0xfe)
@@ -2209,19 +852,10 @@ bool timing_test_branch_always_instruction(const char * opcode_description, uint
 
                 par3 = 1;
 
-                // If 'branch_when_flag_set' is true,set the N/V/C/Z flags all to one.
-                // If 'branch_when_flag_set' is false, set the N/V/C/Z flags all to zero.
-
-                entry_address[0] = OPC_JMP_ABS;              // JMP opcode_address   [3]
-                entry_address[1] = lsb(opcode_address);      //
-                entry_address[2] = msb(opcode_address);      //
-
-                opcode_address[0] = opcode;                  // Bxx operand          [2]
-                opcode_address[1] = par2;                    //
+                opcode_address[1] = par2;
 
                 opcode_address[2 + displacement] = OPC_RTS;  // RTS                  [-]
 
-                m_test_overhead_cycles = 3;
                 m_instruction_cycles = 3 + different_pages(opcode_address + 2, opcode_address + 2 + displacement);
 
                 if (!execute_single_opcode_test(entry_address, DEFAULT_RUN_FLAGS))
@@ -2237,48 +871,40 @@ bool timing_test_branch_always_instruction(const char * opcode_description, uint
 }
 #endif
 
-bool timing_test_jmp_abs_instruction(const char * opcode_description)
+static bool timing_test_jmp_abs_indirect_instruction(const TimingTest * test, const char * opcode_description, uint8_t opcode)
 {
     uint8_t * opcode_address;
+    uint8_t * target_ptr_address;
 
-    prepare_opcode_tests(opcode_description, Par1_OpcodeOffset);
+    if (!prepare_opcode_tests(opcode_description, test->parspec))
+        return true;
 
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
+    select_zpage_preserve(0); // This test does not require zero page address preservation.
+
+    m_test_overhead_cycles = 0;
+#if defined(CPU_6502)
+    m_instruction_cycles   = 5; // The instruction takes 5 cycles on the 6502.
+#elif defined(CPU_65C02)
+    m_instruction_cycles   = 6; // The instruction takes 6 cycles on the 65C02.
+#else
+#error "CPU type not specified."
+#endif
 
     for (par1 = 0;;par1 += STEP_SIZE)
     {
+        if (!prepare_par1_tests())
+        {
+            // Another thread takes care of this value of par1.
+            if (par1 == LAST)
+                break;
+            continue;
+        }
+
         opcode_address = TESTCODE_ANCHOR + par1;
 
-        opcode_address[0] = OPC_JMP_ABS;              // JMP abs      [3]
-        opcode_address[1] = lsb(opcode_address + 3);  //
-        opcode_address[2] = msb(opcode_address + 3);  //
+        opcode_address[0] = opcode;                   // JMP (ind)    [5 or 6]
         opcode_address[3] = OPC_RTS;                  // RTS          [-]
 
-        m_test_overhead_cycles = 0;
-        m_instruction_cycles   = 3;
-
-        if (!execute_single_opcode_test(opcode_address, DEFAULT_RUN_FLAGS))
-            return false;
-
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_jmp_abs_indirect_instruction(const char * opcode_description)
-{
-    uint8_t * opcode_address;
-    uint8_t * target_ptr_address;
-
-    prepare_opcode_tests(opcode_description, Par12_OpcodeOffset_AbsOffset);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
         for (par2 = 0;;par2 += STEP_SIZE)
         {
             target_ptr_address = TESTCODE_BASE + par2;
@@ -2303,30 +929,16 @@ bool timing_test_jmp_abs_indirect_instruction(const char * opcode_description)
                 target_ptr_address[1] = msb(opcode_address + 3);
             }
 
-            opcode_address[0] = OPC_JMP_IND;              // JMP (ind)    [5]
-            opcode_address[1] = lsb(target_ptr_address);  //
-            opcode_address[2] = msb(target_ptr_address);  //
-            opcode_address[3] = OPC_RTS;                  // RTS          [-]
-
-            m_test_overhead_cycles = 0;
-            m_instruction_cycles   = 5; // The instruction takes 5 cycles on the 6502.
-
-#elif defined(CPU_65C02)
+#else
 
             target_ptr_address[0] = lsb(opcode_address + 3);
             target_ptr_address[1] = msb(opcode_address + 3);
 
-            opcode_address[0] = OPC_JMP_IND;              // JMP (ind)    [6]
-            opcode_address[1] = lsb(target_ptr_address);  //
-            opcode_address[2] = msb(target_ptr_address);  //
-            opcode_address[3] = OPC_RTS;                  // RTS          [-]
-
-            m_test_overhead_cycles = 0;
-            m_instruction_cycles   = 6; // The instruction takes 6 cycles on the 65C02.
-#else
-#error "CPU type not specified."
 #endif
 
+            opcode_address[1] = lsb(target_ptr_address);
+            opcode_address[2] = msb(target_ptr_address);
+
             if (!execute_single_opcode_test(opcode_address, DEFAULT_RUN_FLAGS))
                 return false;
 
@@ -2340,21 +952,40 @@ bool timing_test_jmp_abs_indirect_instruction(const char * opcode_description)
 }
 
 #if defined(CPU_65C02)
-bool timing_test_jmp_abs_x_indirect_instruction(const char * opcode_description)
+static bool timing_test_jmp_abs_x_indirect_instruction(const TimingTest * test, const char * opcode_description, uint8_t opcode)
 {
     uint8_t * opcode_address;
     uint8_t * target_ptr_address;
 
-    prepare_opcode_tests(opcode_description, Par123_OpcodeOffset_AbsOffset_XReg);
+    if (!prepare_opcode_tests(opcode_description, test->parspec))
+        return true;
 
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
+    select_zpage_preserve(0); // This test does not require zero page address preservation.
+
+    m_test_overhead_cycles = 2;
+    m_instruction_cycles   = 6;
 
     for (par1 = 0;;par1 += STEP_SIZE)
     {
+        if (!prepare_par1_tests())
+        {
+            // Another thread takes care of this value of par1.
+            if (par1 == LAST)
+                break;
+            continue;
+        }
+
         opcode_address = TESTCODE_ANCHOR + par1;
 
+        opcode_address[-2] = OPC_LDX_IMM;                // LDX #imm     [2]
+        opcode_address[ 0] = opcode;                     // JMP (ind,X)  [6]
+        opcode_address[ 3] = OPC_RTS;                    // RTS          [-]
+
         for (par2 = 0;;par2 += STEP_SIZE)
         {
+            opcode_address[1] = lsb(TESTCODE_BASE + par2);
+            opcode_address[2] = msb(TESTCODE_BASE + par2);
+
             for (par3 = 0;;par3 += STEP_SIZE)
             {
                 target_ptr_address = TESTCODE_BASE + par2 + par3;
@@ -2362,15 +993,7 @@ bool timing_test_jmp_abs_x_indirect_instruction(const char * opcode_description)
                 target_ptr_address[0] = lsb(opcode_address + 3);
                 target_ptr_address[1] = msb(opcode_address + 3);
 
-                opcode_address[-2] = OPC_LDX_IMM;                // LDX #imm     [2]
-                opcode_address[-1] = par3;                       //
-                opcode_address[ 0] = OPC_JMP_IND_X;              // JMP (ind,X)  [6]
-                opcode_address[ 1] = lsb(TESTCODE_BASE + par2);  //
-                opcode_address[ 2] = msb(TESTCODE_BASE + par2);  //
-                opcode_address[ 3] = OPC_RTS;                    // RTS          [-]
-
-                m_test_overhead_cycles = 2;
-                m_instruction_cycles   = 6;
+                opcode_address[-1] = par3;
 
                 if (!execute_single_opcode_test(opcode_address - 2, DEFAULT_RUN_FLAGS))
                     return false;
@@ -2388,82 +1011,27 @@ bool timing_test_jmp_abs_x_indirect_instruction(const char * opcode_description)
 }
 #endif
 
-bool timing_test_jsr_abs_instruction(const char * opcode_description)
-{
-    uint8_t * opcode_address;
-
-    prepare_opcode_tests(opcode_description, Par1_OpcodeOffset);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        opcode_address[0] = OPC_JSR_ABS;              // JSR abs      [6]
-        opcode_address[1] = lsb(opcode_address + 3);  //
-        opcode_address[2] = msb(opcode_address + 3);  //
-        opcode_address[3] = OPC_RTS;                  // RTS          [-]
-
-        m_test_overhead_cycles = 6; // The RTS to get back.
-        m_instruction_cycles   = 6;
-
-        if (!execute_single_opcode_test(opcode_address, DEFAULT_RUN_FLAGS))
-            return false;
-
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_rts_instruction(const char * opcode_description)
-{
-    uint8_t * opcode_address;
-
-    prepare_opcode_tests(opcode_description, Par1_OpcodeOffset);
-
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
-
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
-
-        // Note: the RTS is both used as the instruction-under-test, and as the RTS back to
-        // the measurement routine.
-
-        opcode_address[-6] = OPC_LDA_IMM;              // LDA #>(rts_address - 1)   [2]
-        opcode_address[-5] = msb(opcode_address - 1);  //
-        opcode_address[-4] = OPC_PHA;                  // PHA                       [3]
-        opcode_address[-3] = OPC_LDA_IMM;              // LDA #<(rts_address - 1)   [2]
-        opcode_address[-2] = lsb(opcode_address - 1);  //
-        opcode_address[-1] = OPC_PHA;                  // PHA                       [3]
-        opcode_address[ 0] = OPC_RTS;                  // RTS                       [6]
-
-        m_test_overhead_cycles = 2 + 3 + 2 + 3;
-        m_instruction_cycles   = 6;
-
-        if (!execute_single_opcode_test(opcode_address - 6, DEFAULT_RUN_FLAGS))
-            return false;
-
-        if (par1 == LAST)
-            break;
-    }
-    return true;
-}
-
-bool timing_test_brk_instruction(const char * opcode_description)
+static bool timing_test_brk_instruction(const TimingTest * test, const char * opcode_description, uint8_t opcode)
 {
     uint8_t * opcode_address;
     uint8_t * oldvec;
     bool      proceed;
 
-    prepare_opcode_tests(opcode_description, Par1_OpcodeOffset);
+    if (!prepare_opcode_tests(opcode_description, test->parspec))
+        return true;
 
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
+    select_zpage_preserve(0); // This test does not require zero page address preservation.
 
     for (par1 = 0;;par1 += STEP_SIZE)
     {
+        if (!prepare_par1_tests())
+        {
+            // Another thread takes care of this value of par1.
+            if (par1 == LAST)
+                break;
+            continue;
+        }
+
         opcode_address = TESTCODE_ANCHOR + par1;
 
         // We avoid assumptions on what the ISR does before we get back control.
@@ -2474,7 +1042,7 @@ bool timing_test_brk_instruction(const char * opcode_description)
         opcode_address[-3] = OPC_STX_ABS;              // STX save_zp  [4]
         opcode_address[-2] = lsb(opcode_address + 6);
         opcode_address[-1] = msb(opcode_address + 6);
-        opcode_address[ 0] = OPC_BRK;                  // BRK          [7]
+        opcode_address[ 0] = opcode;                   // BRK          [7]
         opcode_address[ 1] = OPC_LDX_ABS;              // LDX save_zp  [4]
         opcode_address[ 2] = lsb(opcode_address + 6);  //
         opcode_address[ 3] = msb(opcode_address + 6);  //
@@ -2499,36 +1067,347 @@ bool timing_test_brk_instruction(const char * opcode_description)
     return true;
 }
 
-bool timing_test_rti_instruction(const char * opcode_description)
-{
-    uint8_t * opcode_address;
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                   //
+//                                                TIMING TEST DESCRIPTORS                                            //
+//                                                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    prepare_opcode_tests(opcode_description, Par1_OpcodeOffset);
+#define FRAGMENT_TEST(parspec, flags, test_overhead_cycles, instruction_cycles, page_cross_cycles, fragment_template) \
+    { run_fragment_test, parspec, flags, test_overhead_cycles, instruction_cycles, page_cross_cycles,                 \
+      fragment_template, sizeof(fragment_template) / sizeof(fragment_template[0]) }
+
+#define SPECIAL_TEST(routine, parspec, flags) \
+    { routine, parspec, flags, 0, 0, 0, NULL, 0 }
+
+// Skipped instructions.
+
+const TimingTest timing_test_skip = SPECIAL_TEST(skip_test, Par1_OpcodeOffset, 0);
+
+// Single-byte instructions, and short instruction sequences.
+
+static const uint16_t implied_fragment[] = {
+    T_OPCODE,                       // OPC                  [1 or 2]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t txs_fragment[] = {
+    OPC_TSX,                        // TSX                  [2]
+    T_OPCODE,                       // TXS                  [2]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t push_fragment[] = {
+    // The stack pointer is saved before, and restored after the instruction.
+    OPC_TSX,                        // TSX                  [2]
+    T_OPCODE,                       // PHx                  [3]
+    OPC_TXS,                        // TXS                  [2]
+    OPC_RTS                         // RTS                  [-]
+};
+
+// The value to be pulled is pushed immediately before.
+
+static const uint16_t pla_fragment[] = {
+    OPC_PHA,                        // PHA                  [3]
+    T_OPCODE,                       // PLA                  [4]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t plp_fragment[] = {
+    OPC_PHP,                        // PHP                  [3]
+    T_OPCODE,                       // PLP                  [4]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t interrupt_flag_fragment[] = {
+    // The CLI and SEI instructions change the CPU interrupt-disable flag, which may be critical.
+    // For that reason, we sandwich them between PHP/PLP instructions.
+    OPC_PHP,                        // PHP                  [3]
+    T_OPCODE,                       // CLI / SEI            [2]
+    OPC_PLP,                        // PLP                  [4]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t sed_fragment[] = {
+    // The SED is followed by a CLD, to prevent that the test leaves decimal mode enabled.
+    T_OPCODE,                       // SED                  [2]
+    OPC_CLD,                        // CLD                  [2]
+    OPC_RTS                         // RTS                  [-]
+};
+
+const TimingTest timing_test_implied        = FRAGMENT_TEST(Par1_OpcodeOffset, 0,     0, 2, 0, implied_fragment);
+const TimingTest timing_test_txs            = FRAGMENT_TEST(Par1_OpcodeOffset, 0,     2, 2, 0, txs_fragment);
+const TimingTest timing_test_push           = FRAGMENT_TEST(Par1_OpcodeOffset, 0, 2 + 2, 3, 0, push_fragment);
+const TimingTest timing_test_pla            = FRAGMENT_TEST(Par1_OpcodeOffset, 0,     3, 4, 0, pla_fragment);
+const TimingTest timing_test_plp            = FRAGMENT_TEST(Par1_OpcodeOffset, 0,     3, 4, 0, plp_fragment);
+const TimingTest timing_test_interrupt_flag = FRAGMENT_TEST(Par1_OpcodeOffset, 0, 3 + 4, 2, 0, interrupt_flag_fragment);
+const TimingTest timing_test_sed            = FRAGMENT_TEST(Par1_OpcodeOffset, 0,     2, 2, 0, sed_fragment);
 
-    num_zpage_preserve = 0; // This test does not require zero page address preservation.
+#if defined(CPU_65C02)
 
-    for (par1 = 0;;par1 += STEP_SIZE)
-    {
-        opcode_address = TESTCODE_ANCHOR + par1;
+static const uint16_t plx_fragment[] = {
+    OPC_PHX,                        // PHX                  [3]
+    T_OPCODE,                       // PLX                  [4]
+    OPC_RTS                         // RTS                  [-]
+};
 
-        opcode_address[-7] = OPC_LDA_IMM;              // LDA #>rts_address     [2]
-        opcode_address[-6] = msb(opcode_address + 1);  //
-        opcode_address[-5] = OPC_PHA;                  // PHA                   [3]
-        opcode_address[-4] = OPC_LDA_IMM;              // LDA #<rts_address     [2]
-        opcode_address[-3] = lsb(opcode_address + 1);  //
-        opcode_address[-2] = OPC_PHA;                  // PHA                   [3]
-        opcode_address[-1] = OPC_PHP;                  // PHP                   [3]
-        opcode_address[ 0] = OPC_RTI;                  // RTI                   [6]
-        opcode_address[ 1] = OPC_RTS;                  // RTS                   [-]
+static const uint16_t ply_fragment[] = {
+    OPC_PHY,                        // PHY                  [3]
+    T_OPCODE,                       // PLY                  [4]
+    OPC_RTS                         // RTS                  [-]
+};
 
-        m_test_overhead_cycles = 2 + 3 + 2 + 3 + 3;
-        m_instruction_cycles   = 6;
+const TimingTest timing_test_implied_1_cycle = FRAGMENT_TEST(Par1_OpcodeOffset, 0, 0, 1, 0, implied_fragment);
+const TimingTest timing_test_plx             = FRAGMENT_TEST(Par1_OpcodeOffset, 0, 3, 4, 0, plx_fragment);
+const TimingTest timing_test_ply             = FRAGMENT_TEST(Par1_OpcodeOffset, 0, 3, 4, 0, ply_fragment);
 
-        if (!execute_single_opcode_test(opcode_address - 7, DEFAULT_RUN_FLAGS))
-            return false;
+#endif
 
-        if (par1 == LAST)
-            break;
-    }
-    return true;
+// Instructions with immediate, zero page, and absolute addressing, with or without indexing.
+
+static const uint16_t opcode_operand_fragment[] = {
+    T_OPCODE, T_PAR2,               // OPC #par2 / par2     [n]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t ldx_opcode_operand_fragment[] = {
+    OPC_LDX_IMM, T_PAR3,            // LDX #par3            [2]
+    T_OPCODE, T_PAR2,               // OPC par2,X           [n]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t ldy_opcode_operand_fragment[] = {
+    OPC_LDY_IMM, T_PAR3,            // LDY #par3            [2]
+    T_OPCODE, T_PAR2,               // OPC par2,Y           [n]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t opcode_abs_fragment[] = {
+    T_OPCODE, T_ABS_LO, T_ABS_HI,   // OPC abs_address      [n]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t ldx_opcode_abs_fragment[] = {
+    OPC_LDX_IMM, T_PAR3,            // LDX #par3            [2]
+    T_OPCODE, T_ABS_LO, T_ABS_HI,   // OPC base_address,X   [n or n + 1]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t ldy_opcode_abs_fragment[] = {
+    OPC_LDY_IMM, T_PAR3,            // LDY #par3            [2]
+    T_OPCODE, T_ABS_LO, T_ABS_HI,   // OPC base_address,Y   [n or n + 1]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t ldy_opcode_abs_save_sp_fragment[] = {
+    // The instruction changes the S register. We save its initial value and restore it afterwards.
+    OPC_TSX,                                          // TSX                  [2]
+    OPC_STX_ABS, T_FRAGMENT_LO(14), T_FRAGMENT_HI(14), // STX save_sp          [4]
+    OPC_LDY_IMM, T_PAR3,                              // LDY #par3            [2]
+    T_OPCODE, T_ABS_LO, T_ABS_HI,                     // OPC base_address,Y   [n or n + 1]
+    OPC_LDX_ABS, T_FRAGMENT_LO(14), T_FRAGMENT_HI(14), // LDX save_sp          [4]
+    OPC_TXS,                                          // TXS                  [2]
+    OPC_RTS                                           // RTS                  [-]
+                                                      // save_sp: the byte following the fragment.
+};
+
+// Instructions with indirect addressing. The pointer in the zero page is written by the test code.
+
+static const uint16_t zpage_x_indirect_fragment[] = {
+    OPC_LDX_IMM, T_ABS_LO,          // LDX #<abs_address    [2]
+    OPC_STX_ZP, T_ZPAGE_LO,         // STX zp_ptr_lo        [3]
+    OPC_LDX_IMM, T_ABS_HI,          // LDX #>abs_address    [2]
+    OPC_STX_ZP, T_ZPAGE_HI,         // STX zp_ptr_hi        [3]
+    OPC_LDX_IMM, T_PAR3,            // LDX #par3            [2]
+    T_OPCODE, T_PAR2,               // OPC (par2,X)         [n]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t zpage_indirect_y_fragment[] = {
+    OPC_LDY_IMM, T_ABS_LO,          // LDY #<base_address   [2]
+    OPC_STY_ZP, T_ZPAGE_LO,         // STY zp_ptr_lo        [3]
+    OPC_LDY_IMM, T_ABS_HI,          // LDY #>base_address   [2]
+    OPC_STY_ZP, T_ZPAGE_HI,         // STY zp_ptr_hi        [3]
+    OPC_LDY_IMM, T_PAR4,            // LDY #par4            [2]
+    T_OPCODE, T_ZPAGE_LO,           // OPC (zp_ptr_lo),Y    [n or n + 1]
+    OPC_RTS                         // RTS                  [-]
+};
+
+// Read instructions.
+
+const TimingTest timing_test_read_immediate        = FRAGMENT_TEST(Par12_OpcodeOffset_Immediate             , 0,                     0, 2, 0, opcode_operand_fragment);
+const TimingTest timing_test_read_zpage            = FRAGMENT_TEST(Par12_OpcodeOffset_ZPage                 , 0,                     0, 3, 0, opcode_operand_fragment);
+const TimingTest timing_test_read_zpage_x          = FRAGMENT_TEST(Par123_OpcodeOffset_ZPage_XReg           , 0,                     2, 4, 0, ldx_opcode_operand_fragment);
+const TimingTest timing_test_read_zpage_y          = FRAGMENT_TEST(Par123_OpcodeOffset_ZPage_YReg           , 0,                     2, 4, 0, ldy_opcode_operand_fragment);
+const TimingTest timing_test_read_abs              = FRAGMENT_TEST(Par12_OpcodeOffset_AbsOffset             , 0,                     0, 4, 0, opcode_abs_fragment);
+const TimingTest timing_test_read_abs_x            = FRAGMENT_TEST(Par123_OpcodeOffset_AbsOffset_XReg       , 0,                     2, 4, 1, ldx_opcode_abs_fragment);
+const TimingTest timing_test_read_abs_y            = FRAGMENT_TEST(Par123_OpcodeOffset_AbsOffset_YReg       , 0,                     2, 4, 1, ldy_opcode_abs_fragment);
+const TimingTest timing_test_read_abs_y_save_sp    = FRAGMENT_TEST(Par123_OpcodeOffset_AbsOffset_YReg       , 0, 2 + 4 + 2 + 4 + 2, 4, 1, ldy_opcode_abs_save_sp_fragment);
+const TimingTest timing_test_read_zpage_x_indirect = FRAGMENT_TEST(Par1234_OpcodeOffset_ZPage_XReg_AbsOffset, 0, 2 + 3 + 2 + 3 + 2, 6, 0, zpage_x_indirect_fragment);
+const TimingTest timing_test_read_zpage_indirect_y = FRAGMENT_TEST(Par1234_OpcodeOffset_ZPage_AbsOffset_YReg, 0, 2 + 3 + 2 + 3 + 2, 5, 1, zpage_indirect_y_fragment);
+
+// Write instructions.
+
+const TimingTest timing_test_write_zpage            = FRAGMENT_TEST(Par12_OpcodeOffset_ZPage                 , TF_ZPAGE_WRITE,                     0, 3, 0, opcode_operand_fragment);
+const TimingTest timing_test_write_zpage_x          = FRAGMENT_TEST(Par123_OpcodeOffset_ZPage_XReg           , TF_ZPAGE_WRITE,                     2, 4, 0, ldx_opcode_operand_fragment);
+const TimingTest timing_test_write_zpage_y          = FRAGMENT_TEST(Par123_OpcodeOffset_ZPage_YReg           , TF_ZPAGE_WRITE,                     2, 4, 0, ldy_opcode_operand_fragment);
+const TimingTest timing_test_write_abs              = FRAGMENT_TEST(Par12_OpcodeOffset_AbsOffset             , 0,                                  0, 4, 0, opcode_abs_fragment);
+const TimingTest timing_test_write_abs_x            = FRAGMENT_TEST(Par123_OpcodeOffset_AbsOffset_XReg       , 0,                                  2, 5, 0, ldx_opcode_abs_fragment);
+const TimingTest timing_test_write_abs_y            = FRAGMENT_TEST(Par123_OpcodeOffset_AbsOffset_YReg       , 0,                                  2, 5, 0, ldy_opcode_abs_fragment);
+const TimingTest timing_test_write_abs_y_save_sp    = FRAGMENT_TEST(Par123_OpcodeOffset_AbsOffset_YReg       , 0,                  2 + 4 + 2 + 4 + 2, 5, 0, ldy_opcode_abs_save_sp_fragment);
+const TimingTest timing_test_write_zpage_x_indirect = FRAGMENT_TEST(Par1234_OpcodeOffset_ZPage_XReg_AbsOffset, 0,                  2 + 3 + 2 + 3 + 2, 6, 0, zpage_x_indirect_fragment);
+const TimingTest timing_test_write_zpage_indirect_y = FRAGMENT_TEST(Par1234_OpcodeOffset_ZPage_AbsOffset_YReg, 0,                  2 + 3 + 2 + 3 + 2, 6, 0, zpage_indirect_y_fragment);
+
+// Read-modify-write instructions.
+
+const TimingTest timing_test_read_modify_write_zpage            = FRAGMENT_TEST(Par12_OpcodeOffset_ZPage                 , TF_ZPAGE_WRITE,                     0, 5, 0, opcode_operand_fragment);
+const TimingTest timing_test_read_modify_write_zpage_x          = FRAGMENT_TEST(Par123_OpcodeOffset_ZPage_XReg           , TF_ZPAGE_WRITE,                     2, 6, 0, ldx_opcode_operand_fragment);
+const TimingTest timing_test_read_modify_write_abs              = FRAGMENT_TEST(Par12_OpcodeOffset_AbsOffset             , 0,                                  0, 6, 0, opcode_abs_fragment);
+const TimingTest timing_test_read_modify_write_abs_x_v1         = FRAGMENT_TEST(Par123_OpcodeOffset_AbsOffset_XReg       , 0,                                  2, 7, 0, ldx_opcode_abs_fragment);
+const TimingTest timing_test_read_modify_write_abs_y            = FRAGMENT_TEST(Par123_OpcodeOffset_AbsOffset_YReg       , 0,                                  2, 7, 0, ldy_opcode_abs_fragment);
+const TimingTest timing_test_read_modify_write_zpage_x_indirect = FRAGMENT_TEST(Par1234_OpcodeOffset_ZPage_XReg_AbsOffset, 0,                  2 + 3 + 2 + 3 + 2, 8, 0, zpage_x_indirect_fragment);
+const TimingTest timing_test_read_modify_write_zpage_indirect_y = FRAGMENT_TEST(Par1234_OpcodeOffset_ZPage_AbsOffset_YReg, 0,                  2 + 3 + 2 + 3 + 2, 8, 0, zpage_indirect_y_fragment);
+
+#if defined(CPU_6502)
+
+// Special variants to test the illegal SHA, SHX, SHY, and TAS instructions.
+//
+// The difficulty with these opcodes is that in case of a page crossing due to the X or Y indexing, the high
+// byte of the effective address is (base_addr_hi + 1), but ANDed with one or two other registers (!?!).
+//
+// We deal with this by making sure these registers are 0xff when the instruction is executed.
+
+static const uint16_t shy_abs_x_fragment[] = {
+    OPC_LDY_IMM, 0xff,              // LDY #$ff             [2]
+    OPC_LDX_IMM, T_PAR3,            // LDX #par3            [2]
+    T_OPCODE, T_ABS_LO, T_ABS_HI,   // SHY base_address,X   [5]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t shx_abs_y_fragment[] = {
+    OPC_LDX_IMM, 0xff,              // LDX #$ff             [2]
+    OPC_LDY_IMM, T_PAR3,            // LDY #par3            [2]
+    T_OPCODE, T_ABS_LO, T_ABS_HI,   // SHX base_address,Y   [5]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t sha_abs_y_fragment[] = {
+    OPC_LDA_IMM, 0xff,              // LDA #$ff             [2]
+    OPC_TAX,                        // TAX                  [2]
+    OPC_LDY_IMM, T_PAR3,            // LDY #par3            [2]
+    T_OPCODE, T_ABS_LO, T_ABS_HI,   // SHA base_address,Y   [5]
+    OPC_RTS                         // RTS                  [-]
+};
+
+static const uint16_t tas_abs_y_fragment[] = {
+    // The TAS instruction also overwrites the S register. We save its initial value and restore it afterwards.
+    OPC_TSX,                                          // TSX                  [2]
+    OPC_STX_ABS, T_FRAGMENT_LO(17), T_FRAGMENT_HI(17), // STX save_sp          [4]
+    OPC_LDA_IMM, 0xff,                                // LDA #$ff             [2]
+    OPC_TAX,                                          // TAX                  [2]
+    OPC_LDY_IMM, T_PAR3,                              // LDY #par3            [2]
+    T_OPCODE, T_ABS_LO, T_ABS_HI,                     // TAS base_address,Y   [5]
+    OPC_LDX_ABS, T_FRAGMENT_LO(17), T_FRAGMENT_HI(17), // LDX save_sp          [4]
+    OPC_TXS,                                          // TXS                  [2]
+    OPC_RTS                                           // RTS                  [-]
+                                                      // save_sp: the byte following the fragment.
+};
+
+static const uint16_t sha_zpage_indirect_y_fragment[] = {
+    OPC_LDA_IMM, 0xff,              // LDA #$ff             [2]
+    OPC_TAX,                        // TAX                  [2]
+    OPC_LDY_IMM, T_ABS_LO,          // LDY #<base_address   [2]
+    OPC_STY_ZP, T_ZPAGE_LO,         // STY zp_ptr_lo        [3]
+    OPC_LDY_IMM, T_ABS_HI,          // LDY #>base_address   [2]
+    OPC_STY_ZP, T_ZPAGE_HI,         // STY zp_ptr_hi        [3]
+    OPC_LDY_IMM, T_PAR4,            // LDY #par4            [2]
+    T_OPCODE, T_ZPAGE_LO,           // SHA (zp_ptr_lo),Y    [6]
+    OPC_RTS                         // RTS                  [-]
+};
+
+const TimingTest timing_test_write_abs_x_shy           = FRAGMENT_TEST(Par123_OpcodeOffset_AbsOffset_XReg       , 0,                  2 + 2, 5, 0, shy_abs_x_fragment);
+const TimingTest timing_test_write_abs_y_shx           = FRAGMENT_TEST(Par123_OpcodeOffset_AbsOffset_YReg       , 0,                  2 + 2, 5, 0, shx_abs_y_fragment);
+const TimingTest timing_test_write_abs_y_sha           = FRAGMENT_TEST(Par123_OpcodeOffset_AbsOffset_YReg       , 0,              2 + 2 + 2, 5, 0, sha_abs_y_fragment);
+const TimingTest timing_test_write_abs_y_tas           = FRAGMENT_TEST(Par123_OpcodeOffset_AbsOffset_YReg       , 0, 2 + 4 + 2 + 2 + 2 + 4 + 2, 5, 0, tas_abs_y_fragment);
+const TimingTest timing_test_write_zpage_indirect_y_sha = FRAGMENT_TEST(Par1234_OpcodeOffset_ZPage_AbsOffset_YReg, 0, 2 + 2 + 2 + 3 + 2 + 3 + 2, 6, 0, sha_zpage_indirect_y_fragment);
+
+#endif
+
+#if defined(CPU_65C02)
+
+static const uint16_t zpage_indirect_fragment[] = {
+    OPC_LDA_IMM, T_ABS_LO,          // LDA #<base_address   [2]
+    OPC_STA_ZP, T_ZPAGE_LO,         // STA zp_ptr_lo        [3]
+    OPC_LDA_IMM, T_ABS_HI,          // LDA #>base_address   [2]
+    OPC_STA_ZP, T_ZPAGE_HI,         // STA zp_ptr_hi        [3]
+    T_OPCODE, T_ZPAGE_LO,           // OPC (zp_ptr_lo)      [5]
+    OPC_RTS                         // RTS                  [-]
+};
+
+const TimingTest timing_test_read_abs_slow           = FRAGMENT_TEST(Par12_OpcodeOffset_AbsOffset       , 0,             0, 8, 0, opcode_abs_fragment); // Unique for instruction 0x5C on the 65C02.
+const TimingTest timing_test_read_zpage_indirect     = FRAGMENT_TEST(Par123_OpcodeOffset_ZPage_AbsOffset, 0, 2 + 3 + 2 + 3, 5, 0, zpage_indirect_fragment);
+const TimingTest timing_test_write_zpage_indirect    = FRAGMENT_TEST(Par123_OpcodeOffset_ZPage_AbsOffset, 0, 2 + 3 + 2 + 3, 5, 0, zpage_indirect_fragment);
+
+// The ASL/ROL/ROR/LSR instructions with absolute-x addressing have different timing on the 65C02 compared to the 6502.
+// Note: the DEC/INC with absolute-x indexing on the 65C02 have the same timing as their 6502 counterparts. Go figure.
+
+const TimingTest timing_test_read_modify_write_abs_x_v2 = FRAGMENT_TEST(Par123_OpcodeOffset_AbsOffset_XReg, 0, 2, 6, 1, ldx_opcode_abs_fragment);
+
+#endif
+
+// Branch, jump, and interrupt-related instructions.
+
+static const uint16_t jmp_jsr_abs_fragment[] = {
+    T_OPCODE, T_FRAGMENT_LO(3), T_FRAGMENT_HI(3),   // JMP / JSR abs        [3 or 6]
+    OPC_RTS                                         // RTS                  [-]
+};
+
+static const uint16_t rts_fragment[] = {
+    // Note: the RTS is both used as the instruction-under-test, and as the RTS back to
+    // the measurement routine.
+    OPC_LDA_IMM, T_FRAGMENT_HI(5),  // LDA #>(rts_address - 1)   [2]
+    OPC_PHA,                        // PHA                       [3]
+    OPC_LDA_IMM, T_FRAGMENT_LO(5),  // LDA #<(rts_address - 1)   [2]
+    OPC_PHA,                        // PHA                       [3]
+    T_OPCODE                        // RTS                       [6]
+};
+
+static const uint16_t rti_fragment[] = {
+    OPC_LDA_IMM, T_FRAGMENT_HI(8),  // LDA #>rts_address     [2]
+    OPC_PHA,                        // PHA                   [3]
+    OPC_LDA_IMM, T_FRAGMENT_LO(8),  // LDA #<rts_address     [2]
+    OPC_PHA,                        // PHA                   [3]
+    OPC_PHP,                        // PHP                   [3]
+    T_OPCODE,                       // RTI                   [6]
+    OPC_RTS                         // RTS                   [-]
+};
+
+const TimingTest timing_test_branch_when_flag_clear = SPECIAL_TEST(timing_test_branch_instruction, Par123_OpcodeOffset_BranchDisplacement_TakenNotTaken, 0);
+const TimingTest timing_test_branch_when_flag_set   = SPECIAL_TEST(timing_test_branch_instruction, Par123_OpcodeOffset_BranchDisplacement_TakenNotTaken, TF_BRANCH_WHEN_SET);
+
+const TimingTest timing_test_jmp_abs          = FRAGMENT_TEST(Par1_OpcodeOffset, 0,                 0, 3, 0, jmp_jsr_abs_fragment);
+const TimingTest timing_test_jmp_abs_indirect = SPECIAL_TEST(timing_test_jmp_abs_indirect_instruction, Par12_OpcodeOffset_AbsOffset, 0);
+const TimingTest timing_test_jsr_abs          = FRAGMENT_TEST(Par1_OpcodeOffset, 0,                 6, 6, 0, jmp_jsr_abs_fragment); // The RTS to get back.
+const TimingTest timing_test_rts              = FRAGMENT_TEST(Par1_OpcodeOffset, 0,     2 + 3 + 2 + 3, 6, 0, rts_fragment);
+const TimingTest timing_test_brk              = SPECIAL_TEST(timing_test_brk_instruction, Par1_OpcodeOffset, 0);
+const TimingTest timing_test_rti              = FRAGMENT_TEST(Par1_OpcodeOffset, 0, 2 + 3 + 2 + 3 + 3, 6, 0, rti_fragment);
+
+#if defined(CPU_65C02)
+
+const TimingTest timing_test_bit_branch_when_bit_clear = SPECIAL_TEST(timing_test_bit_branch_instruction, Par1234_OpcodeOffset_ZPage_BranchDisplacement_TakenNotTaken, 0);
+const TimingTest timing_test_bit_branch_when_bit_set   = SPECIAL_TEST(timing_test_bit_branch_instruction, Par1234_OpcodeOffset_ZPage_BranchDisplacement_TakenNotTaken, TF_BRANCH_WHEN_SET);
+const TimingTest timing_test_branch_always             = SPECIAL_TEST(timing_test_branch_always_instruction, Par123_OpcodeOffset_BranchDisplacement_TakenNotTaken, 0);
+const TimingTest timing_test_jmp_abs_x_indirect        = SPECIAL_TEST(timing_test_jmp_abs_x_indirect_instruction, Par123_OpcodeOffset_AbsOffset_XReg, 0);
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                   //
+//                                                 RUN A TIMING TEST                                                 //
+//                                                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool run_timing_test(const TimingTest * test, const char * opcode_description, uint8_t opcode)
+{
+    return test->routine(test, opcode_description, opcode);
 }
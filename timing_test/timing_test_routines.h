@@ -9,6 +9,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "timing_test_measurement.h"
+
 // For testing purposes we often want to loop over values in the range 0..255. The STEP_SIZE variable
 // determines the steps to take; in case it's one, all 256 values are visited.
 //
@@ -22,74 +24,107 @@
 
 extern unsigned STEP_SIZE;
 
+// A timing test is described by a TimingTest descriptor.
+//
+// Most tests run a small code fragment, built from a template, for all combinations of the parameters
+// par1..par4 given by the test's ParSpec. The expected cycle count is 'instruction_cycles', plus
+// 'page_cross_cycles' if indexing crosses a page boundary. The fragment templates are described in
+// timing_test_routines.c.
+//
+// Tests that need more than a single fragment (branches, indirect jumps, BRK) have their own routine.
+
+typedef struct TimingTest TimingTest;
+
+struct TimingTest {
+    bool (*routine)(const TimingTest * test, const char * opcode_description, uint8_t opcode);
+    ParSpec          parspec;              // The parameters varied by the test, and their meaning.
+    uint8_t          flags;                // Test-specific flags.
+    uint8_t          test_overhead_cycles; // Cycles spent in the fragment outside of the instruction under test.
+    uint8_t          instruction_cycles;   // Cycles of the instruction under test.
+    uint8_t          page_cross_cycles;    // Extra cycles of the instruction if indexing crosses a page boundary.
+    const uint16_t * fragment_template;    // The test code fragment.
+    uint8_t          fragment_size;        // The number of bytes in the fragment.
+};
+
+bool run_timing_test(const TimingTest * test, const char * opcode_description, uint8_t opcode);
+
 // Timing test for skipped instructions.
 
-bool timing_test_skip_instruction (const char * opcode_description, uint8_t opcode);
+extern const TimingTest timing_test_skip;
 
-// Timing tests for one, two, and three-byte instruction sequences.
+// Timing tests for single-byte instructions, and short instruction sequences.
 
-bool timing_test_single_byte_instruction_sequence (const char * opcode_description,                             uint8_t b1                                                       , unsigned instruction_cycles);
-bool timing_test_two_byte_instruction_sequence    (const char * opcode_description, uint8_t test_opcode_offset, uint8_t b1, uint8_t b2            , unsigned test_overhead_cycles, unsigned instruction_cycles);
-bool timing_test_three_byte_instruction_sequence  (const char * opcode_description, uint8_t test_opcode_offset, uint8_t b1, uint8_t b2, uint8_t b3, unsigned test_overhead_cycles, unsigned instruction_cycles);
+extern const TimingTest timing_test_implied;          // OPC
+extern const TimingTest timing_test_implied_1_cycle;  // OPC, for the single-cycle NOPs of the 65C02
+extern const TimingTest timing_test_txs;              // TSX, TXS
+extern const TimingTest timing_test_push;             // TSX, PHx, TXS
+extern const TimingTest timing_test_pla;              // PHA, PLA
+extern const TimingTest timing_test_plp;              // PHP, PLP
+extern const TimingTest timing_test_plx;              // PHX, PLX
+extern const TimingTest timing_test_ply;              // PHY, PLY
+extern const TimingTest timing_test_interrupt_flag;   // PHP, CLI / SEI, PLP
+extern const TimingTest timing_test_sed;              // SED, CLD
 
 // Timing tests for read-instructions.
 
-bool timing_test_read_immediate_instruction       (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_zpage_instruction           (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_zpage_x_instruction         (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_zpage_y_instruction         (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_abs_instruction             (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_abs_instruction_slow        (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_abs_x_instruction           (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_abs_y_instruction           (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_abs_y_instruction_save_sp   (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_zpage_x_indirect_instruction(const char * opcode_description, uint8_t opcode);
-bool timing_test_read_zpage_indirect_y_instruction(const char * opcode_description, uint8_t opcode);
-bool timing_test_read_zpage_indirect_instruction  (const char * opcode_description, uint8_t opcode);
+extern const TimingTest timing_test_read_immediate;
+extern const TimingTest timing_test_read_zpage;
+extern const TimingTest timing_test_read_zpage_x;
+extern const TimingTest timing_test_read_zpage_y;
+extern const TimingTest timing_test_read_abs;
+extern const TimingTest timing_test_read_abs_slow;
+extern const TimingTest timing_test_read_abs_x;
+extern const TimingTest timing_test_read_abs_y;
+extern const TimingTest timing_test_read_abs_y_save_sp;
+extern const TimingTest timing_test_read_zpage_x_indirect;
+extern const TimingTest timing_test_read_zpage_indirect_y;
+extern const TimingTest timing_test_read_zpage_indirect;
 
 // Timing tests for write-instructions.
 
-bool timing_test_write_zpage_instruction                   (const char * opcode_description, uint8_t opcode);
-bool timing_test_write_zpage_x_instruction                 (const char * opcode_description, uint8_t opcode);
-bool timing_test_write_zpage_y_instruction                 (const char * opcode_description, uint8_t opcode);
-bool timing_test_write_abs_instruction                     (const char * opcode_description, uint8_t opcode);
-bool timing_test_write_abs_x_instruction                   (const char * opcode_description, uint8_t opcode);
-bool timing_test_write_abs_x_instruction_shy_absx          (const char * opcode_description, uint8_t opcode);
-bool timing_test_write_abs_y_instruction                   (const char * opcode_description, uint8_t opcode);
-bool timing_test_write_abs_y_instruction_sha_absy          (const char * opcode_description, uint8_t opcode);
-bool timing_test_write_abs_y_instruction_shx_absy          (const char * opcode_description, uint8_t opcode);
-bool timing_test_write_abs_y_instruction_tas_absy          (const char * opcode_description, uint8_t opcode);
-bool timing_test_write_abs_y_instruction_save_sp           (const char * opcode_description, uint8_t opcode);
-bool timing_test_write_zpage_x_indirect_instruction        (const char * opcode_description, uint8_t opcode);
-bool timing_test_write_zpage_indirect_y_instruction        (const char * opcode_description, uint8_t opcode);
-bool timing_test_write_zpage_indirect_y_instruction_sha_zpy(const char * opcode_description, uint8_t opcode);
-bool timing_test_write_zpage_indirect_instruction          (const char * opcode_description, uint8_t opcode);
+extern const TimingTest timing_test_write_zpage;
+extern const TimingTest timing_test_write_zpage_x;
+extern const TimingTest timing_test_write_zpage_y;
+extern const TimingTest timing_test_write_abs;
+extern const TimingTest timing_test_write_abs_x;
+extern const TimingTest timing_test_write_abs_x_shy;
+extern const TimingTest timing_test_write_abs_y;
+extern const TimingTest timing_test_write_abs_y_sha;
+extern const TimingTest timing_test_write_abs_y_shx;
+extern const TimingTest timing_test_write_abs_y_tas;
+extern const TimingTest timing_test_write_abs_y_save_sp;
+extern const TimingTest timing_test_write_zpage_x_indirect;
+extern const TimingTest timing_test_write_zpage_indirect_y;
+extern const TimingTest timing_test_write_zpage_indirect_y_sha;
+extern const TimingTest timing_test_write_zpage_indirect;
 
 // Timing tests for read-modify-write instructions.
 
-bool timing_test_read_modify_write_zpage_instruction           (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_modify_write_zpage_x_instruction         (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_modify_write_abs_instruction             (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_modify_write_abs_x_instruction_v1        (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_modify_write_abs_x_instruction_v2        (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_modify_write_abs_y_instruction           (const char * opcode_description, uint8_t opcode);
-bool timing_test_read_modify_write_zpage_x_indirect_instruction(const char * opcode_description, uint8_t opcode);
-bool timing_test_read_modify_write_zpage_indirect_y_instruction(const char * opcode_description, uint8_t opcode);
+extern const TimingTest timing_test_read_modify_write_zpage;
+extern const TimingTest timing_test_read_modify_write_zpage_x;
+extern const TimingTest timing_test_read_modify_write_abs;
+extern const TimingTest timing_test_read_modify_write_abs_x_v1;
+extern const TimingTest timing_test_read_modify_write_abs_x_v2;
+extern const TimingTest timing_test_read_modify_write_abs_y;
+extern const TimingTest timing_test_read_modify_write_zpage_x_indirect;
+extern const TimingTest timing_test_read_modify_write_zpage_indirect_y;
 
 // Timing tests for branch, jump, and interrupt-related instructions.
 
-bool timing_test_branch_instruction       (const char * opcode_description, uint8_t opcode, bool branch_when_flag_set);
-bool timing_test_bit_branch_instruction   (const char * opcode_description, uint8_t opcode, bool branch_when_bit_set);
-bool timing_test_branch_always_instruction(const char * opcode_description, uint8_t opcode);
+extern const TimingTest timing_test_branch_when_flag_clear;
+extern const TimingTest timing_test_branch_when_flag_set;
+extern const TimingTest timing_test_bit_branch_when_bit_clear;
+extern const TimingTest timing_test_bit_branch_when_bit_set;
+extern const TimingTest timing_test_branch_always;
 
-bool timing_test_jmp_abs_instruction            (const char * opcode_description);
-bool timing_test_jmp_abs_indirect_instruction   (const char * opcode_description);
-bool timing_test_jmp_abs_x_indirect_instruction (const char * opcode_description);
+extern const TimingTest timing_test_jmp_abs;
+extern const TimingTest timing_test_jmp_abs_indirect;
+extern const TimingTest timing_test_jmp_abs_x_indirect;
 
-bool timing_test_jsr_abs_instruction      (const char * opcode_description);
-bool timing_test_rts_instruction          (const char * opcode_description);
+extern const TimingTest timing_test_jsr_abs;
+extern const TimingTest timing_test_rts;
 
-bool timing_test_brk_instruction          (const char * opcode_description);
-bool timing_test_rti_instruction          (const char * opcode_description);
+extern const TimingTest timing_test_brk;
+extern const TimingTest timing_test_rti;
 
 #endif